@@ -0,0 +1,205 @@
+#include "load_generator.h"
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+class Connection {
+public:
+    explicit Connection(const LoadGenerator::Options& opts) : opts_(opts), stream_(ioc_) {}
+
+    std::optional<LoadGenerator::Reply> exchange(const LoadGenerator::Call& call) {
+        beast::error_code ec;
+        if (!connected_) {
+            tcp::resolver resolver(ioc_);
+            auto endpoints = resolver.resolve(opts_.host, std::to_string(opts_.port), ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            stream_.connect(endpoints, ec);
+            if (ec) {
+                return std::nullopt;
+            }
+            stream_.socket().set_option(tcp::no_delay(true), ec);
+            connected_ = true;
+        }
+
+        http::request<http::string_body> req{call.method, call.target, 11};
+        req.set(http::field::host, opts_.host);
+        req.set(http::field::authorization, "Bearer " + opts_.token);
+        req.keep_alive(true);
+        if (!call.body.empty()) {
+            req.set(http::field::content_type, "application/json");
+            req.body() = call.body;
+        }
+        req.prepare_payload();
+
+        http::response<http::string_body> res;
+        http::write(stream_, req, ec);
+        if (!ec) {
+            http::read(stream_, buffer_, res, ec);
+        }
+        if (ec) {
+            close();
+            return std::nullopt;
+        }
+        if (!res.keep_alive()) {
+            close();
+        }
+        return LoadGenerator::Reply{res.result_int(), std::move(res.body())};
+    }
+
+private:
+    void close() {
+        beast::error_code ec;
+        stream_.socket().shutdown(tcp::socket::shutdown_both, ec);
+        stream_.close();
+        buffer_.clear();
+        connected_ = false;
+    }
+
+    const LoadGenerator::Options& opts_;
+    net::io_context ioc_;
+    beast::tcp_stream stream_;
+    beast::flat_buffer buffer_;
+    bool connected_ = false;
+};
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto rank = static_cast<std::size_t>(std::ceil(q * static_cast<double>(sorted.size())));
+    return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+void printRow(std::ostream& out, const std::string& name, std::vector<double> latencies, std::uint64_t count,
+              std::uint64_t errors, double elapsed_s) {
+    std::sort(latencies.begin(), latencies.end());
+    out << std::left << std::setw(20) << name << std::right
+        << std::setw(9) << count
+        << std::setw(9) << errors
+        << std::setw(10) << std::fixed << std::setprecision(1) << (elapsed_s > 0 ? static_cast<double>(count) / elapsed_s : 0.0)
+        << std::setw(10) << std::setprecision(2) << percentile(latencies, 0.50)
+        << std::setw(10) << percentile(latencies, 0.99)
+        << std::setw(10) << percentile(latencies, 0.999)
+        << std::setw(10) << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+}
+
+} // namespace
+
+LoadGenerator::Report LoadGenerator::run(const Options& opts, const Plan& plan) {
+    const auto total = static_cast<std::uint64_t>(opts.rps * static_cast<double>(opts.duration.count()));
+    const unsigned connections = std::max(1u, opts.connections);
+    const std::chrono::duration<double> interval(1.0 / opts.rps);
+    // Leave the threads a moment to start before the first request is due.
+    const auto start = Clock::now() + std::chrono::milliseconds(100);
+    const auto give_up = start + opts.duration + opts.drain;
+
+    std::vector<Report> partial(connections);
+    std::vector<std::thread> threads;
+    threads.reserve(connections);
+    for (unsigned c = 0; c < connections; ++c) {
+        threads.emplace_back([&, c] {
+            Connection conn(opts);
+            Report& mine = partial[c];
+            for (std::uint64_t seq = c; seq < total; seq += connections) {
+                const auto due = start + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(seq));
+                std::this_thread::sleep_until(due);
+                if (Clock::now() > give_up) {
+                    ++mine.skipped;
+                    continue;
+                }
+                Call call = plan(seq);
+                auto reply = conn.exchange(call);
+                auto& stats = mine.operations[call.operation];
+                if (!reply.has_value()) {
+                    ++stats.transport_errors;
+                    continue;
+                }
+                stats.latencies_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - due).count());
+                ++stats.statuses[reply->status];
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Report report;
+    report.elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+    report.scheduled = total;
+    for (auto& p : partial) {
+        report.skipped += p.skipped;
+        for (auto& [name, stats] : p.operations) {
+            auto& merged = report.operations[name];
+            merged.latencies_ms.insert(merged.latencies_ms.end(), stats.latencies_ms.begin(), stats.latencies_ms.end());
+            merged.transport_errors += stats.transport_errors;
+            for (const auto& [status, n] : stats.statuses) {
+                merged.statuses[status] += n;
+            }
+        }
+    }
+    return report;
+}
+
+void LoadGenerator::print(const Report& report, std::ostream& out) {
+    out << "\n" << report.scheduled << " requests scheduled in " << std::fixed << std::setprecision(2) << report.elapsed_s << "s";
+    if (report.skipped > 0) {
+        out << ", " << report.skipped << " never sent (server too far behind)";
+    }
+    out << "\nlatency in ms, measured from each request's scheduled start; errors are non-2xx and transport failures\n\n";
+    out << std::left << std::setw(20) << "operation" << std::right << std::setw(9) << "requests" << std::setw(9) << "errors"
+        << std::setw(10) << "req/s" << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p999"
+        << std::setw(10) << "max" << "\n";
+
+    std::vector<double> all;
+    std::uint64_t all_count = 0;
+    std::uint64_t all_errors = 0;
+    for (const auto& [name, stats] : report.operations) {
+        std::uint64_t errors = stats.transport_errors;
+        for (const auto& [status, n] : stats.statuses) {
+            if (status < 200 || status >= 300) {
+                errors += n;
+            }
+        }
+        const std::uint64_t count = stats.latencies_ms.size() + stats.transport_errors;
+        printRow(out, name, stats.latencies_ms, count, errors, report.elapsed_s);
+        all.insert(all.end(), stats.latencies_ms.begin(), stats.latencies_ms.end());
+        all_count += count;
+        all_errors += errors;
+    }
+    if (report.operations.size() > 1) {
+        printRow(out, "total", std::move(all), all_count, all_errors, report.elapsed_s);
+    }
+
+    out << "\nstatus codes:\n";
+    for (const auto& [name, stats] : report.operations) {
+        out << "  " << name << ":";
+        for (const auto& [status, n] : stats.statuses) {
+            out << " " << status << "=" << n;
+        }
+        if (stats.transport_errors > 0) {
+            out << " transport_error=" << stats.transport_errors;
+        }
+        out << "\n";
+    }
+}
+
+std::optional<LoadGenerator::Reply> LoadGenerator::send(const Options& opts, const Call& call) {
+    Connection conn(opts);
+    return conn.exchange(call);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <boost/beast/http/verb.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* Open-loop HTTP load against a running wasolution.
+
+   Request k is due at start + k / rps whatever happened to earlier requests,
+   and its latency is measured from that due time rather than from when it was
+   actually written. A stalled server therefore shows up as queueing delay in
+   the percentiles instead of silently lowering the offered rate (coordinated
+   omission). Requests are spread round-robin over persistent keep-alive
+   connections, one thread each. */
+class LoadGenerator {
+public:
+    typedef struct {
+        std::string host = "127.0.0.1";
+        unsigned short port = 8080;
+        std::string token;
+        double rps = 100;
+        std::chrono::seconds duration{10};
+        unsigned connections = 32;
+        // How long to keep going after the last due time before giving up on late requests.
+        std::chrono::seconds drain{30};
+    } Options;
+
+    typedef struct {
+        std::string operation;
+        boost::beast::http::verb method;
+        std::string target;
+        std::string body;
+    } Call;
+
+    // Builds request number seq.
+    using Plan = std::function<Call(std::uint64_t seq)>;
+
+    typedef struct {
+        std::vector<double> latencies_ms;
+        std::map<unsigned, std::uint64_t> statuses;
+        std::uint64_t transport_errors = 0;
+    } OperationStats;
+
+    typedef struct {
+        double elapsed_s = 0;
+        std::uint64_t scheduled = 0;
+        std::uint64_t skipped = 0;
+        std::map<std::string, OperationStats> operations;
+    } Report;
+
+    typedef struct {
+        unsigned status;
+        std::string body;
+    } Reply;
+
+    LoadGenerator() = delete;
+
+    static Report run(const Options& opts, const Plan& plan);
+    static void print(const Report& report, std::ostream& out);
+
+    // One blocking request on a fresh connection, for setup and cleanup. Empty on transport errors.
+    static std::optional<Reply> send(const Options& opts, const Call& call);
+};
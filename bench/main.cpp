@@ -0,0 +1,325 @@
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/beast/http/verb.hpp>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../dependencies/json.h"
+#include "load_generator.h"
+#include "mock_provider.h"
+
+namespace net = boost::asio;
+namespace http = boost::beast::http;
+
+namespace {
+
+typedef struct {
+    std::string host = "127.0.0.1";
+    unsigned short port = 8080;
+    std::string token;
+    double rps = 200;
+    unsigned duration_s = 10;
+    unsigned connections = 32;
+    std::string scenario = "sendMessage";
+    std::string provider = "WUZAPI";
+    unsigned instances = 10;
+    MockProvider::Fault fault{20, 10, 0.0};
+    unsigned short evo_port = 19001;
+    unsigned short wuz_port = 19002;
+    unsigned short cloud_port = 19003;
+    bool mocks_only = false;
+    bool keep_instances = false;
+} Args;
+
+void usage() {
+    std::cout <<
+        "usage: wasolution_bench --token TOKEN [options]\n"
+        "\n"
+        "  --target HOST:PORT     wasolution under test (127.0.0.1:8080)\n"
+        "  --token TOKEN          TOKEN from the server's .env\n"
+        "  --rps N                offered requests per second (200)\n"
+        "  --duration S           seconds of load (10)\n"
+        "  --connections N        keep-alive connections, one thread each (32)\n"
+        "  --scenario NAME        sendMessage, sendTemplate, retrieveInstances, createInstance or mixed (sendMessage)\n"
+        "  --provider NAME        WUZAPI, EVOLUTION or CLOUD, for the instances sends go through (WUZAPI)\n"
+        "  --instances N          instances created before the run and spread over (10)\n"
+        "  --latency-ms N         delay added by the mock providers (20)\n"
+        "  --jitter-ms N          extra random delay, up to N ms (10)\n"
+        "  --error-rate F         share of provider calls answered with 500, 0 to 1 (0)\n"
+        "  --evo-port N, --wuz-port N, --cloud-port N\n"
+        "                         mock ports (19001, 19002, 19003)\n"
+        "  --mocks-only           only run the mock providers, until Ctrl+C\n"
+        "  --keep-instances       do not delete the bench instances afterwards\n";
+}
+
+bool parse(int argc, char** argv, Args& args) {
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(flag + " needs a value");
+            }
+            return argv[++i];
+        };
+        if (flag == "--target") {
+            std::string target = value();
+            auto colon = target.rfind(':');
+            if (colon == std::string::npos) {
+                throw std::invalid_argument("--target must be HOST:PORT");
+            }
+            args.host = target.substr(0, colon);
+            args.port = static_cast<unsigned short>(std::stoul(target.substr(colon + 1)));
+        } else if (flag == "--token") {
+            args.token = value();
+        } else if (flag == "--rps") {
+            args.rps = std::stod(value());
+        } else if (flag == "--duration") {
+            args.duration_s = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--connections") {
+            args.connections = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--scenario") {
+            args.scenario = value();
+        } else if (flag == "--provider") {
+            args.provider = value();
+        } else if (flag == "--instances") {
+            args.instances = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--latency-ms") {
+            args.fault.latency_ms = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--jitter-ms") {
+            args.fault.jitter_ms = static_cast<unsigned>(std::stoul(value()));
+        } else if (flag == "--error-rate") {
+            args.fault.error_rate = std::stod(value());
+        } else if (flag == "--evo-port") {
+            args.evo_port = static_cast<unsigned short>(std::stoul(value()));
+        } else if (flag == "--wuz-port") {
+            args.wuz_port = static_cast<unsigned short>(std::stoul(value()));
+        } else if (flag == "--cloud-port") {
+            args.cloud_port = static_cast<unsigned short>(std::stoul(value()));
+        } else if (flag == "--mocks-only") {
+            args.mocks_only = true;
+        } else if (flag == "--keep-instances") {
+            args.keep_instances = true;
+        } else if (flag == "--help" || flag == "-h") {
+            return false;
+        } else {
+            throw std::invalid_argument("unknown option " + flag);
+        }
+    }
+    if (args.scenario != "sendMessage" && args.scenario != "sendTemplate" && args.scenario != "retrieveInstances" &&
+        args.scenario != "createInstance" && args.scenario != "mixed") {
+        throw std::invalid_argument("unknown scenario " + args.scenario);
+    }
+    if (args.provider != "WUZAPI" && args.provider != "EVOLUTION" && args.provider != "CLOUD") {
+        throw std::invalid_argument("unknown provider " + args.provider);
+    }
+    if (args.rps <= 0 || args.duration_s == 0 || args.instances == 0) {
+        throw std::invalid_argument("--rps, --duration and --instances must be positive");
+    }
+    if (!args.mocks_only && args.token.empty()) {
+        throw std::invalid_argument("--token is required");
+    }
+    return true;
+}
+
+LoadGenerator::Call createCall(const std::string& instance_id, const std::string& api_type) {
+    nlohmann::json body{{"instance_id", instance_id}, {"instance_name", instance_id}, {"api_type", api_type}};
+    if (api_type == "CLOUD") {
+        body["waba_id"] = "bench-waba";
+        body["access_token"] = "bench-token";
+    }
+    return {"createInstance", http::verb::post, "/createInstance", body.dump()};
+}
+
+LoadGenerator::Call sendMessageCall(const std::string& instance_id, std::uint64_t seq) {
+    nlohmann::json body{{"instance_id", instance_id}, {"number", "5511999999999"},
+                        {"body", "bench message " + std::to_string(seq)}, {"type", "TEXT"}};
+    return {"sendMessage", http::verb::post, "/sendMessage", body.dump()};
+}
+
+LoadGenerator::Call sendTemplateCall(const std::string& instance_id) {
+    nlohmann::json body{{"instance_id", instance_id}, {"number", "5511999999999"}, {"template_name", "bench_template"},
+                        {"variables", nlohmann::json::array({{{"type", "text"}, {"value", "bench"}}})}};
+    return {"sendTemplate", http::verb::post, "/sendTemplate", body.dump()};
+}
+
+// Creates the instances a scenario sends through; returns the ids that were created.
+std::vector<std::string> createInstances(const LoadGenerator::Options& opts, const std::string& prefix,
+                                         const std::string& api_type, unsigned count) {
+    std::vector<std::string> ids;
+    for (unsigned i = 0; i < count; ++i) {
+        std::string id = prefix + std::to_string(i);
+        auto reply = LoadGenerator::send(opts, createCall(id, api_type));
+        if (!reply.has_value()) {
+            throw std::runtime_error("could not reach wasolution at " + opts.host + ":" + std::to_string(opts.port));
+        }
+        if (reply->status < 200 || reply->status >= 300) {
+            std::cerr << "createInstance " << id << " failed with " << reply->status << ": " << reply->body << "\n";
+            continue;
+        }
+        ids.push_back(std::move(id));
+    }
+    if (ids.empty()) {
+        throw std::runtime_error("no " + api_type + " instance could be created, check the server's provider URLs and DB_URL");
+    }
+    return ids;
+}
+
+void deleteInstances(const LoadGenerator::Options& opts, const std::vector<std::string>& ids) {
+    for (const auto& id : ids) {
+        nlohmann::json body{{"instance_id", id}};
+        LoadGenerator::send(opts, {"deleteInstance", http::verb::delete_, "/deleteInstance", body.dump()});
+    }
+}
+
+void printMocks(const std::vector<std::unique_ptr<MockProvider>>& mocks) {
+    std::cout << "\nmock providers:\n";
+    for (const auto& mock : mocks) {
+        auto c = mock->counters();
+        std::cout << "  " << mock->name() << ": " << c.requests << " requests, " << c.errors << " injected errors\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Args args;
+    try {
+        if (!parse(argc, argv, args)) {
+            usage();
+            return 0;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n\n";
+        usage();
+        return 2;
+    }
+
+    net::io_context ioc;
+    std::vector<std::unique_ptr<MockProvider>> mocks;
+    mocks.push_back(std::make_unique<MockProvider>(ioc, MockKind::EVOLUTION, args.evo_port, args.fault));
+    mocks.push_back(std::make_unique<MockProvider>(ioc, MockKind::WUZAPI, args.wuz_port, args.fault));
+    mocks.push_back(std::make_unique<MockProvider>(ioc, MockKind::CLOUD, args.cloud_port, args.fault));
+    try {
+        for (auto& mock : mocks) {
+            mock->start();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "could not start the mock providers: " << e.what() << "\n";
+        return 1;
+    }
+
+    auto work = net::make_work_guard(ioc);
+    std::vector<std::thread> io_threads;
+    for (unsigned i = 0; i < std::max(2u, std::thread::hardware_concurrency() / 2); ++i) {
+        io_threads.emplace_back([&ioc] { ioc.run(); });
+    }
+    auto stop = [&] {
+        work.reset();
+        ioc.stop();
+        for (auto& t : io_threads) {
+            t.join();
+        }
+    };
+
+    std::cout << "mock providers listening; start wasolution with these in its .env:\n"
+              << "  EVO_URL=http://127.0.0.1:" << args.evo_port << "\n"
+              << "  EVO_TOKEN=bench\n"
+              << "  WUZ_URL=http://127.0.0.1:" << args.wuz_port << "\n"
+              << "  WUZ_ADMIN_TOKEN=bench\n"
+              << "  CLOUD_URL=http://127.0.0.1:" << args.cloud_port << "\n"
+              << "  RATE_LIMIT_INSTANCE_PER_MIN=0\n"
+              << "  RATE_LIMIT_PROVIDER_PER_MIN=0\n";
+
+    if (args.mocks_only) {
+        net::signal_set signals(ioc, SIGINT, SIGTERM);
+        std::promise<void> interrupted;
+        signals.async_wait([&](const boost::system::error_code&, int) { interrupted.set_value(); });
+        interrupted.get_future().wait();
+        stop();
+        printMocks(mocks);
+        return 0;
+    }
+
+    LoadGenerator::Options opts;
+    opts.host = args.host;
+    opts.port = args.port;
+    opts.token = args.token;
+    opts.rps = args.rps;
+    opts.duration = std::chrono::seconds(args.duration_s);
+    opts.connections = args.connections;
+
+    const std::string prefix = "bench-" + std::to_string(::getpid()) + "-";
+    std::vector<std::string> senders;
+    std::vector<std::string> templates;
+    std::vector<std::string> created;
+    std::mutex created_mtx;
+    int rc = 0;
+    try {
+        if (args.scenario == "sendMessage" || args.scenario == "mixed") {
+            senders = createInstances(opts, prefix, args.provider, args.instances);
+        }
+        // Templates only exist on the Cloud API.
+        if (args.scenario == "sendTemplate" || args.scenario == "mixed") {
+            templates = args.provider == "CLOUD" && !senders.empty()
+                ? senders
+                : createInstances(opts, prefix + "cloud-", "CLOUD", args.instances);
+        }
+        std::cout << "\n" << args.scenario << " at " << args.rps << " req/s for " << args.duration_s << "s over "
+                  << args.connections << " connections, provider latency " << args.fault.latency_ms << "+" << args.fault.jitter_ms
+                  << "ms, error rate " << args.fault.error_rate << "\n";
+
+        auto createNew = [&](std::uint64_t seq) {
+            std::string id = prefix + "new-" + std::to_string(seq);
+            {
+                std::lock_guard<std::mutex> lock(created_mtx);
+                created.push_back(id);
+            }
+            return createCall(id, args.provider);
+        };
+        auto plan = [&](std::uint64_t seq) -> LoadGenerator::Call {
+            std::string scenario = args.scenario;
+            if (scenario == "mixed") {
+                // 70% sends, 10% each of the rest.
+                const auto slot = seq % 10;
+                scenario = slot < 7 ? "sendMessage" : slot == 7 ? "sendTemplate" : slot == 8 ? "retrieveInstances" : "createInstance";
+            }
+            if (scenario == "sendMessage") {
+                return sendMessageCall(senders[seq % senders.size()], seq);
+            }
+            if (scenario == "sendTemplate") {
+                return sendTemplateCall(templates[seq % templates.size()]);
+            }
+            if (scenario == "createInstance") {
+                return createNew(seq);
+            }
+            return {"retrieveInstances", http::verb::get, "/retrieveInstances", ""};
+        };
+
+        auto report = LoadGenerator::run(opts, plan);
+        LoadGenerator::print(report, std::cout);
+        printMocks(mocks);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        rc = 1;
+    }
+
+    if (!args.keep_instances) {
+        std::vector<std::string> all = senders;
+        all.insert(all.end(), templates.begin(), templates.end());
+        all.insert(all.end(), created.begin(), created.end());
+        std::sort(all.begin(), all.end());
+        all.erase(std::unique(all.begin(), all.end()), all.end());
+        deleteInstances(opts, all);
+    }
+    stop();
+    return rc;
+}
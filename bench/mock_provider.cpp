@@ -0,0 +1,166 @@
+#include "mock_provider.h"
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string_view>
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+namespace {
+
+bool endsWith(std::string_view s, std::string_view suffix) {
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+}
+
+// Bodies carry the fields the adapters read back: ids for sends, "data" for Wuzapi and the phone number list for Cloud.
+std::string cannedBody(MockKind kind, std::string_view path, std::uint64_t seq) {
+    switch (kind) {
+    case MockKind::EVOLUTION:
+        if (path.substr(0, 9) == "/message/") {
+            return R"({"key":{"remoteJid":"5511999999999@s.whatsapp.net","fromMe":true,"id":"BENCH)" + std::to_string(seq) +
+                   R"("},"status":"PENDING"})";
+        }
+        if (path == "/instance/create") {
+            return R"({"instance":{"instanceName":"bench","status":"created"},"hash":{"apikey":"bench"},"qrcode":{"base64":""}})";
+        }
+        return R"({"status":"SUCCESS","error":false})";
+    case MockKind::WUZAPI:
+        if (path.substr(0, 11) == "/chat/send/") {
+            return R"({"code":200,"data":{"Details":"Sent","Id":"BENCH)" + std::to_string(seq) + R"("},"success":true})";
+        }
+        return R"({"code":200,"data":{"Details":"ok"},"success":true})";
+    case MockKind::CLOUD:
+        if (endsWith(path, "/phone_numbers")) {
+            return R"({"data":[{"id":"100000000000001","display_phone_number":"+55 11 99999-9999"}]})";
+        }
+        if (endsWith(path, "/messages")) {
+            return R"({"messaging_product":"whatsapp","contacts":[{"input":"5511999999999","wa_id":"5511999999999"}],"messages":[{"id":"wamid.BENCH)" +
+                   std::to_string(seq) + R"("}]})";
+        }
+        return R"({"success":true})";
+    }
+    return "{}";
+}
+
+} // namespace
+
+class MockProvider::Session : public std::enable_shared_from_this<MockProvider::Session> {
+public:
+    Session(MockProvider& owner, tcp::socket socket)
+        : owner_(owner), stream_(std::move(socket)), timer_(stream_.get_executor()), rng_(std::random_device{}()) {}
+
+    void run() { read(); }
+
+private:
+    void read() {
+        req_ = {};
+        http::async_read(stream_, buffer_, req_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec) {
+                self->stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
+                return;
+            }
+            self->respond();
+        });
+    }
+
+    void respond() {
+        const auto seq = owner_.requests_.fetch_add(1, std::memory_order_relaxed);
+        const auto& fault = owner_.fault_;
+        const bool fail = fault.error_rate > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < fault.error_rate;
+
+        auto target = req_.target();
+        std::string_view path(target.data(), target.size());
+        path = path.substr(0, path.find('?'));
+
+        res_ = {};
+        res_.version(req_.version());
+        res_.keep_alive(req_.keep_alive());
+        res_.set(http::field::content_type, "application/json");
+        if (fail) {
+            owner_.errors_.fetch_add(1, std::memory_order_relaxed);
+            res_.result(http::status::internal_server_error);
+            res_.body() = R"({"error":"injected failure"})";
+        } else {
+            res_.result(http::status::ok);
+            res_.body() = cannedBody(owner_.kind_, path, seq);
+        }
+        res_.prepare_payload();
+
+        unsigned delay = fault.latency_ms;
+        if (fault.jitter_ms > 0) {
+            delay += std::uniform_int_distribution<unsigned>(0, fault.jitter_ms)(rng_);
+        }
+        if (delay == 0) {
+            write();
+            return;
+        }
+        timer_.expires_after(std::chrono::milliseconds(delay));
+        timer_.async_wait([self = shared_from_this()](beast::error_code) { self->write(); });
+    }
+
+    void write() {
+        http::async_write(stream_, res_, [self = shared_from_this()](beast::error_code ec, std::size_t) {
+            if (ec || !self->res_.keep_alive()) {
+                self->stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
+                return;
+            }
+            self->read();
+        });
+    }
+
+    MockProvider& owner_;
+    beast::tcp_stream stream_;
+    net::steady_timer timer_;
+    beast::flat_buffer buffer_;
+    http::request<http::string_body> req_;
+    http::response<http::string_body> res_;
+    std::mt19937 rng_;
+};
+
+MockProvider::MockProvider(net::io_context& ioc, MockKind kind, unsigned short port, Fault fault)
+    : ioc_(ioc), kind_(kind), port_(port), fault_(fault), acceptor_(net::make_strand(ioc)) {}
+
+void MockProvider::start() {
+    const tcp::endpoint endpoint(net::ip::make_address("127.0.0.1"), port_);
+    acceptor_.open(endpoint.protocol());
+    acceptor_.set_option(net::socket_base::reuse_address(true));
+    acceptor_.bind(endpoint);
+    acceptor_.listen(net::socket_base::max_listen_connections);
+    accept();
+}
+
+void MockProvider::accept() {
+    acceptor_.async_accept(net::make_strand(ioc_), [this](beast::error_code ec, tcp::socket socket) {
+        if (ec) {
+            std::cerr << name() << " mock: accept failed: " << ec.message() << "\n";
+        } else {
+            socket.set_option(tcp::no_delay(true), ec);
+            std::make_shared<Session>(*this, std::move(socket))->run();
+        }
+        accept();
+    });
+}
+
+MockProvider::Counters MockProvider::counters() const {
+    return {requests_.load(std::memory_order_relaxed), errors_.load(std::memory_order_relaxed)};
+}
+
+const char* MockProvider::name() const {
+    switch (kind_) {
+    case MockKind::EVOLUTION:
+        return "EVOLUTION";
+    case MockKind::WUZAPI:
+        return "WUZAPI";
+    case MockKind::CLOUD:
+        return "CLOUD";
+    }
+    return "";
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+enum class MockKind {
+    EVOLUTION,
+    WUZAPI,
+    CLOUD
+};
+
+/* Local stand-in for one provider API. Answers every endpoint the adapters
+   call with a canned success body of the shape the adapter parses, after an
+   injected delay, and fails a share of the requests with HTTP 500. */
+class MockProvider {
+public:
+    typedef struct {
+        unsigned latency_ms = 0;
+        unsigned jitter_ms = 0;
+        // Share of requests answered with 500, between 0 and 1.
+        double error_rate = 0.0;
+    } Fault;
+
+    typedef struct {
+        std::uint64_t requests;
+        std::uint64_t errors;
+    } Counters;
+
+    MockProvider(boost::asio::io_context& ioc, MockKind kind, unsigned short port, Fault fault);
+
+    void start();
+    Counters counters() const;
+    const char* name() const;
+    unsigned short port() const { return port_; }
+
+private:
+    class Session;
+    void accept();
+
+    boost::asio::io_context& ioc_;
+    MockKind kind_;
+    unsigned short port_;
+    Fault fault_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    std::atomic<std::uint64_t> requests_{0};
+    std::atomic<std::uint64_t> errors_{0};
+};
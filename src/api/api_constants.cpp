@@ -22,19 +22,3 @@ bool isHttpResponseOk(CURL* curl) {
 #ifdef __cplusplus
 }
 #endif
-
-std::string getMimeTypeExtensions(std::string mime_type) {
-    if (mime_type == "png") return ".png";
-    if (mime_type == "jpeg") return ".jpg";
-    if (mime_type == "gif") return ".gif";
-    if (mime_type == "pdf") return ".pdf";
-    if (mime_type == "msword") return ".doc";
-    if (mime_type == "vnd.openxmlformats-officedocument.wordprocessingml.document") return ".docx";
-    if (mime_type == "plain") return ".txt";
-    if (mime_type == "html") return ".html";
-    if (mime_type == "mpeg") return ".mp3";
-    if (mime_type == "wav") return ".wav";
-    if (mime_type == "webm") return ".webm";
-    if (mime_type == "mp4") return ".mp4";
-    return "unknown";
-}
@@ -14,4 +14,3 @@ bool isHttpResponseOk(CURL* curl);
 }
 #endif
 
-std::string getMimeTypeExtensions(std::string mime_type);
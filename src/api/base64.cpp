@@ -0,0 +1,222 @@
+#include "base64.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define WASOLUTION_BASE64_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+using Kernel = std::size_t (*)(const unsigned char* in, std::size_t n, char* out);
+
+// Encodes whole blocks only and returns how many input bytes it consumed.
+std::size_t encodeScalar(const unsigned char* in, std::size_t n, char* out) {
+    std::size_t i = 0;
+    for (; i + 3 <= n; i += 3) {
+        unsigned v = (unsigned(in[i]) << 16) | (unsigned(in[i + 1]) << 8) | unsigned(in[i + 2]);
+        *out++ = alphabet[(v >> 18) & 0x3f];
+        *out++ = alphabet[(v >> 12) & 0x3f];
+        *out++ = alphabet[(v >> 6) & 0x3f];
+        *out++ = alphabet[v & 0x3f];
+    }
+    return i;
+}
+
+#ifdef WASOLUTION_BASE64_X86
+
+/* Vector kernels after Wojciech Muła's "base64 encoding with SIMD
+   instructions": a byte shuffle places each 3-byte group in a 32-bit lane,
+   two multiplies move the four 6-bit fields into separate bytes and a pshufb
+   table adds the ASCII offset of the range each index falls in. */
+
+__attribute__((target("ssse3")))
+inline __m128i splitSsse3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i lookupSsse3(__m128i indices) {
+    __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    const __m128i shift = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                        '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, result), indices);
+}
+
+__attribute__((target("ssse3")))
+std::size_t encodeSsse3(const unsigned char* in, std::size_t n, char* out) {
+    std::size_t i = 0;
+    // Each step reads 16 bytes and uses 12 of them.
+    for (; i + 16 <= n; i += 12, out += 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), lookupSsse3(splitSsse3(block)));
+    }
+    return i + encodeScalar(in + i, n - i, out);
+}
+
+__attribute__((target("avx2")))
+inline __m256i splitAvx2(__m256i in) {
+    in = _mm256_shuffle_epi8(in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                                 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t1, t3);
+}
+
+__attribute__((target("avx2")))
+inline __m256i lookupAvx2(__m256i indices) {
+    __m256i result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    const __m256i shift = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                           '/' - 63, 'A', 0, 0,
+                                           'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                           '/' - 63, 'A', 0, 0);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shift, result), indices);
+}
+
+__attribute__((target("avx2")))
+std::size_t encodeAvx2(const unsigned char* in, std::size_t n, char* out) {
+    std::size_t i = 0;
+    // Each 128-bit lane takes 12 bytes; the upper load reads 4 bytes past them.
+    for (; i + 28 <= n; i += 24, out += 32) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+        __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), lookupAvx2(splitAvx2(block)));
+    }
+    return i + encodeSsse3(in + i, n - i, out);
+}
+
+#endif
+
+struct Dispatch {
+    Kernel kernel = encodeScalar;
+    const char* name = "scalar";
+
+    Dispatch() {
+#ifdef WASOLUTION_BASE64_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            kernel = encodeAvx2;
+            name = "avx2";
+        } else if (__builtin_cpu_supports("ssse3")) {
+            kernel = encodeSsse3;
+            name = "ssse3";
+        }
+#endif
+    }
+};
+
+const Dispatch& dispatch() {
+    static const Dispatch selected;
+    return selected;
+}
+
+int decodeChar(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+' || c == '-') return 62;
+    if (c == '/' || c == '_') return 63;
+    return -1;
+}
+
+void encodeUsing(Kernel kernel, std::string_view in, std::string& out) {
+    const std::size_t start = out.size();
+    out.resize(start + Base64::encodedSize(in.size()));
+    char* dst = out.data() + start;
+
+    const auto* src = reinterpret_cast<const unsigned char*>(in.data());
+    std::size_t done = kernel(src, in.size(), dst);
+    dst += done / 3 * 4;
+
+    std::size_t rest = in.size() - done;
+    if (rest == 1) {
+        unsigned v = unsigned(src[done]) << 16;
+        *dst++ = alphabet[(v >> 18) & 0x3f];
+        *dst++ = alphabet[(v >> 12) & 0x3f];
+        *dst++ = '=';
+        *dst++ = '=';
+    } else if (rest == 2) {
+        unsigned v = (unsigned(src[done]) << 16) | (unsigned(src[done + 1]) << 8);
+        *dst++ = alphabet[(v >> 18) & 0x3f];
+        *dst++ = alphabet[(v >> 12) & 0x3f];
+        *dst++ = alphabet[(v >> 6) & 0x3f];
+        *dst++ = '=';
+    }
+}
+
+} // namespace
+
+void Base64::encode(std::string_view in, std::string& out) {
+    encodeUsing(dispatch().kernel, in, out);
+}
+
+std::string Base64::encode(std::string_view in) {
+    std::string out;
+    encode(in, out);
+    return out;
+}
+
+std::string Base64::decodePrefix(std::string_view in, std::size_t max_bytes) {
+    std::string out;
+    unsigned acc = 0;
+    int bits = 0;
+    for (char c : in) {
+        if (out.size() >= max_bytes) {
+            break;
+        }
+        int v = decodeChar(c);
+        if (v < 0) {
+            if (c == '=') {
+                break;
+            }
+            continue;
+        }
+        acc = (acc << 6) | static_cast<unsigned>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<char>((acc >> bits) & 0xff));
+        }
+    }
+    return out;
+}
+
+const char* Base64::kernel() {
+    return dispatch().name;
+}
+
+bool Base64::encodeWith(std::string_view kernel, std::string_view in, std::string& out) {
+    Kernel selected = nullptr;
+    if (kernel == "scalar") {
+        selected = encodeScalar;
+    }
+#ifdef WASOLUTION_BASE64_X86
+    __builtin_cpu_init();
+    if (kernel == "ssse3" && __builtin_cpu_supports("ssse3")) {
+        selected = encodeSsse3;
+    } else if (kernel == "avx2" && __builtin_cpu_supports("avx2")) {
+        selected = encodeAvx2;
+    }
+#endif
+    if (!selected) {
+        return false;
+    }
+    encodeUsing(selected, in, out);
+    return true;
+}
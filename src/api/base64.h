@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/* Standard (RFC 4648, padded) base64. Encoding picks the widest kernel the CPU
+   supports at startup: AVX2 (24 bytes per step), SSSE3 (12 bytes per step) or
+   the portable scalar loop, which also handles every tail. */
+class Base64 {
+public:
+    Base64() = delete;
+
+    static constexpr std::size_t encodedSize(std::size_t n) { return (n + 2) / 3 * 4; }
+
+    // Appends the encoding of `in` to `out`, growing it exactly once.
+    static void encode(std::string_view in, std::string& out);
+    static std::string encode(std::string_view in);
+
+    // Decodes the leading `max_bytes` bytes, enough to sniff a file signature.
+    static std::string decodePrefix(std::string_view in, std::size_t max_bytes);
+
+    // Name of the kernel selected for this CPU ("avx2", "ssse3" or "scalar").
+    static const char* kernel();
+    // encode() through the named kernel, so the vector ones can be checked against the scalar one.
+    // False, leaving `out` alone, when the kernel is unknown or this CPU cannot run it.
+    static bool encodeWith(std::string_view kernel, std::string_view in, std::string& out);
+};
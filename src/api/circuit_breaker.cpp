@@ -0,0 +1,147 @@
+#include "circuit_breaker.h"
+#include "config/config.h"
+#include "logger/logger.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+extern Logger apiLogger;
+
+namespace {
+
+typedef struct {
+    std::mutex mtx;
+    std::map<std::string, std::unique_ptr<CircuitBreaker>, std::less<>> breakers;
+} Registry;
+
+Registry& registry() {
+    static Registry reg;
+    return reg;
+}
+
+const char* stateName(CircuitBreaker::State state) {
+    switch (state) {
+        case CircuitBreaker::State::OPEN: return "aberto";
+        case CircuitBreaker::State::HALF_OPEN: return "meio-aberto";
+        case CircuitBreaker::State::CLOSED: break;
+    }
+    return "fechado";
+}
+
+} // namespace
+
+CircuitBreaker& CircuitBreaker::forProvider(const std::string& provider) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    auto& slot = reg.breakers[provider];
+    if (!slot) {
+        slot.reset(new CircuitBreaker(provider));
+    }
+    return *slot;
+}
+
+std::vector<CircuitBreaker::Snapshot> CircuitBreaker::all() {
+    std::vector<Snapshot> out;
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    for (auto& [provider, breaker] : reg.breakers) {
+        std::lock_guard<std::mutex> breaker_lock(breaker->mtx_);
+        out.push_back(Snapshot{provider, breaker->state_, breaker->rejected_, breaker->opened_});
+    }
+    return out;
+}
+
+CircuitBreaker::Permit CircuitBreaker::allow() {
+    auto env = Config::current();
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (state_ == State::OPEN) {
+        if (now < open_until_) {
+            ++rejected_;
+            return Permit::REJECTED;
+        }
+        state_ = State::HALF_OPEN;
+        probes_in_flight_ = 0;
+        probes_succeeded_ = 0;
+        apiLogger.info("Circuito do provedor {} meio-aberto, enviando requisições de teste", provider_);
+    }
+    if (state_ == State::HALF_OPEN) {
+        if (probes_in_flight_ + probes_succeeded_ >= std::max(env->circuit_half_open_probes, 1)) {
+            ++rejected_;
+            return Permit::REJECTED;
+        }
+        ++probes_in_flight_;
+        return Permit::PROBE;
+    }
+    return Permit::CALL;
+}
+
+void CircuitBreaker::record(Permit permit, bool failed, double seconds) {
+    if (permit == Permit::REJECTED) {
+        return;
+    }
+    auto env = Config::current();
+    auto now = std::chrono::steady_clock::now();
+    failed = failed || (env->circuit_slow_ms > 0 && seconds * 1000.0 > env->circuit_slow_ms);
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (permit == Permit::PROBE) {
+        if (state_ != State::HALF_OPEN) {
+            return;
+        }
+        --probes_in_flight_;
+        if (failed) {
+            open(now, "requisição de teste falhou");
+        } else if (++probes_succeeded_ >= std::max(env->circuit_half_open_probes, 1)) {
+            close();
+        }
+        return;
+    }
+    // Calls that started before the breaker opened do not count towards the next window.
+    if (state_ != State::CLOSED) {
+        return;
+    }
+
+    const std::int64_t second = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+    const std::int64_t window_s = std::clamp<std::int64_t>(env->circuit_window_s, 1, max_window_s);
+    Slot& slot = window_[static_cast<std::size_t>(second) % max_window_s];
+    if (slot.second != second) {
+        slot = Slot{second, 0, 0};
+    }
+    ++slot.total;
+    if (failed) {
+        ++slot.failed;
+    } else {
+        return;
+    }
+
+    std::uint64_t total = 0;
+    std::uint64_t failures = 0;
+    for (const auto& s : window_) {
+        if (s.second > second - window_s) {
+            total += s.total;
+            failures += s.failed;
+        }
+    }
+    if (total >= static_cast<std::uint64_t>(std::max(env->circuit_min_requests, 1)) &&
+        failures * 100 >= total * static_cast<std::uint64_t>(std::clamp(env->circuit_error_percent, 1, 100))) {
+        open(now, "taxa de erro acima do limite");
+    }
+}
+
+void CircuitBreaker::open(std::chrono::steady_clock::time_point now, const char* reason) {
+    auto env = Config::current();
+    apiLogger.warn("Circuito do provedor {} {} -> aberto por {}s: {}", provider_, stateName(state_), env->circuit_open_s, reason);
+    state_ = State::OPEN;
+    open_until_ = now + std::chrono::seconds(std::max(env->circuit_open_s, 1));
+    probes_in_flight_ = 0;
+    probes_succeeded_ = 0;
+    ++opened_;
+}
+
+void CircuitBreaker::close() {
+    apiLogger.info("Circuito do provedor {} fechado, provedor respondendo novamente", provider_);
+    state_ = State::CLOSED;
+    window_.fill(Slot{});
+}
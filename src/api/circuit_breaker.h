@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Per-provider circuit breaker used by HttpClient (CIRCUIT_* settings).
+
+   Closed: calls go through and their outcome is counted in a sliding window
+   of one-second slots. A call fails when curl fails, the provider answers
+   5xx, or it takes longer than CIRCUIT_SLOW_MS. Once the window holds
+   CIRCUIT_MIN_REQUESTS calls and CIRCUIT_ERROR_PERCENT of them failed, the
+   breaker opens.
+   Open: calls fail at once, without touching the network, for CIRCUIT_OPEN_S.
+   Half-open: up to CIRCUIT_HALF_OPEN_PROBES calls are let through. If they
+   all succeed the breaker closes with an empty window; the first failure
+   opens it again. */
+class CircuitBreaker {
+public:
+    enum class State {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+    // What allow() granted; hand it back to record().
+    enum class Permit {
+        REJECTED,
+        CALL,
+        PROBE
+    };
+
+    typedef struct {
+        std::string provider;
+        State state;
+        std::uint64_t rejected;
+        std::uint64_t opened;
+    } Snapshot;
+
+    // One breaker per provider label, created on first use and never destroyed.
+    static CircuitBreaker& forProvider(const std::string& provider);
+    static std::vector<Snapshot> all();
+
+    Permit allow();
+    void record(Permit permit, bool failed, double seconds);
+
+    CircuitBreaker(const CircuitBreaker&) = delete;
+    CircuitBreaker& operator=(const CircuitBreaker&) = delete;
+
+private:
+    static constexpr std::size_t max_window_s = 120;
+
+    typedef struct {
+        std::int64_t second;
+        std::uint32_t total;
+        std::uint32_t failed;
+    } Slot;
+
+    explicit CircuitBreaker(std::string provider) : provider_(std::move(provider)) {}
+
+    void open(std::chrono::steady_clock::time_point now, const char* reason);
+    void close();
+
+    const std::string provider_;
+    std::mutex mtx_;
+    State state_ = State::CLOSED;
+    std::array<Slot, max_window_s> window_{};
+    std::chrono::steady_clock::time_point open_until_{};
+    int probes_in_flight_ = 0;
+    int probes_succeeded_ = 0;
+    std::uint64_t rejected_ = 0;
+    std::uint64_t opened_ = 0;
+};
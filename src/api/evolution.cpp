@@ -1,6 +1,10 @@
 #include "evolution.h"
 #include "api_constants.h"
+#include "http_client.h"
+#include "media.h"
+#include "request_body.h"
 #include "logger/logger.h"
+#include "logger/log_policy.h"
 #include "config/config.h"
 #include "spdlog/fmt/fmt.h" // Add this for fmt::format
 using std::string;
@@ -10,7 +14,7 @@ extern Logger apiLogger;
 /*Status Evolution::setRabbit_e(string token, string rabbit_url, string url, string evo_token) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== SET RABBIT (EVOLUTION) STARTING ===");
-    apiLogger.info("Colocando rabbit com url: " + rabbit_url);
+    apiLogger.info("Colocando rabbit com url: {}", rabbit_url);
     CURL *curl = curl_easy_init();
     std::string responseBody;
     Status stat;
@@ -35,7 +39,7 @@ extern Logger apiLogger;
     };
 
     std::string req_body = req_body_json.dump();
-    apiLogger.debug("Request body: " + req_body);
+    apiLogger.debug("Request body: {}", LogPolicy::body(req_body));
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
@@ -45,19 +49,19 @@ extern Logger apiLogger;
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
 
     apiLogger.debug("Executando requisição CURL para conexão da instância...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
+    if (const HttpResult res = HttpClient::instance().perform(curl, {"EVOLUTION", "setRabbit_e"}); res.code != CURLE_OK) {
+        apiLogger.error("Erro CURL: {}", res.error);
         curl_slist_free_all(headers);
         curl_easy_cleanup(curl);
         stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json {{ "error", curl_easy_strerror(res)}};
+        stat.status_string = nlohmann::json {{ "error", res.error}};
         return stat;
     }
     long http_code = 0;
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
     bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    apiLogger.info("Código de resposta HTTP: {}", http_code);
+    apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
     curl_slist_free_all(headers);
     curl_easy_cleanup(curl);
@@ -73,7 +77,7 @@ extern Logger apiLogger;
         nlohmann::json response = nlohmann::json::parse(responseBody);
 
         if (!http_ok) {
-            apiLogger.error("Erro HTTP ao conectar instância - Código: " + std::to_string(http_code));
+            apiLogger.error("Erro HTTP ao conectar instância - Código: {}", http_code);
             stat.status_code = c_status::ERR;
             stat.status_string = response;
             if (!response.contains("error")) {
@@ -81,12 +85,12 @@ extern Logger apiLogger;
                 stat.status_string = response;
             }
         } else {
-            apiLogger.info("Rabbit conectada com sucesso: " + token);
+            apiLogger.info("Rabbit conectada com sucesso: {}", token);
             stat.status_code = c_status::OK;
             stat.status_string = response;
         }
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da conexão: " + std::string(e.what()));
+        apiLogger.error("Erro ao processar resposta da conexão: {}", e.what());
         if (!http_ok) {
             stat.status_code = c_status::ERR;
             stat.status_string = nlohmann::json{
@@ -103,15 +107,14 @@ extern Logger apiLogger;
 
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== SET RABBIT (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+    apiLogger.info("=== SET RABBIT (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
     return stat;
 
 } */
 
-
 Evolution::Proxy Evolution::ParseProxy(std::string proxy_url) {
-    apiLogger.debug("Analisando URL do proxy: " + proxy_url);
+    apiLogger.debug("Analisando URL do proxy: {}", proxy_url);
     Proxy proxy = {"", "", "", "", ""};
     try {
         size_t proto_end = proxy_url.find("://");
@@ -156,7 +159,7 @@ Evolution::Proxy Evolution::ParseProxy(std::string proxy_url) {
                 proxy.host = proxy_url.substr(host_start);
             }
         }
-        apiLogger.debug("Proxy analisado com sucesso: " + proxy.protocol + "://" + proxy.host + ":" + proxy.port);
+        apiLogger.debug("Proxy analisado com sucesso: {}://{}:{}", proxy.protocol, proxy.host, proxy.port);
     } catch (...) {
         apiLogger.error("Erro ao analisar URL do proxy");
         return Proxy{"", "", "", "", ""};
@@ -164,262 +167,247 @@ Evolution::Proxy Evolution::ParseProxy(std::string proxy_url) {
     return proxy;
 }
 
-Status Evolution::sendMessage_e(string phone, string token, string url, MediaType type, string msg_template, string instance_name) {
+// Drops a "data:<mime>;base64," prefix in place, the payload itself is not copied.
+static bool stripDataUrl(std::string_view& data, std::string_view* mime_type = nullptr) {
+    if (data.substr(0, 5) != "data:") {
+        return false;
+    }
+    size_t comma_pos = data.find(',');
+    if (comma_pos == std::string_view::npos) {
+        return false;
+    }
+    if (mime_type != nullptr) {
+        size_t semicolon_pos = data.find(';');
+        *mime_type = data.substr(5, std::min(semicolon_pos, comma_pos) - 5);
+    }
+    data.remove_prefix(comma_pos + 1);
+    return true;
+}
+
+void Evolution::sendMessage_e(string phone, string token, string url, MediaType type, std::string_view msg_template, string instance_name, ResponseMode mode,
+                              StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== SEND MESSAGE (EVOLUTION) START ===");
-    apiLogger.info("Enviando mensagem para número: " + phone + " via Evolution");
-    apiLogger.debug("Tipo de mídia: " + std::to_string(static_cast<int>(type)));
-    apiLogger.debug("Instância: " + instance_name);
+    apiLogger.info("Enviando mensagem para número: {} via Evolution", phone);
+    apiLogger.debug("Tipo de mídia: {}", static_cast<int>(type));
+    apiLogger.debug("Instância: {}", instance_name);
     
     if (phone.empty()) {
         apiLogger.error("Número de telefone inválido: phone está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid phone number: phone is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid phone number: phone is empty"}}});
+        return;
     }
     if (token.empty()) {
         apiLogger.error("Token inválido: token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid token: token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid token: token is empty"}}});
+        return;
     }
     if (url.empty()) {
         apiLogger.error("URL da API inválida: url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}});
+        return;
     }
     if (msg_template.empty()) {
         apiLogger.error("Template da mensagem inválido: msg_template está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid message template: msg_template is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid message template: msg_template is empty"}}});
+        return;
     }
     if (instance_name.empty()) {
         apiLogger.error("Nome da instância inválido: instance_name está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance name: instance_name is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance name: instance_name is empty"}}});
+        return;
     }
     
-    CURL* curl = curl_easy_init();
-    std::string responseBody;
-    Status stat;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Failed to initialize CURL"}}});
+        return;
     }
     string req_url;
-    nlohmann::json req_body_json;
+    RequestBody& req_body = call->body;
+    req_body.beginObject().field("number", phone);
     if (type == MediaType::TEXT) {
         req_url = fmt::format("{}/message/sendText/{}", url, instance_name);
-        req_body_json = {
-            {"number", phone},
-            {"text", msg_template}
-        };
+        req_body.field("text", msg_template);
         apiLogger.debug("Enviando mensagem de texto");
     } else if (type == MediaType::AUDIO) {
         req_url = fmt::format("{}/message/sendWhatsappAudio/{}", url, instance_name);
-        std::string audio_data = msg_template;
-        if (!audio_data.empty() && audio_data.substr(0, 37) == "data:audio/webm;codecs=opus;base64,") {
-            audio_data = audio_data.substr(37);
+        std::string_view audio_data = msg_template;
+        if (stripDataUrl(audio_data)) {
             apiLogger.debug("Removed data URL prefix from audio base64 data");
-        } else if (!audio_data.empty() && audio_data.substr(0, 5) == "data:") {
-            size_t comma_pos = audio_data.find(',');
-            if (comma_pos != std::string::npos) {
-                audio_data = audio_data.substr(comma_pos + 1);
-                apiLogger.debug("Removed data URL prefix from audio base64 data");                                      
-            }
         }
-        req_body_json = {
-            {"number", phone},
-            {"audio", audio_data},
-            {"delay", 100}
-        };
+        req_body.field("audio", audio_data).field("delay", 100LL);
         apiLogger.debug("Enviando mensagem de áudio");
     } else if (type == MediaType::IMAGE) {
         req_url = fmt::format("{}/message/sendMedia/{}", url, instance_name);
+        auto sniffed = Media::sniffBase64(msg_template);
+        std::string_view mime_type = sniffed ? sniffed->mime : "image/png";
+        std::string file_name = "imagem" + std::string(sniffed ? sniffed->extension : ".png");
 
-        std::string media_data = msg_template;
-        if (!media_data.empty() && media_data.substr(0, 22) == "data:image/png;base64,") {
-            media_data = media_data.substr(22);
+        std::string_view media_data = msg_template;
+        if (stripDataUrl(media_data)) {
             apiLogger.debug("Removed data URL prefix from base64 data");
-        } else if (!media_data.empty() && media_data.substr(0, 5) == "data:") {
-            size_t comma_pos = media_data.find(',');
-            if (comma_pos != std::string::npos) {
-                media_data = media_data.substr(comma_pos + 1);
-                apiLogger.debug("Removed data URL prefix from base64 data");
-            }
         }
-        
-        req_body_json = {
-            {"number", phone},
-            {"media", media_data},
-            {"mediatype", "image"},
-            {"mimetype", "image/png"},
-            {"caption", ""},
-            {"fileName", "imagem.png"}
-        };
+        req_body.field("media", media_data)
+                .field("mediatype", "image")
+                .field("mimetype", mime_type)
+                .field("caption", "")
+                .field("fileName", file_name);
         apiLogger.debug("Enviando mensagem de imagem");
-        apiLogger.debug("Media data length: " + std::to_string(media_data.length()));
-        if (media_data.length() > 50) {
-            apiLogger.debug("Media data preview: " + media_data.substr(0, 50) + "...");
-        } else {
-            apiLogger.debug("Media data: " + media_data);
-        }
+        apiLogger.debug("Media data: {} ({})", LogPolicy::media(media_data), mime_type);
     } else if (type == MediaType::DOCUMENT) {
         req_url = fmt::format("{}/message/sendMedia/{}", url, instance_name);
-        std::string mime_type = "unknown";
-
-        std::string media_data = msg_template;
-        if (!media_data.empty() && media_data.substr(0, 5) == "data:") {
-            size_t semicolon_pos = media_data.find(';');
-
-            if (semicolon_pos != std::string::npos) {
-                mime_type = media_data.substr(5, semicolon_pos - 5);
-            }
-
-            size_t comma_pos = media_data.find(',');
-            if (comma_pos != std::string::npos) {
-                std::string prefix = media_data.substr(0, comma_pos + 1);
-                media_data = media_data.substr(comma_pos + 1);
-                apiLogger.debug("Removed data URL prefix: " + prefix);
-                apiLogger.debug("Detected MIME type: " + mime_type);
-            } else {
-                apiLogger.error("Data URL format detected but no comma separator found");
-            }
+        std::string_view media_data = msg_template;
+        std::string_view declared;
+        if (stripDataUrl(media_data, &declared)) {
+            apiLogger.debug("Removed data URL prefix, declared MIME type: {}", declared);
+        } else if (media_data.substr(0, 5) == "data:") {
+            apiLogger.error("Data URL format detected but no comma separator found");
         }
-        mime_type = mime_type.substr(mime_type.find('/') + 1);
 
-        std::string file_extension = getMimeTypeExtensions(mime_type);
-        std::string file_name = "document" + file_extension;
+        // The file's signature wins over what the client declared.
+        auto sniffed = Media::sniffBase64(media_data);
+        std::string_view mime_type = sniffed ? sniffed->mime : (declared.empty() ? "application/octet-stream" : declared);
+        std::string file_name = "document" + std::string(Media::extension(mime_type));
 
-
-        req_body_json = {
-            {"number", phone},
-            {"media", media_data},
-            {"mediatype", "document"},
-            {"mimetype", mime_type},
-            {"caption", ""},
-            {"fileName", file_name}
-        };
+        req_body.field("media", media_data)
+                .field("mediatype", "document")
+                .field("mimetype", mime_type)
+                .field("caption", "")
+                .field("fileName", file_name);
         apiLogger.debug("Enviando mensagem de documento");
-        apiLogger.debug("Media data length: " + std::to_string(media_data.length()));
-        if (media_data.length() > 50) {
-            apiLogger.debug("Media data preview: " + media_data.substr(0, 50) + "...");
-        } else {
-            apiLogger.debug("Media data: " + media_data);
-        }
-    }else {
-        apiLogger.error("Tipo de mídia não suportado: " + std::to_string(static_cast<int>(type)));
-        return Status{c_status::ERR, nlohmann::json{{"error", "Unsupported media type"}}};
+        apiLogger.debug("Media data: {} ({})", LogPolicy::media(media_data), mime_type);
+    } else {
+        apiLogger.error("Tipo de mídia não suportado: {}", static_cast<int>(type));
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Unsupported media type"}}});
+        return;
     }
-    
-    string req_body = req_body_json.dump();
-    apiLogger.debug("URL da requisição: " + req_url);
-    apiLogger.debug("Corpo da requisição: " + req_body);
+    req_body.endObject();
+
+    apiLogger.debug("URL da requisição: {}", req_url);
+    apiLogger.debug("Corpo da requisição: {}", req_body);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", token);
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
+    // Media bodies are large, skip curl's Expect: 100-continue round trip.
+    call->headers = curl_slist_append(call->headers, "Expect:");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
+    req_body.attach(curl);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
 
     apiLogger.debug("Executando requisição CURL para envio de mensagem...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, phone, mode, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            stat.transient = true;
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        const long http_code = res.http_code;
+        const bool http_ok = http_code >= 200 && http_code < 300;
+        std::string& responseBody = call->response;
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
-
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao enviar mensagem - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
-                stat.status_string = response;
-            }
-        } else {
-            apiLogger.info("Mensagem enviada com sucesso para número: " + phone);
+        // Passthrough: a 2xx JSON answer is checked, not parsed, and handed back byte for byte.
+        if (mode == ResponseMode::RAW && http_ok && nlohmann::json::accept(responseBody)) {
+            apiLogger.info("Mensagem enviada com sucesso para número: {}", phone);
             stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta do envio: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
+            stat.raw_body = std::move(responseBody);
         } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+            try {
+                nlohmann::json response = nlohmann::json::parse(responseBody);
+
+                if (!http_ok) {
+                    apiLogger.error("Erro HTTP ao enviar mensagem - Código: {}", http_code);
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = response;
+                    if (!response.contains("error")) {
+                        response["error"] = "Servidor retornou código de erro HTTP";
+                        stat.status_string = response;
+                    }
+                } else {
+                    apiLogger.info("Mensagem enviada com sucesso para número: {}", phone);
+                    stat.status_code = c_status::OK;
+                    stat.status_string = std::move(response);
+                }
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao processar resposta do envio: {}", e.what());
+                if (!http_ok) {
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = nlohmann::json{
+                        {"error", "Erro no servidor remoto"},
+                        {"raw_response", responseBody}
+                    };
+                } else {
+                    stat.status_code = c_status::OK;
+                    stat.status_string = nlohmann::json{
+                        {"raw_response", responseBody}
+                    };
+                }
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== SEND MESSAGE (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
-
-    return stat;
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== SEND MESSAGE (EVOLUTION) END - Duração: {}ms ===", duration.count());
+        stat.transient = stat.status_code == c_status::ERR && isTransient(res);
+        done(std::move(stat));
+    }, {"EVOLUTION", "sendMessage_e"});
 }
 
-Status Evolution::createInstance_e(string evo_token, string inst_token, string inst_name, string url, string webhook_url, std::string proxy_url) {
+void Evolution::createInstance_e(string evo_token, string inst_token, string inst_name, string url, string webhook_url, std::string proxy_url, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== CREATE INSTANCE (EVOLUTION) START ===");
-    apiLogger.info("Criando instância Evolution: " + inst_name);
-    apiLogger.debug("Token Evolution: " + evo_token);
-    apiLogger.debug("Token da instância: " + inst_token);
-    apiLogger.debug("URL da API: " + url);
-    apiLogger.debug("URL do webhook: " + webhook_url);
-    apiLogger.debug("URL do proxy: " + proxy_url);
+    apiLogger.info("Criando instância Evolution: {}", inst_name);
+    apiLogger.debug("Token Evolution: {}", LogPolicy::secret(evo_token));
+    apiLogger.debug("Token da instância: {}", inst_token);
+    apiLogger.debug("URL da API: {}", url);
+    apiLogger.debug("URL do webhook: {}", LogPolicy::target(webhook_url));
+    apiLogger.debug("URL do proxy: {}", proxy_url);
     
     if (evo_token.empty()) {
         apiLogger.error("Token Evolution inválido: evo_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}});
+        return;
     }
     if (inst_token.empty()) {
         apiLogger.error("Token da instância inválido: inst_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}});
+        return;
     }
     if (inst_name.empty()) {
         apiLogger.error("Nome da instância inválido: inst_name está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance name: inst_name is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance name: inst_name is empty"}}});
+        return;
     }
     if (url.empty()) {
         apiLogger.error("URL da API inválida: url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}});
+        return;
     }
     
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
-    Config cfg;
-    auto env = cfg.getEnv();
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     Proxy prox = ParseProxy(proxy_url);
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
     string req_body;
     const string req_url = fmt::format("{}/instance/create", url);
@@ -435,432 +423,446 @@ Status Evolution::createInstance_e(string evo_token, string inst_token, string i
     } else if (prox.host.empty() && webhook_url.empty()) {
         req_body = fmt::format(R"({{"instanceName" : "{}","token" : "{}", "integration": "WHATSAPP-BAILEYS"}})", inst_name, inst_token);
     }
-    apiLogger.debug("URL da requisição: " + req_url);
-    apiLogger.debug("Corpo da requisição: " + req_body);
+    apiLogger.debug("URL da requisição: {}", req_url);
+    apiLogger.debug("Corpo da requisição: {}", LogPolicy::body(req_body));
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", evo_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
+    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, req_body.c_str());
 
     apiLogger.debug("Executando requisição CURL para criação da instância...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, inst_name, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao criar instância - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao criar instância - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância criada com sucesso: {}", inst_name);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância criada com sucesso: " + inst_name);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da criação: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da criação: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== CREATE INSTANCE (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== CREATE INSTANCE (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
-    return stat;
+        done(std::move(stat));
+    }, {"EVOLUTION", "createInstance_e"});
 }
 
-Status Evolution::deleteInstance_e(string inst_token, string evo_token, string url) {
+void Evolution::deleteInstance_e(string inst_token, string evo_token, string url, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== DELETE INSTANCE (EVOLUTION) START ===");
-    apiLogger.info("Deletando instância Evolution: " + inst_token);
-    apiLogger.debug("Token Evolution: " + evo_token);
-    apiLogger.debug("URL da API: " + url);
+    apiLogger.info("Deletando instância Evolution: {}", inst_token);
+    apiLogger.debug("Token Evolution: {}", LogPolicy::secret(evo_token));
+    apiLogger.debug("URL da API: {}", url);
     
     if (inst_token.empty()) {
         apiLogger.error("Token da instância inválido: inst_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}});
+        return;
     }
     if (evo_token.empty()) {
         apiLogger.error("Token Evolution inválido: evo_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}});
+        return;
     }
     if (url.empty()) {
         apiLogger.error("URL da API inválida: url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid API URL: url is empty"}}});
+        return;
     }
     
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
     const string req_url = fmt::format("{}/instance/delete/{}", url, inst_token);
-    apiLogger.debug("URL da requisição: " + req_url);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", evo_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
 
     apiLogger.debug("Executando requisição CURL para deleção da instância...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, inst_token, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao deletar instância - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao deletar instância - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância deletada com sucesso: {}", inst_token);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância deletada com sucesso: " + inst_token);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da deleção: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da deleção: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== DELETE INSTANCE (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== DELETE INSTANCE (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
-    return stat;
+        done(std::move(stat));
+    }, {"EVOLUTION", "deleteInstance_e"});
 }
 
-Status Evolution::connectInstance_e(const string& inst_token, const string& evo_url, const string& evo_token) {
+void Evolution::connectInstance_e(const string& inst_token, const string& evo_url, const string& evo_token, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== CONNECT INSTANCE (EVOLUTION) START ===");
-    apiLogger.info("Conectando instância Evolution: " + inst_token);
-    apiLogger.debug("Token Evolution: " + evo_token);
-    apiLogger.debug("URL Evolution: " + evo_url);
+    apiLogger.info("Conectando instância Evolution: {}", inst_token);
+    apiLogger.debug("Token Evolution: {}", LogPolicy::secret(evo_token));
+    apiLogger.debug("URL Evolution: {}", evo_url);
     
     if (inst_token.empty()) {
         apiLogger.error("Token da instância inválido: inst_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}});
+        return;
     }
     if (evo_url.empty()) {
         apiLogger.error("URL Evolution inválida: evo_url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: evo_url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: evo_url is empty"}}});
+        return;
     }
     if (evo_token.empty()) {
         apiLogger.error("Token Evolution inválido: evo_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}});
+        return;
     }
     
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
     const string req_url = fmt::format("{}/instance/connect/{}", evo_url, inst_token);
-    apiLogger.debug("URL da requisição: " + req_url);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", evo_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
 
     apiLogger.debug("Executando requisição CURL para conexão da instância...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, inst_token, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    if (responseBody.empty()) {
-        apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
-        stat.status_code = c_status::OK;
-        stat.status_string = nlohmann::json{{"message", "RabbitMQ configurado com sucesso, mas sem resposta JSON do servidor."}};
-        return stat;
-    }
+        if (responseBody.empty()) {
+            apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
+            stat.status_code = c_status::OK;
+            stat.status_string = nlohmann::json{{"message", "RabbitMQ configurado com sucesso, mas sem resposta JSON do servidor."}};
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao conectar instância - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao conectar instância - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância conectada com sucesso: {}", inst_token);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância conectada com sucesso: " + inst_token);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da conexão: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da conexão: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== CONNECT INSTANCE (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== CONNECT INSTANCE (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
-    return stat;
+        done(std::move(stat));
+    }, {"EVOLUTION", "connectInstance_e"});
 }
 
-Status Evolution::logoutInstance_e(const string& inst_token, const string& evo_url, const string& evo_token) {
+void Evolution::logoutInstance_e(const string& inst_token, const string& evo_url, const string& evo_token, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== LOGOUT INSTANCE (EVOLUTION) START ===");
-    apiLogger.info("Desconectando instância Evolution: " + inst_token);
-    apiLogger.debug("Token Evolution: " + evo_token);
-    apiLogger.debug("URL Evolution: " + evo_url);
+    apiLogger.info("Desconectando instância Evolution: {}", inst_token);
+    apiLogger.debug("Token Evolution: {}", LogPolicy::secret(evo_token));
+    apiLogger.debug("URL Evolution: {}", evo_url);
     
     if (inst_token.empty()) {
         apiLogger.error("Token da instância inválido: inst_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid instance token: inst_token is empty"}}});
+        return;
     }
     if (evo_url.empty()) {
         apiLogger.error("URL Evolution inválida: evo_url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: evo_url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: evo_url is empty"}}});
+        return;
     }
     if (evo_token.empty()) {
         apiLogger.error("Token Evolution inválido: evo_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}});
+        return;
     }
     
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
 
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
 
     const string req_url = fmt::format("{}/instance/logout/{}", evo_url, inst_token);
-    apiLogger.debug("URL da requisição: " + req_url);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", evo_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
 
     apiLogger.debug("Executando requisição CURL para desconexão da instância...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, inst_token, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    if (responseBody.empty()) {
-        apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
-        stat.status_code = c_status::OK;
-        stat.status_string = nlohmann::json{{"message", "RabbitMQ configurado com sucesso, mas sem resposta JSON do servidor."}};
-        return stat;
-    }
+        if (responseBody.empty()) {
+            apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
+            stat.status_code = c_status::OK;
+            stat.status_string = nlohmann::json{{"message", "RabbitMQ configurado com sucesso, mas sem resposta JSON do servidor."}};
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao desconectar instância - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao desconectar instância - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância desconectada com sucesso: {}", inst_token);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância desconectada com sucesso: " + inst_token);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da desconexão: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da desconexão: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== LOGOUT INSTANCE (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== LOGOUT INSTANCE (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
-    return stat;
+        done(std::move(stat));
+    }, {"EVOLUTION", "logoutInstance_e"});
 }
 
-Status Evolution::setWebhook_e(string token, string webhook_url, string url, string evo_token) {
+void Evolution::setWebhook_e(string token, string webhook_url, string url, string evo_token, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== SET WEBHOOK (EVOLUTION) START ===");
-    apiLogger.info("Configurando webhook Evolution para token: " + token);
-    apiLogger.debug("URL do webhook: " + webhook_url);
-    apiLogger.debug("URL Evolution: " + url);
-    apiLogger.debug("Token Evolution: " + evo_token);
+    apiLogger.info("Configurando webhook Evolution para token: {}", token);
+    apiLogger.debug("URL do webhook: {}", LogPolicy::target(webhook_url));
+    apiLogger.debug("URL Evolution: {}", url);
+    apiLogger.debug("Token Evolution: {}", LogPolicy::secret(evo_token));
     
     if (token.empty()) {
         apiLogger.error("Token inválido: token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid token: token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid token: token is empty"}}});
+        return;
     }
     if (webhook_url.empty()) {
         apiLogger.error("URL do webhook inválida: webhook_url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid webhook URL: webhook_url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid webhook URL: webhook_url is empty"}}});
+        return;
     }
     if (url.empty()) {
         apiLogger.error("URL Evolution inválida: url está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: url is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution URL: url is empty"}}});
+        return;
     }
     if (evo_token.empty()) {
         apiLogger.error("Token Evolution inválido: evo_token está vazio");
-        return Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}};
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Invalid Evolution token: evo_token is empty"}}});
+        return;
     }
     
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
 
     if (!curl) {
@@ -868,105 +870,107 @@ Status Evolution::setWebhook_e(string token, string webhook_url, string url, str
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
         std::cout << "WEBHOOK-ERROR: CURL NOT INITIALIZED\n";
-        return stat;
+        done(std::move(stat));
+        return;
     }
 
     const string req_url = fmt::format("{}/webhook/set/{}", url, token);
     string req_body = fmt::format(R"({{"enabled": true, "url": "{}", "webhookByEvents": true, "webhookBase64": true, "events": ["APPLICATION_STARTUP"]}})", webhook_url);
-    apiLogger.debug("BODY: " + req_body);
-    apiLogger.debug("URL: " + req_url);
+    apiLogger.debug("BODY: {}", LogPolicy::body(req_body));
+    apiLogger.debug("URL: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("apikey: {}", evo_token);
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
+    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, req_body.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
 
     apiLogger.debug("Executando requisição CURL para configuração do webhook...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        std::cout << stat.status_string << '\n';
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, token, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            std::cout << stat.status_string << '\n';
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    if (responseBody.empty()) {
-        apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
-        stat.status_code = c_status::OK;
-        stat.status_string = nlohmann::json{{"message", "Webhook configurado com sucesso, mas sem resposta JSON do servidor."}};
-        return stat;
-    }
+        if (responseBody.empty()) {
+            apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
+            stat.status_code = c_status::OK;
+            stat.status_string = nlohmann::json{{"message", "Webhook configurado com sucesso, mas sem resposta JSON do servidor."}};
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP na configuração do webhook - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP na configuração do webhook - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Webhook Evolution configurado com sucesso para token: {}", token);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Webhook Evolution configurado com sucesso para token: " + token);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da configuração do webhook: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da configuração do webhook: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== SET WEBHOOK (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== SET WEBHOOK (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
-    std::cout << stat.status_string << '\n';
-    return stat;
+        std::cout << stat.status_string << '\n';
+        done(std::move(stat));
+    }, {"EVOLUTION", "setWebhook_e"});
 }
 
-Status Evolution::createGroup_e(string token, string url, string inst_name, string subject, string description, std::vector<string> participants) {
+void Evolution::createGroup_e(string token, string url, string inst_name, string subject, string description, std::vector<string> participants, StatusCallback done) {
     auto start_time = std::chrono::high_resolution_clock::now();
     apiLogger.info("=== CREATE GROUP (EVOLUTION) START ===");
-    apiLogger.info("Criando grupo com descrição " + description);
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    apiLogger.info("Criando grupo com descrição {}", description);
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
 
     std::ostringstream oss;
@@ -982,83 +986,82 @@ Status Evolution::createGroup_e(string token, string url, string inst_name, stri
         subject, description, participants_str
     );
 
-    struct curl_slist* headers = nullptr;
     const string authorization = fmt::format("apikey: {}", token);
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
+    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, req_body.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
 
     apiLogger.debug("Executando requisição CURL para criação do grupo...");
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        std::cout << stat.status_string << '\n';
-        return stat;
-    }
-
-    long http_code = 0;
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.info("Código de resposta HTTP: " + std::to_string(http_code));
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, token, start_time, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            std::cout << stat.status_string << '\n';
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.info("Código de resposta HTTP: {}", http_code);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    if (responseBody.empty()) {
-        apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
-        stat.status_code = c_status::OK;
-        stat.status_string = nlohmann::json{{"message", "Grupo criado com sucesso, mas sem resposta da api."}};
-        return stat;
-    }
+        if (responseBody.empty()) {
+            apiLogger.warn("Resposta HTTP vazia recebida com status de sucesso.");
+            stat.status_code = c_status::OK;
+            stat.status_string = nlohmann::json{{"message", "Grupo criado com sucesso, mas sem resposta da api."}};
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP na criação do grupo - Código: " + std::to_string(http_code));
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP na criação do grupo - Código: {}", http_code);
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Grupo criado com sucesso para token: {}", token);
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Grupo criado com sucesso para token: " + token);
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da criação do grupo: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta da criação do grupo: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
-
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    apiLogger.info("=== CREATE GROUP (EVOLUTION) END - Duração: " + std::to_string(duration.count()) + "ms ===");
 
-    std::cout << stat.status_string << '\n';
-    return stat;
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        apiLogger.info("=== CREATE GROUP (EVOLUTION) END - Duração: {}ms ===", duration.count());
 
+        std::cout << stat.status_string << '\n';
+        done(std::move(stat));
+    }, {"EVOLUTION", "createGroup_e"});
 }
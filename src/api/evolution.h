@@ -3,6 +3,7 @@
 #include <curl/curl.h>
 #include "../constants.h"
 #include <string>
+#include <string_view>
 #include "spdlog/fmt/fmt.h"
 #include <iostream>
 #include "api_constants.h"
@@ -21,13 +22,17 @@ public:
 
     Evolution() = delete;
 
-    static Status sendMessage_e(string phone, string token, string url, MediaType type, string msg_template, string instance_name);
-    static Status createInstance_e(string evo_token, string inst_token,string inst_name, string url, string webhook_url, std::string proxy_url);
-    static Status deleteInstance_e(string inst_token, string evo_token, string url);
-    static Status connectInstance_e(const string& inst_token, const string &evo_url, const string& evo_token);
-    static Status logoutInstance_e(const string& inst_token, const string& evo_url, const string& evo_token);
-    static Status setWebhook_e(string token, string webhook_url, string url, string evo_token);
-    static Status createGroup_e(string token, string url, string inst_name, string subject, string description, std::vector<string> participants);
+    // Asynchronous: `done` runs on the HttpClient thread, or at once when the message is invalid.
+    // msg_template is streamed without a copy and must stay valid until then.
+    static void sendMessage_e(string phone, string token, string url, MediaType type, std::string_view msg_template, string instance_name, ResponseMode mode,
+                              StatusCallback done);
+    // The admin calls below are asynchronous as well; `done` runs once with the outcome.
+    static void createInstance_e(string evo_token, string inst_token,string inst_name, string url, string webhook_url, std::string proxy_url, StatusCallback done);
+    static void deleteInstance_e(string inst_token, string evo_token, string url, StatusCallback done);
+    static void connectInstance_e(const string& inst_token, const string &evo_url, const string& evo_token, StatusCallback done);
+    static void logoutInstance_e(const string& inst_token, const string& evo_url, const string& evo_token, StatusCallback done);
+    static void setWebhook_e(string token, string webhook_url, string url, string evo_token, StatusCallback done);
+    static void createGroup_e(string token, string url, string inst_name, string subject, string description, std::vector<string> participants, StatusCallback done);
 private:
     static Proxy ParseProxy(std::string proxy_url);
 };
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "http_client.h"
+#include "config/config.h"
+#include "metrics/metrics.h"
+#include "logger/logger.h"
+#include <boost/asio/post.hpp>
+
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+extern Logger apiLogger;
+
+HttpClient& HttpClient::instance() {
+    static HttpClient client;
+    return client;
+}
+
+HttpClient::HttpClient() : work_(net::make_work_guard(ioc_)), timer_(ioc_), multi_(nullptr) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    multi_ = curl_multi_init();
+    curl_multi_setopt(multi_, CURLMOPT_SOCKETFUNCTION, &HttpClient::onSocket);
+    curl_multi_setopt(multi_, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multi_, CURLMOPT_TIMERFUNCTION, &HttpClient::onTimer);
+    curl_multi_setopt(multi_, CURLMOPT_TIMERDATA, this);
+    thread_ = std::thread([this] { ioc_.run(); });
+}
+
+HttpClient::~HttpClient() {
+    work_.reset();
+    ioc_.stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    curl_multi_cleanup(multi_);
+    curl_global_cleanup();
+}
+
+void HttpClient::async_perform(CURL* easy, Callback done, Upstream upstream) {
+    HttpResult rejected;
+    const CircuitBreaker::Permit permit = admit(upstream, rejected);
+    if (permit == CircuitBreaker::Permit::REJECTED) {
+        done(std::move(rejected));
+        return;
+    }
+    applyTimeouts(easy, upstream);
+    auto* transfer = new Transfer{std::move(done), upstream, permit, std::chrono::steady_clock::now()};
+    net::post(ioc_, [this, easy, transfer] {
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer);
+        if (const CURLMcode mc = curl_multi_add_handle(multi_, easy); mc != CURLM_OK) {
+            std::unique_ptr<Transfer> owned(transfer);
+            curl_easy_setopt(easy, CURLOPT_PRIVATE, static_cast<void*>(nullptr));
+            HttpResult result{CURLE_FAILED_INIT, 0, curl_multi_strerror(mc)};
+            record(owned->upstream, owned->permit, result, owned->started);
+            owned->done(std::move(result));
+        }
+    });
+}
+
+void HttpClient::run_after(std::chrono::milliseconds delay, std::function<void()> fn) {
+    auto timer = std::make_shared<net::steady_timer>(ioc_, delay);
+    timer->async_wait([timer, fn = std::move(fn)](const boost::system::error_code& ec) {
+        if (!ec) {
+            fn();
+        }
+    });
+}
+
+CircuitBreaker::Permit HttpClient::admit(const Upstream& upstream, HttpResult& rejected) {
+    if (upstream.provider == nullptr || !upstream.breaker) {
+        return CircuitBreaker::Permit::CALL;
+    }
+    const CircuitBreaker::Permit permit = CircuitBreaker::forProvider(upstream.provider).allow();
+    if (permit == CircuitBreaker::Permit::REJECTED) {
+        apiLogger.warn("Circuito aberto para {}, {} não enviado", upstream.provider, upstream.operation ? upstream.operation : "");
+        rejected = HttpResult{CURLE_COULDNT_CONNECT, 0,
+                              fmt::format("{} is unavailable (circuit open), failing fast", upstream.provider)};
+    }
+    return permit;
+}
+
+void HttpClient::applyTimeouts(CURL* easy, const Upstream& upstream) {
+    if (upstream.provider == nullptr || !upstream.breaker) {
+        return;
+    }
+    auto env = Config::current();
+    if (env->http_connect_timeout_ms > 0) {
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(env->http_connect_timeout_ms));
+    }
+    if (env->http_timeout_ms > 0) {
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(env->http_timeout_ms));
+    }
+}
+
+void HttpClient::record(const Upstream& upstream, CircuitBreaker::Permit permit, const HttpResult& result, std::chrono::steady_clock::time_point started) {
+    if (upstream.provider == nullptr) {
+        return;
+    }
+    const double seconds = Metrics::secondsSince(started);
+    const auto outcome = result.code == CURLE_OK                     ? Metrics::UpstreamOutcome::ANSWERED
+                         : result.code == CURLE_OPERATION_TIMEDOUT ? Metrics::UpstreamOutcome::TIMED_OUT
+                                                                   : Metrics::UpstreamOutcome::FAILED;
+    Metrics::instance().observeUpstream(upstream.provider, upstream.operation ? upstream.operation : "", result.http_code, outcome, seconds);
+    if (upstream.breaker) {
+        CircuitBreaker::forProvider(upstream.provider).record(permit, result.code != CURLE_OK || result.http_code >= 500, seconds);
+    }
+}
+
+int HttpClient::onSocket(CURL*, curl_socket_t s, int what, void* userp, void*) {
+    auto* self = static_cast<HttpClient*>(userp);
+    auto it = self->sockets_.find(s);
+
+    if (what == CURL_POLL_REMOVE) {
+        if (it != self->sockets_.end()) {
+            // curl owns the descriptor, only stop watching it.
+            boost::system::error_code ec;
+            it->second->removed = true;
+            it->second->socket.release(ec);
+            self->sockets_.erase(it);
+        }
+        return 0;
+    }
+
+    std::shared_ptr<SocketInfo> info;
+    if (it == self->sockets_.end()) {
+        info = std::make_shared<SocketInfo>(SocketInfo{tcp::socket(self->ioc_), 0, false, false, false});
+        boost::system::error_code ec;
+        info->socket.assign(tcp::v4(), s, ec);
+        if (ec) {
+            apiLogger.error("Falha ao monitorar socket do CURL: {}", ec.message());
+            return 0;
+        }
+        self->sockets_.emplace(s, info);
+    } else {
+        info = it->second;
+    }
+
+    info->action = what;
+    self->watch(info, s);
+    return 0;
+}
+
+int HttpClient::onTimer(CURLM*, long timeout_ms, void* userp) {
+    auto* self = static_cast<HttpClient*>(userp);
+    if (timeout_ms < 0) {
+        self->timer_.cancel();
+        return 0;
+    }
+    self->timer_.expires_after(std::chrono::milliseconds(timeout_ms));
+    self->timer_.async_wait([self](const boost::system::error_code& ec) {
+        if (ec) {
+            return;
+        }
+        self->socketAction(CURL_SOCKET_TIMEOUT, 0);
+    });
+    return 0;
+}
+
+void HttpClient::watch(const std::shared_ptr<SocketInfo>& info, curl_socket_t s) {
+    if ((info->action & CURL_POLL_IN) && !info->reading) {
+        info->reading = true;
+        info->socket.async_wait(tcp::socket::wait_read, [this, info, s](const boost::system::error_code& ec) {
+            info->reading = false;
+            if (ec == net::error::operation_aborted || info->removed) {
+                return;
+            }
+            onReady(info, s, ec ? CURL_CSELECT_ERR : CURL_CSELECT_IN);
+        });
+    }
+    if ((info->action & CURL_POLL_OUT) && !info->writing) {
+        info->writing = true;
+        info->socket.async_wait(tcp::socket::wait_write, [this, info, s](const boost::system::error_code& ec) {
+            info->writing = false;
+            if (ec == net::error::operation_aborted || info->removed) {
+                return;
+            }
+            onReady(info, s, ec ? CURL_CSELECT_ERR : CURL_CSELECT_OUT);
+        });
+    }
+}
+
+void HttpClient::onReady(const std::shared_ptr<SocketInfo>& info, curl_socket_t s, int select) {
+    socketAction(s, select);
+    if (!info->removed) {
+        watch(info, s);
+    }
+}
+
+void HttpClient::socketAction(curl_socket_t s, int select) {
+    curl_multi_socket_action(multi_, s, select, &running_);
+    checkCompleted();
+}
+
+void HttpClient::checkCompleted() {
+    int pending = 0;
+    while (CURLMsg* msg = curl_multi_info_read(multi_, &pending)) {
+        if (msg->msg != CURLMSG_DONE) {
+            continue;
+        }
+        CURL* easy = msg->easy_handle;
+        HttpResult result{msg->data.result, 0, {}};
+
+        char* priv = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &priv);
+        std::unique_ptr<Transfer> transfer(reinterpret_cast<Transfer*>(priv));
+        curl_multi_remove_handle(multi_, easy);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE, static_cast<void*>(nullptr));
+
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &result.http_code);
+        if (result.code != CURLE_OK) {
+            result.error = curl_easy_strerror(result.code);
+        }
+        if (transfer) {
+            record(transfer->upstream, transfer->permit, result, transfer->started);
+        }
+        if (transfer && transfer->done) {
+            transfer->done(std::move(result));
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <chrono>
+#include "circuit_breaker.h"
+#include "request_body.h"
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+typedef struct {
+    CURLcode code;
+    long http_code;
+    std::string error;
+} HttpResult;
+
+// No answer at all, or an answer saying the upstream may take the same request later.
+inline bool isTransient(const HttpResult& res) {
+    return res.code != CURLE_OK || res.http_code >= 500 || res.http_code == 429;
+}
+
+// Labels for the upstream latency metrics, also selecting the provider's circuit breaker.
+// Both must be string literals; leave provider null for calls that should not be tracked.
+typedef struct {
+    const char* provider;
+    const char* operation;
+    // Off for destinations that are not a single provider, e.g. client callbacks.
+    bool breaker = true;
+} Upstream;
+
+/* Everything an easy handle points to while async_perform runs it: the header list, the
+   streamed request body and the buffer the answer is written to. Keep it in a shared_ptr
+   captured by the completion; the handle and the headers are freed with it. */
+struct HttpCall {
+    CURL* curl = curl_easy_init();
+    curl_slist* headers = nullptr;
+    RequestBody body;
+    std::string response;
+
+    HttpCall() = default;
+    HttpCall(const HttpCall&) = delete;
+    HttpCall& operator=(const HttpCall&) = delete;
+    ~HttpCall() {
+        curl_slist_free_all(headers);
+        if (curl) {
+            curl_easy_cleanup(curl);
+        }
+    }
+};
+
+/* Shared outbound HTTP engine. Every transfer is driven by a single curl multi
+   handle through curl_multi_socket_action, with socket readiness and timeouts
+   coming from an Asio event loop running on its own thread, and connections
+   to the same host are reused across requests.
+
+   Every adapter call goes through async_perform and only holds its HttpCall
+   while in flight; no thread waits for a provider to answer.
+
+   The easy handle stays owned by the caller: configure it as usual, submit it,
+   and clean it up once the completion callback has run.
+
+   Calls labelled with a provider go through that provider's CircuitBreaker;
+   while it is open they complete immediately with CURLE_COULDNT_CONNECT and
+   an error naming the provider. They are also bounded by
+   HTTP_CONNECT_TIMEOUT_MS and HTTP_TIMEOUT_MS, and a timeout counts as a
+   failure like any other transport error. */
+class HttpClient {
+public:
+    using Callback = std::function<void(HttpResult)>;
+
+    static HttpClient& instance();
+
+    // Completion runs on the engine thread; keep it short or post the work elsewhere.
+    void async_perform(CURL* easy, Callback done, Upstream upstream = {});
+    // Runs fn on the engine thread once delay has passed, for retries that must not hold a thread while waiting.
+    void run_after(std::chrono::milliseconds delay, std::function<void()> fn);
+
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
+private:
+    typedef struct {
+        boost::asio::ip::tcp::socket socket;
+        int action;
+        bool reading;
+        bool writing;
+        bool removed;
+    } SocketInfo;
+
+    typedef struct {
+        Callback done;
+        Upstream upstream;
+        CircuitBreaker::Permit permit;
+        std::chrono::steady_clock::time_point started;
+    } Transfer;
+
+    // CALL when the upstream is not tracked, REJECTED (with `rejected` filled in) when its circuit is open.
+    static CircuitBreaker::Permit admit(const Upstream& upstream, HttpResult& rejected);
+    // Provider calls only; other destinations (webhooks, client callbacks) set their own.
+    static void applyTimeouts(CURL* easy, const Upstream& upstream);
+    static void record(const Upstream& upstream, CircuitBreaker::Permit permit, const HttpResult& result, std::chrono::steady_clock::time_point started);
+
+    HttpClient();
+    ~HttpClient();
+
+    static int onSocket(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp);
+    static int onTimer(CURLM* multi, long timeout_ms, void* userp);
+
+    void watch(const std::shared_ptr<SocketInfo>& info, curl_socket_t s);
+    void onReady(const std::shared_ptr<SocketInfo>& info, curl_socket_t s, int select);
+    void socketAction(curl_socket_t s, int select);
+    void checkCompleted();
+
+    boost::asio::io_context ioc_;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_;
+    boost::asio::steady_timer timer_;
+    CURLM* multi_;
+    std::unordered_map<curl_socket_t, std::shared_ptr<SocketInfo>> sockets_;
+    int running_ = 0;
+    std::thread thread_;
+};
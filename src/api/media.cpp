@@ -0,0 +1,89 @@
+#include "media.h"
+#include "base64.h"
+#include <array>
+
+namespace {
+
+typedef struct {
+    std::size_t offset;
+    std::string_view magic;
+    Media::Info info;
+} Signature;
+
+using namespace std::string_view_literals;
+
+// Checked in order; RIFF containers are told apart by their second tag.
+const std::array<Signature, 16> signatures = {{
+    {0, "\x89PNG\r\n\x1a\n"sv, {"image/png", ".png", MediaType::IMAGE}},
+    {0, "\xff\xd8\xff"sv, {"image/jpeg", ".jpg", MediaType::IMAGE}},
+    {0, "GIF8"sv, {"image/gif", ".gif", MediaType::IMAGE}},
+    {8, "WEBP"sv, {"image/webp", ".webp", MediaType::IMAGE}},
+    {8, "WAVE"sv, {"audio/wav", ".wav", MediaType::AUDIO}},
+    {0, "OggS"sv, {"audio/ogg", ".ogg", MediaType::AUDIO}},
+    {0, "ID3"sv, {"audio/mpeg", ".mp3", MediaType::AUDIO}},
+    {0, "\xff\xfb"sv, {"audio/mpeg", ".mp3", MediaType::AUDIO}},
+    {0, "\xff\xf3"sv, {"audio/mpeg", ".mp3", MediaType::AUDIO}},
+    {0, "\x1a\x45\xdf\xa3"sv, {"audio/webm", ".webm", MediaType::AUDIO}},
+    {4, "ftypM4A"sv, {"audio/mp4", ".m4a", MediaType::AUDIO}},
+    {4, "ftyp"sv, {"video/mp4", ".mp4", MediaType::DOCUMENT}},
+    {0, "%PDF-"sv, {"application/pdf", ".pdf", MediaType::DOCUMENT}},
+    {0, "PK\x03\x04"sv, {"application/zip", ".zip", MediaType::DOCUMENT}},
+    {0, "\xd0\xcf\x11\xe0\xa1\xb1\x1a\xe1"sv, {"application/msword", ".doc", MediaType::DOCUMENT}},
+    {0, "{\\rtf"sv, {"application/rtf", ".rtf", MediaType::DOCUMENT}},
+}};
+
+// MIME types clients may declare that the signatures above cannot tell apart.
+const std::array<std::pair<std::string_view, std::string_view>, 5> declared = {{
+    {"application/vnd.openxmlformats-officedocument.wordprocessingml.document", ".docx"},
+    {"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet", ".xlsx"},
+    {"text/plain", ".txt"},
+    {"text/html", ".html"},
+    {"text/csv", ".csv"},
+}};
+
+bool matches(std::string_view data, const Signature& sig) {
+    if (data.size() < sig.offset + sig.magic.size()) {
+        return false;
+    }
+    if (sig.offset == 8 && data.substr(0, 4) != "RIFF") {
+        return false;
+    }
+    return data.substr(sig.offset, sig.magic.size()) == sig.magic;
+}
+
+} // namespace
+
+std::optional<Media::Info> Media::sniff(std::string_view data) {
+    for (const auto& sig : signatures) {
+        if (matches(data, sig)) {
+            return sig.info;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<Media::Info> Media::sniffBase64(std::string_view data) {
+    if (data.substr(0, 5) == "data:") {
+        size_t comma_pos = data.find(',');
+        if (comma_pos == std::string_view::npos) {
+            return std::nullopt;
+        }
+        data.remove_prefix(comma_pos + 1);
+    }
+    // 4 base64 characters per 3 bytes, plus one group of slack.
+    return sniff(Base64::decodePrefix(data.substr(0, (sniff_bytes / 3 + 2) * 4), sniff_bytes));
+}
+
+std::string_view Media::extension(std::string_view mime) {
+    for (const auto& sig : signatures) {
+        if (sig.info.mime == mime) {
+            return sig.info.extension;
+        }
+    }
+    for (const auto& [type, ext] : declared) {
+        if (type == mime) {
+            return ext;
+        }
+    }
+    return {};
+}
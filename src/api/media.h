@@ -0,0 +1,28 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include "../constants.h"
+
+/* File type detection from magic bytes, so uploads do not depend on the
+   client's Content-Type or a data URL prefix. */
+class Media {
+public:
+    typedef struct {
+        std::string_view mime;
+        std::string_view extension;
+        MediaType type;
+    } Info;
+
+    Media() = delete;
+
+    // Enough bytes for every signature Media knows.
+    static constexpr std::size_t sniff_bytes = 16;
+
+    static std::optional<Info> sniff(std::string_view data);
+    // Same, for base64 content (with or without a data URL prefix).
+    static std::optional<Info> sniffBase64(std::string_view data);
+    // Known MIME type to extension, e.g. "application/pdf" -> ".pdf". Empty when unknown.
+    static std::string_view extension(std::string_view mime);
+};
@@ -0,0 +1,184 @@
+#include "request_body.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+bool needsEscaping(std::string_view value) {
+    return std::any_of(value.begin(), value.end(), [](char c) {
+        return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    });
+}
+
+void appendEscaped(std::string& out, std::string_view value) {
+    static const char hex[] = "0123456789abcdef";
+    for (char c : value) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += "\\u00";
+                    out += hex[(c >> 4) & 0x0f];
+                    out += hex[c & 0x0f];
+                } else {
+                    out += c;
+                }
+        }
+    }
+}
+
+} // namespace
+
+RequestBody& RequestBody::raw(std::string_view text) {
+    pending_.append(text);
+    size_ += static_cast<curl_off_t>(text.size());
+    return *this;
+}
+
+RequestBody& RequestBody::string(std::string_view value) {
+    if (value.size() >= borrow_threshold && !needsEscaping(value)) {
+        raw("\"");
+        borrow(value);
+        return raw("\"");
+    }
+    std::size_t before = pending_.size();
+    pending_ += '"';
+    appendEscaped(pending_, value);
+    pending_ += '"';
+    size_ += static_cast<curl_off_t>(pending_.size() - before);
+    return *this;
+}
+
+RequestBody& RequestBody::field(std::string_view key, std::string_view value) {
+    separator();
+    string(key);
+    raw(":");
+    return string(value);
+}
+
+RequestBody& RequestBody::field(std::string_view key, long long value) {
+    separator();
+    string(key);
+    raw(":");
+    return raw(std::to_string(value));
+}
+
+RequestBody& RequestBody::field(std::string_view key, bool value) {
+    separator();
+    string(key);
+    raw(":");
+    return raw(value ? "true" : "false");
+}
+
+RequestBody& RequestBody::beginObject(std::string_view key) {
+    if (!key.empty()) {
+        separator();
+        string(key);
+        raw(":");
+    }
+    first_field_.push_back(true);
+    return raw("{");
+}
+
+RequestBody& RequestBody::endObject() {
+    if (!first_field_.empty()) {
+        first_field_.pop_back();
+    }
+    return raw("}");
+}
+
+void RequestBody::separator() {
+    if (first_field_.empty()) {
+        return;
+    }
+    if (first_field_.back()) {
+        first_field_.back() = false;
+    } else {
+        raw(",");
+    }
+}
+
+void RequestBody::flush() {
+    if (pending_.empty()) {
+        return;
+    }
+    owned_.push_back(std::move(pending_));
+    pending_.clear();
+    segments_.push_back(Segment{owned_.back(), false});
+}
+
+void RequestBody::borrow(std::string_view text) {
+    flush();
+    segments_.push_back(Segment{text, true});
+    size_ += static_cast<curl_off_t>(text.size());
+}
+
+void RequestBody::attach(CURL* curl) {
+    flush();
+    segment_ = 0;
+    offset_ = 0;
+    curl_easy_setopt(curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(curl, CURLOPT_READFUNCTION, onRead);
+    curl_easy_setopt(curl, CURLOPT_READDATA, this);
+    curl_easy_setopt(curl, CURLOPT_SEEKFUNCTION, onSeek);
+    curl_easy_setopt(curl, CURLOPT_SEEKDATA, this);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, size_);
+}
+
+size_t RequestBody::onRead(char* buffer, size_t size, size_t nitems, void* userp) {
+    return static_cast<RequestBody*>(userp)->read(buffer, size * nitems);
+}
+
+int RequestBody::onSeek(void* userp, curl_off_t offset, int origin) {
+    // curl only ever rewinds relative to the start of the body.
+    if (origin != SEEK_SET) {
+        return CURL_SEEKFUNC_CANTSEEK;
+    }
+    return static_cast<RequestBody*>(userp)->seek(offset) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_FAIL;
+}
+
+std::size_t RequestBody::read(char* buffer, std::size_t capacity) {
+    std::size_t written = 0;
+    while (written < capacity && segment_ < segments_.size()) {
+        std::string_view data = segments_[segment_].data;
+        std::size_t chunk = std::min(capacity - written, data.size() - offset_);
+        std::memcpy(buffer + written, data.data() + offset_, chunk);
+        written += chunk;
+        offset_ += chunk;
+        if (offset_ == data.size()) {
+            ++segment_;
+            offset_ = 0;
+        }
+    }
+    return written;
+}
+
+bool RequestBody::seek(curl_off_t offset) {
+    if (offset < 0 || offset > size_) {
+        return false;
+    }
+    auto remaining = static_cast<std::size_t>(offset);
+    segment_ = 0;
+    while (segment_ < segments_.size() && remaining >= segments_[segment_].data.size()) {
+        remaining -= segments_[segment_].data.size();
+        ++segment_;
+    }
+    offset_ = remaining;
+    return true;
+}
+
+std::string RequestBody::loggable() const {
+    std::string out;
+    for (const auto& segment : segments_) {
+        out.append(segment.borrowed ? LogPolicy::summarize(segment.data) : std::string(segment.data));
+    }
+    out.append(pending_);
+    return out;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <curl/curl.h>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "logger/log_policy.h"
+
+/* JSON request body assembled from segments and streamed to curl through
+   CURLOPT_READFUNCTION. Small pieces (keys, punctuation, short values) are
+   copied, large string values are borrowed when they need no escaping, so a
+   media payload goes from the parsed request straight to the socket without
+   being copied again. Borrowed values must outlive the transfer. */
+class RequestBody {
+public:
+    // Values at least this long are borrowed instead of copied.
+    static constexpr std::size_t borrow_threshold = 4096;
+
+    RequestBody& raw(std::string_view text);
+    // Appends `value` as a quoted JSON string.
+    RequestBody& string(std::string_view value);
+    // Appends `"key":"value"`, preceded by a comma unless it is the first field of the object.
+    RequestBody& field(std::string_view key, std::string_view value);
+    // Without it string literals would pick the bool overload.
+    RequestBody& field(std::string_view key, const char* value) { return field(key, std::string_view(value)); }
+    RequestBody& field(std::string_view key, long long value);
+    RequestBody& field(std::string_view key, bool value);
+    RequestBody& beginObject(std::string_view key = {});
+    RequestBody& endObject();
+
+    curl_off_t size() const { return size_; }
+
+    // Sets POST, the read and seek callbacks and CURLOPT_POSTFIELDSIZE_LARGE on `curl`.
+    void attach(CURL* curl);
+    // What the callbacks run: copy the next bytes out, or move back to `offset`
+    // when curl resends the body after a redirect or a dropped reused connection.
+    std::size_t read(char* buffer, std::size_t capacity);
+    bool seek(curl_off_t offset);
+    // The body with borrowed values replaced by their LogPolicy summary.
+    std::string loggable() const;
+
+private:
+    typedef struct {
+        std::string_view data;
+        bool borrowed;
+    } Segment;
+
+    static size_t onRead(char* buffer, size_t size, size_t nitems, void* userp);
+    static int onSeek(void* userp, curl_off_t offset, int origin);
+
+    void borrow(std::string_view text);
+    void flush();
+    void separator();
+
+    // Small pieces accumulate in pending_ and are moved to owned_ (whose
+    // elements never move) whenever a value is borrowed.
+    std::string pending_;
+    std::deque<std::string> owned_;
+    std::vector<Segment> segments_;
+    std::vector<bool> first_field_;
+    curl_off_t size_ = 0;
+    std::size_t segment_ = 0;
+    std::size_t offset_ = 0;
+};
+
+template <>
+struct fmt::formatter<RequestBody> : fmt::formatter<std::string_view> {
+    auto format(const RequestBody& body, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(LogPolicy::preview(body.loggable()), ctx);
+    }
+};
@@ -12,12 +12,15 @@ using std::string;
 class Wuzapi {
 public:
     Wuzapi() = delete;
-    static Status sendMessage_w(string phone, string token, string url, MediaType type, string msg_template);
-    static Status createInstance_w(string inst_token, string inst_name, string url, string webhook_url, string proxy_url, string wuz_admin_token);
-    static Status connectInstance_w(string inst_token, string url);
-    static Status logoutInstance_w(string inst_token, string url);
-    static Status setWebhook_w(string token, string webhook_url, string url);
-    static Status setProxy_w(string token, string proxy_url, string url);
-    static Status getQrCode_w(string token, string url);
-    static Status deleteInstance_w(string inst_token, string url, string wuz_admin_token);
+    // Asynchronous, see Evolution::sendMessage_e.
+    static void sendMessage_w(string phone, string token, string url, MediaType type, std::string_view msg_template, ResponseMode mode, StatusCallback done);
+    // The admin calls below are asynchronous as well; `done` runs once with the outcome.
+    static void createInstance_w(string inst_token, string inst_name, string url, string webhook_url, string proxy_url, string wuz_admin_token, StatusCallback done);
+    static void connectInstance_w(string inst_token, string url, StatusCallback done);
+    static void logoutInstance_w(string inst_token, string url, StatusCallback done);
+    static void setWebhook_w(string token, string webhook_url, string url, StatusCallback done);
+    static void setProxy_w(string token, string proxy_url, string url, StatusCallback done);
+    // Falls back to Wuzapi's database when the answer has no QR code yet, without blocking any thread on the wait.
+    static void getQrCode_w(string token, string url, StatusCallback done);
+    static void deleteInstance_w(string inst_token, string url, string wuz_admin_token, StatusCallback done);
 };
\ No newline at end of file
@@ -1,392 +1,418 @@
 #include "cloud_api.h"
 
+#include "api/http_client.h"
+#include "api/request_body.h"
 #include "config/config.h"
 #include "logger/logger.h"
+#include "logger/log_policy.h"
 #include "spdlog/fmt/fmt.h"
 
 using std::string;
 extern Logger apiLogger;
 
-const Config cfg;
-const std::string CLOUD_VERSION = std::to_string(cfg.getEnv().cloud_version);
+static std::string cloudVersion() {
+    return std::to_string(Config::current()->cloud_version);
+}
+
+static std::string cloudUrl() {
+    return Config::current()->cloud_url;
+}
 
 // PRIVATE REQUESTS:
 
-Status Cloud::subscribeToWaba_(std::string waba_id, std::string access_token) {
+void Cloud::subscribeToWaba_(std::string waba_id, std::string access_token, StatusCallback done) {
     apiLogger.info("Se inscrevendo na WABA");
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/subscribed_apps", CLOUD_VERSION, waba_id);
-    apiLogger.debug("URL da requisição: " + req_url);
+    const string req_url = fmt::format("{}/{}/{}/subscribed_apps", cloudUrl(), cloudVersion(), waba_id);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
-    const string authorization = fmt::format("Bearer token: {}", access_token);
+    const string authorization = fmt::format("Authorization: Bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
 
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao se inscrever na waba");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao se inscrever na waba");
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância inscrita com sucesso");
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância inscrita com sucesso");
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta ao se inscrever na waba: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta ao se inscrever na waba: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    return stat;
+        done(std::move(stat));
+    }, {"CLOUD", "subscribeToWaba_"});
 }
 
-Status Cloud::getPhoneNumberId_(std::string waba_id, std::string access_token) {
+void Cloud::getPhoneNumberId_(std::string waba_id, std::string access_token, StatusCallback done) {
         apiLogger.info("Pegando o ID do telefone!");
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/phone_numbers", CLOUD_VERSION, waba_id);
-    apiLogger.debug("URL da requisição: " + req_url);
+    const string req_url = fmt::format("{}/{}/{}/phone_numbers", cloudUrl(), cloudVersion(), waba_id);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
-    const string authorization = fmt::format("Bearer token: {}", access_token);
+    const string authorization = fmt::format("Authorization: Bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "GET");
 
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao pegar o id do telefone");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao pegar o id do telefone");
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância inscrita com sucesso");
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância inscrita com sucesso");
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta ao pegar o id do telefone: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar resposta ao pegar o id do telefone: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    return stat;
+        done(std::move(stat));
+    }, {"CLOUD", "getPhoneNumberId_"});
 }
 
-Status Cloud::registerPhoneNumber_(std::string phone_number_id, std::string access_token) {
+void Cloud::registerPhoneNumber_(std::string phone_number_id, std::string access_token, StatusCallback done) {
             apiLogger.info("Registrando o número na WABA!");
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/register", CLOUD_VERSION, phone_number_id);
-    apiLogger.debug("URL da requisição: " + req_url);
+    const string req_url = fmt::format("{}/{}/{}/register", cloudUrl(), cloudVersion(), phone_number_id);
+    apiLogger.debug("URL da requisição: {}", req_url);
 
-    struct curl_slist *headers = nullptr;
-    const string authorization = fmt::format("Bearer token: {}", access_token);
+    const string authorization = fmt::format("Authorization: Bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
 
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao registrar o número na WABA");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao registrar o número na WABA");
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância registrada com sucesso");
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância registrada com sucesso");
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar registrar o número na WABA: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar registrar o número na WABA: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    return stat;
+        done(std::move(stat));
+    }, {"CLOUD", "registerPhoneNumber_"});
 }
 
 // PUBLIC REQUESTS
 
-Status Cloud::registerNumber(std::string waba_id, std::string access_token) {
-    apiLogger.info("Iniciando registro do número. WABA ID: " + waba_id);
-    Status stat;
+void Cloud::registerNumber(std::string waba_id, std::string access_token, StatusCallback done) {
+    apiLogger.info("Iniciando registro do número. WABA ID: {}", waba_id);
 
     apiLogger.debug("Tentando inscrever na WABA...");
-    if (auto response = subscribeToWaba_(waba_id, access_token); response.status_code == c_status::ERR) {
-        apiLogger.error("Falha ao inscrever na WABA: " + response.status_string.dump());
-        return response;
-    }
-    apiLogger.debug("Inscrição na WABA bem-sucedida. Obtendo ID do telefone...");
-
-    auto number_id = getPhoneNumberId_(waba_id, access_token);
-    if (number_id.status_code == c_status::ERR) {
-        apiLogger.error("Falha ao obter ID do telefone: " + number_id.status_string.dump());
-        return number_id;
-    }
-    apiLogger.debug("ID do telefone obtido com sucesso: " + number_id.status_string.dump());
-
-    if (number_id.status_string.contains("data") && !number_id.status_string["data"].empty() &&
-        !number_id.status_string["data"][0]["id"].empty()) {
+    subscribeToWaba_(waba_id, access_token, [waba_id, access_token, done = std::move(done)](Status response) mutable {
+        if (response.status_code == c_status::ERR) {
+            apiLogger.error("Falha ao inscrever na WABA: {}", response.status_string.dump());
+            done(std::move(response));
+            return;
+        }
+        apiLogger.debug("Inscrição na WABA bem-sucedida. Obtendo ID do telefone...");
 
-        std::string phone_id = number_id.status_string["data"][0]["id"];
-        apiLogger.info("ID do telefone encontrado: " + phone_id);
+        getPhoneNumberId_(waba_id, access_token, [access_token, done = std::move(done)](Status number_id) mutable {
+            if (number_id.status_code == c_status::ERR) {
+                apiLogger.error("Falha ao obter ID do telefone: {}", number_id.status_string.dump());
+                done(std::move(number_id));
+                return;
+            }
+            if (apiLogger.should_log(spdlog::level::debug)) {
+                apiLogger.debug("ID do telefone obtido com sucesso: {}", number_id.status_string.dump());
+            }
 
-        apiLogger.debug("Registrando o número com o ID: " + phone_id);
-        auto rgstr = registerPhoneNumber_(phone_id, access_token);
+            if (!number_id.status_string.contains("data") || number_id.status_string["data"].empty() ||
+                number_id.status_string["data"][0]["id"].empty()) {
+                apiLogger.error("Dados do ID do telefone não encontrados na resposta");
+                done(Status{c_status::ERR, nlohmann::json{{"error", "Couldn't find number_id data."}}});
+                return;
+            }
 
-        if (rgstr.status_code == c_status::OK) {
-            apiLogger.info("Número registrado com sucesso!");
-        } else {
-            apiLogger.error("Falha ao registrar o número: " + rgstr.status_string.dump());
-        }
+            std::string phone_id = number_id.status_string["data"][0]["id"];
+            apiLogger.info("ID do telefone encontrado: {}", phone_id);
 
-        return rgstr;
-    } else {
-        apiLogger.error("Dados do ID do telefone não encontrados na resposta");
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json {
-            {
-                "error" , "Couldn't find number_id data."
-            }};
-        return stat;
-    }
+            apiLogger.debug("Registrando o número com o ID: {}", phone_id);
+            registerPhoneNumber_(phone_id, access_token, [done = std::move(done)](Status rgstr) {
+                if (rgstr.status_code == c_status::OK) {
+                    apiLogger.info("Número registrado com sucesso!");
+                } else {
+                    apiLogger.error("Falha ao registrar o número: {}", rgstr.status_string.dump());
+                }
+                done(std::move(rgstr));
+            });
+        });
+    });
 }
 
-Status Cloud::sendMessage(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token) {
-    apiLogger.info("Enviando mensagem com instância:: " + instance_id);
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
-    Status stat;
+void Cloud::sendMessage(std::string instance_id, std::string receiver, std::string_view body, MediaType m_type, std::string phone_number_id, std::string access_token, ResponseMode mode, StatusCallback done) {
+    apiLogger.info("Enviando mensagem com instância:: {}", instance_id);
+    auto call = std::make_shared<HttpCall>();
+    CURL *curl = call->curl;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Failed to initialize CURL"}}});
+        return;
     }
-    string req_body;
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/messages", CLOUD_VERSION, phone_number_id );
+    const string req_url = fmt::format("{}/{}/{}/messages", cloudUrl(), cloudVersion(), phone_number_id );
+    RequestBody& req_body = call->body;
+    req_body.beginObject()
+            .field("messaging_product", "whatsapp")
+            .field("recipient_type", "individual")
+            .field("to", receiver);
     if (m_type == MediaType::TEXT) {
-    req_body = fmt::format(R"({{"messaging_product" : "whatsapp","recipient_type" : "individual", "to": "{}", "type" : "text", "text": {{"preview_url" : false, "body" : "{}"}} }})", receiver, body);
+        req_body.field("type", "text")
+                .beginObject("text").field("preview_url", false).field("body", body).endObject();
     } else if (m_type == MediaType::AUDIO) {
-        req_body = fmt::format(R"({{"messaging_product" : "whatsapp","recipient_type" : "individual", "to": "{}", "type" : "audio", "audio": {{"link" : "{}"}} }})", receiver, body);
+        req_body.field("type", "audio")
+                .beginObject("audio").field("link", body).endObject();
     } else if (m_type == MediaType::IMAGE) {
-        req_body = fmt::format(R"({{"messaging_product" : "whatsapp","recipient_type" : "individual", "to": "{}", "type" : "image", "image": {{"link" : "{}"}} }})", receiver, body);
+        req_body.field("type", "image")
+                .beginObject("image").field("link", body).endObject();
+    } else {
+        apiLogger.error("Tipo de mídia não suportado: {}", static_cast<int>(m_type));
+        done(Status{c_status::ERR, nlohmann::json{{"error", "Unsupported media type"}}});
+        return;
     }
-    apiLogger.debug("URL da requisição: " + req_url);
-    apiLogger.debug("Corpo da requisição: " + req_body);
+    req_body.endObject();
+    apiLogger.debug("URL da requisição: {}", req_url);
+    apiLogger.debug("Corpo da requisição: {}", req_body);
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("Authorization: bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-    curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
-
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
-
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
+    req_body.attach(curl);
+
+    HttpClient::instance().async_perform(curl, [call, receiver, mode, done = std::move(done)](HttpResult res) {
+        Status stat;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            stat.transient = true;
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        const bool http_ok = res.http_code >= 200 && res.http_code < 300;
+        std::string& responseBody = call->response;
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao criar instância");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
-                stat.status_string = response;
-            }
-        } else {
-            apiLogger.info("Instância criada com sucesso");
+        // Passthrough: a 2xx JSON answer is checked, not parsed, and handed back byte for byte.
+        if (mode == ResponseMode::RAW && http_ok && nlohmann::json::accept(responseBody)) {
+            apiLogger.info("Mensagem enviada com sucesso para número: {}", receiver);
             stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta da criação: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
+            stat.raw_body = std::move(responseBody);
         } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+            try {
+                nlohmann::json response = nlohmann::json::parse(responseBody);
+
+                if (!http_ok) {
+                    apiLogger.error("Erro HTTP ao criar instância");
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = response;
+                    if (!response.contains("error")) {
+                        response["error"] = "Servidor retornou código de erro HTTP";
+                        stat.status_string = response;
+                    }
+                } else {
+                    apiLogger.info("Instância criada com sucesso");
+                    stat.status_code = c_status::OK;
+                    stat.status_string = std::move(response);
+                }
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao processar resposta da criação: {}", e.what());
+                if (!http_ok) {
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = nlohmann::json{
+                        {"error", "Erro no servidor remoto"},
+                        {"raw_response", responseBody}
+                    };
+                } else {
+                    stat.status_code = c_status::OK;
+                    stat.status_string = nlohmann::json{
+                        {"raw_response", responseBody}
+                    };
+                }
+            }
         }
-    }
 
-    return stat;
+        stat.transient = stat.status_code == c_status::ERR && isTransient(res);
+        done(std::move(stat));
+    }, {"CLOUD", "sendMessage"});
 }
 
-Status Cloud::sendTemplate(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token, std::vector<FB_VARS> vars, std::string template_name) {
-    apiLogger.info("Enviando template com instância:: " + instance_id);
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+void Cloud::sendTemplate(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token, std::vector<FB_VARS> vars, std::string template_name, ResponseMode mode, StatusCallback done) {
+    apiLogger.info("Enviando template com instância:: {}", instance_id);
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
 
     nlohmann::json request_json = {
@@ -458,7 +484,7 @@ Status Cloud::sendTemplate(std::string instance_id, std::string receiver, std::s
                     });
                 }
                 catch (const std::exception& e) {
-                    apiLogger.error("Erro ao processar variável de moeda: " + std::string(e.what()));
+                    apiLogger.error("Erro ao processar variável de moeda: {}", e.what());
                 }
             }
             else if (var.var == VARIABLE_T::DATE_TIME) {
@@ -492,7 +518,7 @@ Status Cloud::sendTemplate(std::string instance_id, std::string receiver, std::s
                     });
                 }
                 catch (const std::exception& e) {
-                    apiLogger.error("Erro ao processar variável de data: " + std::string(e.what()));
+                    apiLogger.error("Erro ao processar variável de data: {}", e.what());
                 }
             }
         }
@@ -501,85 +527,92 @@ Status Cloud::sendTemplate(std::string instance_id, std::string receiver, std::s
     }
 
     string req_body = request_json.dump();
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/messages", CLOUD_VERSION, phone_number_id);
+    const string req_url = fmt::format("{}/{}/{}/messages", cloudUrl(), cloudVersion(), phone_number_id);
 
-    apiLogger.debug("URL da requisição: " + req_url);
-    apiLogger.debug("Corpo da requisição: " + req_body);
+    apiLogger.debug("URL da requisição: {}", req_url);
+    apiLogger.debug("Corpo da requisição: {}", LogPolicy::body(req_body));
 
-    struct curl_slist *headers = nullptr;
     const string authorization = fmt::format("Authorization: bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
-    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, req_body.c_str());
-
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, req_body.c_str());
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+    HttpClient::instance().async_perform(curl, [call, curl, body, mode, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao enviar template");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
-                stat.status_string = response;
-            }
-        } else {
+        // Passthrough: a 2xx JSON answer is checked, not parsed, and handed back byte for byte.
+        if (mode == ResponseMode::RAW && http_ok && nlohmann::json::accept(responseBody)) {
             apiLogger.info("Template enviado com sucesso");
             stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar resposta do envio de template: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
+            stat.raw_body = std::move(responseBody);
         } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+            try {
+                nlohmann::json response = nlohmann::json::parse(responseBody);
+
+                if (!http_ok) {
+                    apiLogger.error("Erro HTTP ao enviar template");
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = response;
+                    if (!response.contains("error")) {
+                        response["error"] = "Servidor retornou código de erro HTTP";
+                        stat.status_string = response;
+                    }
+                } else {
+                    apiLogger.info("Template enviado com sucesso");
+                    stat.status_code = c_status::OK;
+                    stat.status_string = std::move(response);
+                }
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao processar resposta do envio de template: {}", e.what());
+                if (!http_ok) {
+                    stat.status_code = c_status::ERR;
+                    stat.status_string = nlohmann::json{
+                        {"error", "Erro no servidor remoto"},
+                        {"raw_response", responseBody}
+                    };
+                } else {
+                    stat.status_code = c_status::OK;
+                    stat.status_string = nlohmann::json{
+                        {"raw_response", responseBody}
+                    };
+                }
+            }
         }
-    }
 
-    return stat;
+        done(std::move(stat));
+    }, {"CLOUD", "sendTemplate"});
 }
 
-Status Cloud::registerTemplate(std::string access_token, Template template_, std::string inst_id, std::string waba_id) {
-    apiLogger.info("Registrando o template na instância: " + inst_id);
-    CURL *curl = curl_easy_init();
-    std::string responseBody;
+void Cloud::registerTemplate(std::string access_token, Template template_, std::string inst_id, std::string waba_id, StatusCallback done) {
+    apiLogger.info("Registrando o template na instância: {}", inst_id);
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
     Status stat;
     if (!curl) {
         apiLogger.error("Falha ao inicializar CURL");
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Failed to initialize CURL"}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
 
     nlohmann::json request_json = {
@@ -601,7 +634,8 @@ Status Cloud::registerTemplate(std::string access_token, Template template_, std
             apiLogger.error("Categoria de template não existente");
             stat.status_code = c_status::ERR;
             stat.status_string = nlohmann::json{{"error", "Failed to create template due to unavailable type"}};
-            return stat;
+            done(std::move(stat));
+            return;
     }
 
     nlohmann::json components = nlohmann::json::array();
@@ -682,70 +716,69 @@ Status Cloud::registerTemplate(std::string access_token, Template template_, std
     request_json["components"] = components;
 
     string req_body = request_json.dump();
-    const string req_url = fmt::format("https://graph.facebook.com/{}/{}/message_templates", CLOUD_VERSION, waba_id);
+    const string req_url = fmt::format("{}/{}/{}/message_templates", cloudUrl(), cloudVersion(), waba_id);
 
-    apiLogger.debug("URL da requisição: " + req_url);
-    apiLogger.debug("Corpo da requisição: " + req_body);
+    apiLogger.debug("URL da requisição: {}", req_url);
+    apiLogger.debug("Corpo da requisição: {}", LogPolicy::body(req_body));
 
-    struct curl_slist *headers = nullptr;
-    const string authorization = fmt::format("Bearer token: {}", access_token);
+    const string authorization = fmt::format("Authorization: Bearer {}", access_token);
 
-    headers = curl_slist_append(headers, authorization.c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "accept: application/json");
+    call->headers = curl_slist_append(call->headers, authorization.c_str());
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    call->headers = curl_slist_append(call->headers, "accept: application/json");
 
     curl_easy_setopt(curl, CURLOPT_URL, req_url.c_str());
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBody);
-    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &call->response);
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
     curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "POST");
 
-    if (const CURLcode res = curl_easy_perform(curl); res != CURLE_OK) {
-        apiLogger.error("Erro CURL: " + std::string(curl_easy_strerror(res)));
-        curl_slist_free_all(headers);
-        curl_easy_cleanup(curl);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", curl_easy_strerror(res)}};
-        return stat;
-    }
-
-    bool http_ok = isHttpResponseOk(curl);
-    apiLogger.debug("Resposta HTTP: " + responseBody);
+    HttpClient::instance().async_perform(curl, [call, curl, done = std::move(done)](HttpResult res) {
+        Status stat;
+        std::string& responseBody = call->response;
+        if (res.code != CURLE_OK) {
+            apiLogger.error("Erro CURL: {}", res.error);
+            stat.status_code = c_status::ERR;
+            stat.status_string = nlohmann::json{{"error", res.error}};
+            done(std::move(stat));
+            return;
+        }
 
-    curl_slist_free_all(headers);
-    curl_easy_cleanup(curl);
+        bool http_ok = isHttpResponseOk(curl);
+        apiLogger.debug("Resposta HTTP: {}", LogPolicy::body(responseBody));
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(responseBody);
+        try {
+            nlohmann::json response = nlohmann::json::parse(responseBody);
 
-        if (!http_ok) {
-            apiLogger.error("Erro HTTP ao registrar o template");
-            stat.status_code = c_status::ERR;
-            stat.status_string = response;
-            if (!response.contains("error")) {
-                response["error"] = "Servidor retornou código de erro HTTP";
+            if (!http_ok) {
+                apiLogger.error("Erro HTTP ao registrar o template");
+                stat.status_code = c_status::ERR;
+                stat.status_string = response;
+                if (!response.contains("error")) {
+                    response["error"] = "Servidor retornou código de erro HTTP";
+                    stat.status_string = response;
+                }
+            } else {
+                apiLogger.info("Instância registrada com sucesso");
+                stat.status_code = c_status::OK;
                 stat.status_string = response;
             }
-        } else {
-            apiLogger.info("Instância registrada com sucesso");
-            stat.status_code = c_status::OK;
-            stat.status_string = response;
-        }
-    } catch (const std::exception& e) {
-        apiLogger.error("Erro ao processar registrar o template: " + std::string(e.what()));
-        if (!http_ok) {
-            stat.status_code = c_status::ERR;
-            stat.status_string = nlohmann::json{
-                {"error", "Erro no servidor remoto"},
-                {"raw_response", responseBody}
-            };
-        } else {
-            stat.status_code = c_status::OK;
-            stat.status_string = nlohmann::json{
-                {"raw_response", responseBody}
-            };
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao processar registrar o template: {}", e.what());
+            if (!http_ok) {
+                stat.status_code = c_status::ERR;
+                stat.status_string = nlohmann::json{
+                    {"error", "Erro no servidor remoto"},
+                    {"raw_response", responseBody}
+                };
+            } else {
+                stat.status_code = c_status::OK;
+                stat.status_string = nlohmann::json{
+                    {"raw_response", responseBody}
+                };
+            }
         }
-    }
 
-    return stat;
+        done(std::move(stat));
+    }, {"CLOUD", "registerTemplate"});
 }
@@ -2,16 +2,21 @@
 #include "constants.h"
 #include "cloud_constants.h"
 #include <curl/curl.h>
+#include <string_view>
 #include "../api/api_constants.h"
 
 class Cloud {
 private:
-    static Status subscribeToWaba_(std::string waba_id, std::string access_token);
-    static Status getPhoneNumberId_(std::string waba_id, std::string access_token);
-    static Status registerPhoneNumber_(std::string phone_number_id, std::string access_token);
+    static void subscribeToWaba_(std::string waba_id, std::string access_token, StatusCallback done);
+    static void getPhoneNumberId_(std::string waba_id, std::string access_token, StatusCallback done);
+    static void registerPhoneNumber_(std::string phone_number_id, std::string access_token, StatusCallback done);
 public:
-    static Status registerNumber(std::string waba_id, std::string access_token);
-    static Status sendMessage(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token);
-    static Status registerTemplate(std::string access_token, Template template_, std::string inst_id, std::string waba_id);
-    static Status sendTemplate(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token, std::vector<FB_VARS> vars, std::string template_name);
+    // Subscribes to the WABA, looks up its phone number id and registers it, one call after the other.
+    static void registerNumber(std::string waba_id, std::string access_token, StatusCallback done);
+    // Asynchronous, see Evolution::sendMessage_e.
+    static void sendMessage(std::string instance_id, std::string receiver, std::string_view body, MediaType m_type, std::string phone_number_id, std::string access_token, ResponseMode mode,
+                            StatusCallback done);
+    static void registerTemplate(std::string access_token, Template template_, std::string inst_id, std::string waba_id, StatusCallback done);
+    static void sendTemplate(std::string instance_id, std::string receiver, std::string body, MediaType m_type, std::string phone_number_id, std::string access_token, std::vector<FB_VARS> vars, std::string template_name, ResponseMode mode,
+                             StatusCallback done);
 };
\ No newline at end of file
@@ -1,53 +1,169 @@
 #include "config.h"
 #include "../../dependencies/dotenv.h"
 #include "../constants.h"
+#include <atomic>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <boost/asio.hpp>
 
-Config::Config() {
+#if defined(__cpp_lib_atomic_shared_ptr)
+static std::atomic<std::shared_ptr<const Env>>& snapshot() {
+    static std::atomic<std::shared_ptr<const Env>> snap;
+    return snap;
+}
+
+static std::shared_ptr<const Env> loadSnapshot() {
+    return snapshot().load(std::memory_order_acquire);
+}
+
+static void storeSnapshot(std::shared_ptr<const Env> env) {
+    snapshot().store(std::move(env), std::memory_order_release);
+}
+#else
+static std::shared_ptr<const Env>& snapshot() {
+    static std::shared_ptr<const Env> snap;
+    return snap;
+}
+
+static std::shared_ptr<const Env> loadSnapshot() {
+    return std::atomic_load_explicit(&snapshot(), std::memory_order_acquire);
+}
+
+static void storeSnapshot(std::shared_ptr<const Env> env) {
+    std::atomic_store_explicit(&snapshot(), std::move(env), std::memory_order_release);
+}
+#endif
+
+static std::mutex& reloadMutex() {
+    static std::mutex mtx;
+    return mtx;
+}
+
+static int getIntEnv(const char* name, int def) {
+    try {
+        return std::stoi(dotenv::getenv(name, std::to_string(def)));
+    } catch (const std::exception&) {
+        std::cerr << "Invalid " << name << " value, using default: " << def << std::endl;
+        return def;
+    }
+}
+
+Config::Config() : env_vars(current()) {}
+
+std::shared_ptr<const Env> Config::current() {
+    if (auto env = loadSnapshot()) {
+        return env;
+    }
+    std::lock_guard<std::mutex> lock(reloadMutex());
+    if (auto env = loadSnapshot()) {
+        return env;
+    }
+    auto env = loadEnv();
+    storeSnapshot(env);
+    return env;
+}
+
+void Config::reload() {
+    std::lock_guard<std::mutex> lock(reloadMutex());
+    storeSnapshot(loadEnv());
+}
+
+std::shared_ptr<const Env> Config::loadEnv() {
     std::string root_path = "../.env";
     if (std::filesystem::exists(".env")) {
         root_path = ".env";
     }
 
-    std::cout << "Tentando carregar .env de: " << root_path << std::endl;
     dotenv::init(root_path.c_str());
-    loadEnv();
-
-    std::cout << "EVO_URL carregada: [" << env_vars.evo_url << "]" << std::endl;
-}
-
-
-void Config::loadEnv() {
-    env_vars.evo_url = dotenv::getenv("EVO_URL", "");
-    env_vars.evo_token = dotenv::getenv("EVO_TOKEN", "");
-    env_vars.wuz_url = dotenv::getenv("WUZ_URL", "");
-    env_vars.db_url = dotenv::getenv("DB_URL", "");
-    env_vars.db_url_wuz = dotenv::getenv("DB_URL_WUZ", "");
-    env_vars.default_webhook = dotenv::getenv("DEFAULT_WEBHOOK", "");
-    env_vars.wuz_admin_token = dotenv::getenv("WUZ_ADMIN_TOKEN", "");
-    env_vars.rabbit_url = dotenv::getenv("RABBIT_URL", "");
-    env_vars.db_url_evo = dotenv::getenv("DB_URL_EVO", "");
-    env_vars.ip = dotenv::getenv("IP", "0.0.0.0");
-    env_vars.token = dotenv::getenv("TOKEN", "ABCD1234"); // Por favor, muda isso.
-    std::string port = dotenv::getenv("PORT", "8080");
-    std::string cloud_version = dotenv::getenv("CLOUD_VERSION", "22.0");
+
+    auto env_vars = std::make_shared<Env>();
+    env_vars->evo_url = dotenv::getenv("EVO_URL", "");
+    env_vars->evo_token = dotenv::getenv("EVO_TOKEN", "");
+    env_vars->wuz_url = dotenv::getenv("WUZ_URL", "");
+    env_vars->cloud_url = dotenv::getenv("CLOUD_URL", "https://graph.facebook.com");
+    while (!env_vars->cloud_url.empty() && env_vars->cloud_url.back() == '/') {
+        env_vars->cloud_url.pop_back();
+    }
+    env_vars->db_url = dotenv::getenv("DB_URL", "");
+    env_vars->db_url_wuz = dotenv::getenv("DB_URL_WUZ", "");
+    env_vars->default_webhook = dotenv::getenv("DEFAULT_WEBHOOK", "");
+    env_vars->public_url = dotenv::getenv("PUBLIC_URL", "");
+    while (!env_vars->public_url.empty() && env_vars->public_url.back() == '/') {
+        env_vars->public_url.pop_back();
+    }
+    env_vars->wuz_admin_token = dotenv::getenv("WUZ_ADMIN_TOKEN", "");
+    env_vars->rabbit_url = dotenv::getenv("RABBIT_URL", "");
+    env_vars->db_url_evo = dotenv::getenv("DB_URL_EVO", "");
+    env_vars->ip = dotenv::getenv("IP", "0.0.0.0");
+    env_vars->token = dotenv::getenv("TOKEN", "ABCD1234"); // Por favor, muda isso.
     try {
-        env_vars.port = std::stoi(dotenv::getenv("PORT", std::to_string(8080)));
+        env_vars->port = std::stoi(dotenv::getenv("PORT", std::to_string(8080)));
     } catch (const std::exception&) {
-        env_vars.port = 8080;
+        env_vars->port = 8080;
         std::cerr << "Invalid PORT value, using default: " << 8080 << std::endl;
     }
 
     try {
-        env_vars.cloud_version = std::stof(dotenv::getenv("CLOUD_VERSION", std::to_string(22.0)));
+        env_vars->cloud_version = std::stof(dotenv::getenv("CLOUD_VERSION", std::to_string(22.0)));
     } catch (const std::exception&) {
-        env_vars.cloud_version = 22.0;
+        env_vars->cloud_version = 22.0;
         std::cerr << "Invalid CLOUD_VERSION value, using default: " << 22.0 << std::endl;
     }
+
+    env_vars->db_pool_size = getIntEnv("DB_POOL_SIZE", 10);
+    env_vars->db_pool_timeout_ms = getIntEnv("DB_POOL_TIMEOUT_MS", 5000);
+    env_vars->db_pool_idle_check_s = getIntEnv("DB_POOL_IDLE_CHECK_S", 30);
+    env_vars->keepalive_timeout_s = getIntEnv("KEEPALIVE_TIMEOUT_S", 30);
+    env_vars->max_requests_per_connection = getIntEnv("MAX_REQUESTS_PER_CONNECTION", 1000);
+    env_vars->pipeline_limit = getIntEnv("PIPELINE_LIMIT", 8);
+    env_vars->worker_threads = getIntEnv("WORKER_THREADS", 16);
+    env_vars->worker_queue_depth = getIntEnv("WORKER_QUEUE_DEPTH", 256);
+    env_vars->retry_after_s = getIntEnv("RETRY_AFTER_S", 1);
+    env_vars->instance_status_refresh_s = getIntEnv("INSTANCE_STATUS_REFRESH_S", 15);
+    env_vars->bulk_max_items = getIntEnv("BULK_MAX_ITEMS", 1000);
+    env_vars->bulk_instance_concurrency = getIntEnv("BULK_INSTANCE_CONCURRENCY", 4);
+    env_vars->bulk_max_parallel = getIntEnv("BULK_MAX_PARALLEL", 32);
+    env_vars->log_level = dotenv::getenv("LOG_LEVEL", "info");
+    env_vars->log_overflow_policy = dotenv::getenv("LOG_OVERFLOW_POLICY", "block");
+    env_vars->log_queue_size = getIntEnv("LOG_QUEUE_SIZE", 8192);
+    env_vars->log_threads = getIntEnv("LOG_THREADS", 1);
+    env_vars->log_body_preview_bytes = getIntEnv("LOG_BODY_PREVIEW_BYTES", 1024);
+    env_vars->log_media_threshold = getIntEnv("LOG_MEDIA_THRESHOLD", 256);
+    env_vars->outbox_workers = getIntEnv("OUTBOX_WORKERS", 4);
+    env_vars->outbox_max_in_flight = getIntEnv("OUTBOX_MAX_IN_FLIGHT", 64);
+    env_vars->outbox_max_attempts = getIntEnv("OUTBOX_MAX_ATTEMPTS", 5);
+    env_vars->outbox_backoff_base_s = getIntEnv("OUTBOX_BACKOFF_BASE_S", 2);
+    env_vars->outbox_backoff_max_s = getIntEnv("OUTBOX_BACKOFF_MAX_S", 300);
+    env_vars->outbox_poll_ms = getIntEnv("OUTBOX_POLL_MS", 1000);
+    env_vars->outbox_lease_s = getIntEnv("OUTBOX_LEASE_S", 120);
+    env_vars->rate_limit_instance_per_min = getIntEnv("RATE_LIMIT_INSTANCE_PER_MIN", 60);
+    env_vars->rate_limit_instance_burst = getIntEnv("RATE_LIMIT_INSTANCE_BURST", 5);
+    env_vars->rate_limit_provider_per_min = getIntEnv("RATE_LIMIT_PROVIDER_PER_MIN", 0);
+    env_vars->rate_limit_provider_burst = getIntEnv("RATE_LIMIT_PROVIDER_BURST", 50);
+    env_vars->rate_limit_max_wait_ms = getIntEnv("RATE_LIMIT_MAX_WAIT_MS", 10000);
+    env_vars->rate_limit_queue_size = getIntEnv("RATE_LIMIT_QUEUE_SIZE", 100);
+    env_vars->circuit_error_percent = getIntEnv("CIRCUIT_ERROR_PERCENT", 50);
+    env_vars->circuit_min_requests = getIntEnv("CIRCUIT_MIN_REQUESTS", 20);
+    env_vars->circuit_window_s = getIntEnv("CIRCUIT_WINDOW_S", 30);
+    env_vars->circuit_slow_ms = getIntEnv("CIRCUIT_SLOW_MS", 5000);
+    env_vars->circuit_open_s = getIntEnv("CIRCUIT_OPEN_S", 30);
+    env_vars->circuit_half_open_probes = getIntEnv("CIRCUIT_HALF_OPEN_PROBES", 3);
+    env_vars->http_connect_timeout_ms = getIntEnv("HTTP_CONNECT_TIMEOUT_MS", 5000);
+    env_vars->http_timeout_ms = getIntEnv("HTTP_TIMEOUT_MS", 30000);
+    env_vars->webhook_queue_size = getIntEnv("WEBHOOK_QUEUE_SIZE", 10000);
+    env_vars->webhook_max_in_flight = getIntEnv("WEBHOOK_MAX_IN_FLIGHT", 256);
+    env_vars->webhook_batch_size = getIntEnv("WEBHOOK_BATCH_SIZE", 64);
+    env_vars->webhook_timeout_ms = getIntEnv("WEBHOOK_TIMEOUT_MS", 5000);
+    env_vars->webhook_max_attempts = getIntEnv("WEBHOOK_MAX_ATTEMPTS", 5);
+    env_vars->webhook_backoff_ms = getIntEnv("WEBHOOK_BACKOFF_MS", 500);
+    std::string metrics_public = dotenv::getenv("METRICS_PUBLIC", "false");
+    env_vars->metrics_public = metrics_public == "true" || metrics_public == "1";
+    std::string webhook_legacy_token = dotenv::getenv("WEBHOOK_LEGACY_TOKEN", "false");
+    env_vars->webhook_legacy_token = webhook_legacy_token == "true" || webhook_legacy_token == "1";
+    return env_vars;
 }
 
 const Env& Config::getEnv() const {
-    return env_vars;
-}
\ No newline at end of file
+    return *env_vars;
+}
@@ -1,29 +1,89 @@
 #pragma once
 
+#include <memory>
 #include <string>
 #include "../constants.h"
 
 typedef struct {
     std::string evo_url;
+    std::string cloud_url;
     std::string evo_token;
     std::string wuz_url;
     std::string db_url;
     std::string db_url_wuz;
     std::string default_webhook;
+    // Base URL the providers reach this server at; their webhooks are registered under it.
+    std::string public_url;
     std::string wuz_admin_token;
     std::string rabbit_url;
     std::string db_url_evo;
     std::string ip;
     std::string token;
+    std::string log_level;
+    std::string log_overflow_policy;
     float cloud_version;
+    bool metrics_public;
+    // Also accept /webhook?token=TOKEN, for providers configured before per-instance secrets.
+    bool webhook_legacy_token;
     int port;
+    int db_pool_size;
+    int db_pool_timeout_ms;
+    int db_pool_idle_check_s;
+    int keepalive_timeout_s;
+    int max_requests_per_connection;
+    int pipeline_limit;
+    int worker_threads;
+    int worker_queue_depth;
+    int retry_after_s;
+    int instance_status_refresh_s;
+    int bulk_max_items;
+    int bulk_instance_concurrency;
+    int bulk_max_parallel;
+    int log_queue_size;
+    int log_threads;
+    int log_body_preview_bytes;
+    int log_media_threshold;
+    int outbox_workers;
+    int outbox_max_in_flight;
+    int outbox_max_attempts;
+    int outbox_backoff_base_s;
+    int outbox_backoff_max_s;
+    int outbox_poll_ms;
+    int outbox_lease_s;
+    int rate_limit_instance_per_min;
+    int rate_limit_instance_burst;
+    int rate_limit_provider_per_min;
+    int rate_limit_provider_burst;
+    int rate_limit_max_wait_ms;
+    int rate_limit_queue_size;
+    int circuit_error_percent;
+    int circuit_min_requests;
+    int circuit_window_s;
+    int circuit_slow_ms;
+    int circuit_open_s;
+    int circuit_half_open_probes;
+    int http_connect_timeout_ms;
+    int http_timeout_ms;
+    int webhook_queue_size;
+    int webhook_max_in_flight;
+    int webhook_batch_size;
+    int webhook_timeout_ms;
+    int webhook_max_attempts;
+    int webhook_backoff_ms;
 } Env;
 
+/* The .env file is parsed once and published as an immutable snapshot.
+   Constructing a Config only pins the current snapshot, so it is cheap enough
+   for the request path; reload() swaps in a new snapshot without touching the
+   ones requests are still holding. */
 class Config{
     private:
-        Env env_vars;
-        void loadEnv();
+        std::shared_ptr<const Env> env_vars;
+        static std::shared_ptr<const Env> loadEnv();
     public:
         Config();
         const Env& getEnv() const;
-};
\ No newline at end of file
+
+        static std::shared_ptr<const Env> current();
+        static void reload();
+};
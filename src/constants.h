@@ -1,6 +1,10 @@
 #pragma once
 
 #include "../dependencies/json.h"
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
 
 enum class MediaType {
     IMAGE,
@@ -20,7 +24,67 @@ enum class c_status {
     ERR
 };
 
+// How a provider's answer to a send comes back: parsed into status_string, or as the bytes it sent.
+enum class ResponseMode {
+    PARSED,
+    RAW
+};
+
 typedef struct {
     c_status status_code;
     nlohmann::json status_string;
-} Status;
\ No newline at end of file
+    // Set instead of status_string for ResponseMode::RAW successes; always a valid JSON document.
+    std::string raw_body{};
+    // Set when a rate limit turned the call down: seconds until it may be retried.
+    int retry_after_s{};
+    // Set on failures that may succeed if the same call is simply made again: the upstream gave no
+    // answer (transport error, timeout, open breaker) or a 5xx/429, or the database was unreachable.
+    // Anything else (unknown or inactive instance, a refused body, a 4xx) fails the same way every time.
+    bool transient{};
+} Status;
+
+// One item of a /sendMessages batch.
+typedef struct {
+    std::string instance_id;
+    std::string number;
+    std::string body;
+    MediaType type;
+} OutgoingMessage;
+
+// Completion of an asynchronous provider call; runs exactly once.
+using StatusCallback = std::function<void(Status)>;
+
+// Names used in requests, in instances.instance_type and in the outbox.
+inline std::string_view apiTypeName(ApiType type) {
+    switch (type) {
+        case ApiType::EVOLUTION: return "EVOLUTION";
+        case ApiType::WUZAPI: return "WUZAPI";
+        case ApiType::CLOUD: return "CLOUD";
+    }
+    return "";
+}
+
+inline std::optional<ApiType> parseApiType(std::string_view name) {
+    if (name == "EVOLUTION") return ApiType::EVOLUTION;
+    if (name == "WUZAPI") return ApiType::WUZAPI;
+    if (name == "CLOUD") return ApiType::CLOUD;
+    return std::nullopt;
+}
+
+inline std::string_view mediaTypeName(MediaType type) {
+    switch (type) {
+        case MediaType::IMAGE: return "IMAGE";
+        case MediaType::AUDIO: return "AUDIO";
+        case MediaType::DOCUMENT: return "DOCUMENT";
+        case MediaType::TEXT: break;
+    }
+    return "TEXT";
+}
+
+inline std::optional<MediaType> parseMediaType(std::string_view name) {
+    if (name == "TEXT") return MediaType::TEXT;
+    if (name == "IMAGE") return MediaType::IMAGE;
+    if (name == "AUDIO") return MediaType::AUDIO;
+    if (name == "DOCUMENT") return MediaType::DOCUMENT;
+    return std::nullopt;
+}
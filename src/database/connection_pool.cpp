@@ -0,0 +1,193 @@
+#include "connection_pool.h"
+#include "config/config.h"
+#include "logger/logger.h"
+#include <stdexcept>
+#include <unordered_map>
+
+extern Logger apiLogger;
+
+ConnectionPool::Lease::Lease(ConnectionPool* pool, std::unique_ptr<pqxx::connection> conn)
+    : pool_(pool), conn_(std::move(conn)) {}
+
+ConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : pool_(other.pool_), conn_(std::move(other.conn_)), broken_(other.broken_) {
+    other.pool_ = nullptr;
+}
+
+ConnectionPool::Lease& ConnectionPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        release();
+        pool_ = other.pool_;
+        conn_ = std::move(other.conn_);
+        broken_ = other.broken_;
+        other.pool_ = nullptr;
+    }
+    return *this;
+}
+
+ConnectionPool::Lease::~Lease() {
+    release();
+}
+
+void ConnectionPool::Lease::release() {
+    if (pool_ && conn_) {
+        pool_->giveBack(std::move(conn_), broken_);
+    }
+    pool_ = nullptr;
+    conn_.reset();
+    broken_ = false;
+}
+
+ConnectionPool::ConnectionPool(std::string db_url, std::string name, std::size_t max_size, std::chrono::milliseconds checkout_timeout, std::chrono::seconds idle_check_after, Preparer preparer)
+    : db_url_(std::move(db_url)), name_(std::move(name)), max_size_(max_size), checkout_timeout_(checkout_timeout), idle_check_after_(idle_check_after), preparer_(std::move(preparer)) {}
+
+namespace {
+
+typedef struct {
+    std::mutex mtx;
+    std::unordered_map<std::string, std::unique_ptr<ConnectionPool>> pools;
+} Registry;
+
+Registry& registry() {
+    static Registry reg;
+    return reg;
+}
+
+} // namespace
+
+ConnectionPool& ConnectionPool::forUrl(const std::string& db_url, const std::string& name, Preparer preparer) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    auto it = reg.pools.find(db_url);
+    if (it != reg.pools.end()) {
+        return *it->second;
+    }
+
+    Config cfg;
+    const auto& env = cfg.getEnv();
+    std::size_t max_size = env.db_pool_size > 0 ? static_cast<std::size_t>(env.db_pool_size) : 1;
+    apiLogger.info("Criando pool de conexões {} com até {} conexões", name, max_size);
+    auto pool = std::unique_ptr<ConnectionPool>(new ConnectionPool(
+        db_url, name, max_size,
+        std::chrono::milliseconds(env.db_pool_timeout_ms),
+        std::chrono::seconds(env.db_pool_idle_check_s),
+        std::move(preparer)));
+    auto& ref = *pool;
+    reg.pools.emplace(db_url, std::move(pool));
+    return ref;
+}
+
+std::vector<std::pair<std::string, ConnectionPool::Metrics>> ConnectionPool::allMetrics() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mtx);
+    std::vector<std::pair<std::string, Metrics>> all;
+    all.reserve(reg.pools.size());
+    for (const auto& [url, pool] : reg.pools) {
+        all.emplace_back(pool->name_, pool->metrics());
+    }
+    return all;
+}
+
+bool ConnectionPool::isHealthy(pqxx::connection& conn) {
+    try {
+        if (!conn.is_open()) {
+            return false;
+        }
+        pqxx::nontransaction ntx(conn);
+        ntx.exec("SELECT 1");
+        return true;
+    } catch (const std::exception& e) {
+        apiLogger.warn("Conexão ociosa falhou no health check: {}", e.what());
+        return false;
+    }
+}
+
+ConnectionPool::Lease ConnectionPool::acquire() {
+    const auto deadline = std::chrono::steady_clock::now() + checkout_timeout_;
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (true) {
+        while (!idle_.empty()) {
+            Slot slot = std::move(idle_.back());
+            idle_.pop_back();
+
+            bool stale = std::chrono::steady_clock::now() - slot.last_used >= idle_check_after_;
+            if (stale) {
+                // The health check is a round trip, never hold the pool lock during it.
+                lock.unlock();
+                bool healthy = isHealthy(*slot.conn);
+                lock.lock();
+                if (!healthy) {
+                    --size_;
+                    ++discarded_;
+                    cv_.notify_one();
+                    continue;
+                }
+            } else if (!slot.conn->is_open()) {
+                --size_;
+                ++discarded_;
+                continue;
+            }
+            ++acquired_;
+            return Lease(this, std::move(slot.conn));
+        }
+
+        if (size_ < max_size_) {
+            ++size_;
+            lock.unlock();
+            try {
+                auto conn = std::make_unique<pqxx::connection>(db_url_);
+                if (!conn->is_open()) {
+                    throw std::runtime_error("Failed to open DB connection");
+                }
+                if (preparer_) {
+                    preparer_(*conn);
+                }
+                lock.lock();
+                ++acquired_;
+                return Lease(this, std::move(conn));
+            } catch (...) {
+                lock.lock();
+                --size_;
+                cv_.notify_one();
+                throw;
+            }
+        }
+
+        ++waiting_;
+        bool signalled = cv_.wait_until(lock, deadline, [this] {
+            return !idle_.empty() || size_ < max_size_;
+        });
+        --waiting_;
+        if (!signalled) {
+            ++timeouts_;
+            apiLogger.error("Timeout aguardando conexão livre no pool ({}/{} em uso)", size_, max_size_);
+            throw std::runtime_error("Timed out waiting for a free DB connection");
+        }
+    }
+}
+
+void ConnectionPool::giveBack(std::unique_ptr<pqxx::connection> conn, bool broken) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (broken || !conn || !conn->is_open()) {
+        --size_;
+        ++discarded_;
+    } else {
+        idle_.push_back(Slot{std::move(conn), std::chrono::steady_clock::now()});
+    }
+    cv_.notify_one();
+}
+
+ConnectionPool::Metrics ConnectionPool::metrics() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Metrics m{};
+    m.max_size = max_size_;
+    m.size = size_;
+    m.idle = idle_.size();
+    m.in_use = size_ - idle_.size();
+    m.waiting = waiting_;
+    m.acquired = acquired_;
+    m.timeouts = timeouts_;
+    m.discarded = discarded_;
+    return m;
+}
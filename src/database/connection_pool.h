@@ -0,0 +1,98 @@
+#pragma once
+
+#include <pqxx/pqxx>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* Process-wide, bounded pool of PostgreSQL connections. There is one pool per
+   database URL (main DB, Evolution DB, Wuzapi DB), created on first use and
+   kept alive until the process exits. Each pool carries the name it was
+   created with (e.g. "main", "evolution"), which labels its metrics. */
+class ConnectionPool {
+private:
+    typedef struct {
+        std::unique_ptr<pqxx::connection> conn;
+        std::chrono::steady_clock::time_point last_used;
+    } Slot;
+
+public:
+    typedef struct {
+        std::size_t max_size;
+        std::size_t size;
+        std::size_t idle;
+        std::size_t in_use;
+        std::size_t waiting;
+        std::uint64_t acquired;
+        std::uint64_t timeouts;
+        std::uint64_t discarded;
+    } Metrics;
+
+    // RAII handle to a borrowed connection, given back to the pool on destruction.
+    class Lease {
+    private:
+        ConnectionPool* pool_ = nullptr;
+        std::unique_ptr<pqxx::connection> conn_;
+        bool broken_ = false;
+        friend class ConnectionPool;
+        Lease(ConnectionPool* pool, std::unique_ptr<pqxx::connection> conn);
+    public:
+        Lease() = default;
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        pqxx::connection* get() const { return conn_.get(); }
+        pqxx::connection* operator->() const { return conn_.get(); }
+        pqxx::connection& operator*() const { return *conn_; }
+        explicit operator bool() const { return conn_ != nullptr; }
+
+        // Marks the connection as unusable so it is closed instead of reused.
+        void invalidate() { broken_ = true; }
+        void release();
+    };
+
+    using Preparer = std::function<void(pqxx::connection&)>;
+
+    // The name and preparer given when the pool is first created stick; the preparer runs on each new connection.
+    static ConnectionPool& forUrl(const std::string& db_url, const std::string& name, Preparer preparer = {});
+    // Metrics of every pool created so far, keyed by pool name.
+    static std::vector<std::pair<std::string, Metrics>> allMetrics();
+
+    // Blocks up to the configured checkout timeout. Throws on timeout or connection failure.
+    Lease acquire();
+    Metrics metrics() const;
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+
+private:
+    ConnectionPool(std::string db_url, std::string name, std::size_t max_size, std::chrono::milliseconds checkout_timeout, std::chrono::seconds idle_check_after, Preparer preparer);
+
+    void giveBack(std::unique_ptr<pqxx::connection> conn, bool broken);
+    static bool isHealthy(pqxx::connection& conn);
+
+    const std::string db_url_;
+    const std::string name_;
+    const std::size_t max_size_;
+    const std::chrono::milliseconds checkout_timeout_;
+    const std::chrono::seconds idle_check_after_;
+    const Preparer preparer_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::vector<Slot> idle_;
+    std::size_t size_ = 0;
+    std::size_t waiting_ = 0;
+    std::uint64_t acquired_ = 0;
+    std::uint64_t timeouts_ = 0;
+    std::uint64_t discarded_ = 0;
+};
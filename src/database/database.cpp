@@ -1,70 +1,336 @@
 #include "database.h"
+#include "config/config.h"
 #include "logger/logger.h"
+#include <array>
+#include <atomic>
 #include <sstream>
+#include <utility>
 
 extern Logger apiLogger;
 
+const char* const Database::instance_columns =
+    "instance_id, name, instance_type, is_active, webhook_url, waba_id, access_token, phone_number_id";
+
+namespace {
+
+enum class DbRole {
+    MAIN,
+    EVOLUTION,
+    WUZAPI
+};
+
+typedef struct {
+    DbRole role;
+    const char* name;
+    std::string sql;
+} Statement;
+
+const std::vector<Statement>& statements() {
+    static const std::vector<Statement> list = {
+        {DbRole::MAIN, "fetch_instance", std::string("SELECT ") + Database::instance_columns + " FROM instances WHERE instance_id = $1 LIMIT 1"},
+        {DbRole::MAIN, "all_instances", std::string("SELECT ") + Database::instance_columns + " FROM instances"},
+        // Keyset pages for /retrieveInstances, one statement per filter combination so each can use its index.
+        {DbRole::MAIN, "instances_page", std::string("SELECT ") + Database::instance_columns +
+            " FROM instances WHERE instance_id > $1 ORDER BY instance_id LIMIT $2"},
+        {DbRole::MAIN, "instances_page_type", std::string("SELECT ") + Database::instance_columns +
+            " FROM instances WHERE instance_type = $3 AND instance_id > $1 ORDER BY instance_id LIMIT $2"},
+        {DbRole::MAIN, "instances_page_active", std::string("SELECT ") + Database::instance_columns +
+            " FROM instances WHERE is_active = $3 AND instance_id > $1 ORDER BY instance_id LIMIT $2"},
+        {DbRole::MAIN, "instances_page_type_active", std::string("SELECT ") + Database::instance_columns +
+            " FROM instances WHERE instance_type = $3 AND is_active = $4 AND instance_id > $1 ORDER BY instance_id LIMIT $2"},
+        {DbRole::MAIN, "insert_instance",
+            "INSERT INTO instances (instance_id, name, instance_type, is_active, webhook_url, waba_id, access_token, phone_number_id) "
+            "VALUES ($1, $2, $3, true, $4, $5, $6, $7) RETURNING instance_id"},
+        {DbRole::MAIN, "delete_instance", "DELETE FROM instances WHERE instance_id = $1"},
+        {DbRole::MAIN, "update_webhook", "UPDATE instances SET webhook_url = $2 WHERE instance_id = $1"},
+        {DbRole::MAIN, "instance_is_active", "SELECT is_active FROM instances WHERE instance_id = $1"},
+        {DbRole::MAIN, "set_instance_active", "UPDATE instances SET is_active = $2 WHERE instance_id = $1"},
+        {DbRole::MAIN, "active_states", "SELECT instance_id, instance_type, is_active FROM instances"},
+        {DbRole::MAIN, "update_active_states",
+            "UPDATE instances SET is_active = v.is_active FROM unnest($1::text[], $2::bool[]) AS v(instance_id, is_active) "
+            "WHERE instances.instance_id = v.instance_id AND instances.is_active IS DISTINCT FROM v.is_active"},
+        {DbRole::MAIN, "insert_log", "INSERT INTO logs (log_level, log_text) VALUES ($1, $2) RETURNING id"},
+        {DbRole::MAIN, "outbox_insert",
+            "INSERT INTO wasolution_outbox (instance_id, number, type, body, callback_url) VALUES ($1, $2, $3, $4, $5) RETURNING id"},
+        {DbRole::MAIN, "outbox_claim",
+            "UPDATE wasolution_outbox SET status = 'sending', attempts = attempts + 1, "
+            "next_attempt_at = now() + make_interval(secs => $1), updated_at = now() "
+            "WHERE id = (SELECT id FROM wasolution_outbox WHERE status IN ('queued', 'sending') AND next_attempt_at <= now() "
+            "ORDER BY next_attempt_at LIMIT 1 FOR UPDATE SKIP LOCKED) "
+            "RETURNING id, instance_id, number, type, body, callback_url, attempts"},
+        {DbRole::MAIN, "outbox_sent",
+            "UPDATE wasolution_outbox SET status = 'sent', result = $2::jsonb, last_error = NULL, updated_at = now() WHERE id = $1"},
+        {DbRole::MAIN, "outbox_retry",
+            "UPDATE wasolution_outbox SET status = 'queued', last_error = $2, next_attempt_at = now() + make_interval(secs => $3), "
+            "updated_at = now() WHERE id = $1"},
+        // A send the rate limiter turned down did not use up an attempt.
+        {DbRole::MAIN, "outbox_defer",
+            "UPDATE wasolution_outbox SET status = 'queued', attempts = GREATEST(attempts - 1, 0), last_error = $2, "
+            "next_attempt_at = now() + make_interval(secs => $3), updated_at = now() WHERE id = $1"},
+        {DbRole::MAIN, "outbox_failed",
+            "UPDATE wasolution_outbox SET status = 'failed', last_error = $2, updated_at = now() WHERE id = $1"},
+        {DbRole::MAIN, "outbox_fetch",
+            "SELECT id, instance_id, number, type, callback_url, status, attempts, last_error, result::text, "
+            "created_at::text, updated_at::text FROM wasolution_outbox WHERE id = $1"},
+        {DbRole::MAIN, "webhook_dead_letters",
+            "INSERT INTO wasolution_webhook_dead_letters (instance_id, url, payload, attempts, last_error) "
+            "SELECT NULLIF(v.instance_id, ''), NULLIF(v.url, ''), v.payload, v.attempts, v.last_error "
+            "FROM unnest($1::text[], $2::text[], $3::text[], $4::int[], $5::text[]) AS v(instance_id, url, payload, attempts, last_error)"},
+        {DbRole::EVOLUTION, "connection_state_e", "SELECT \"connectionStatus\" FROM \"Instance\" WHERE token = $1"},
+        {DbRole::EVOLUTION, "connection_states_e", "SELECT token, \"connectionStatus\" FROM \"Instance\""},
+        {DbRole::EVOLUTION, "connection_states_for_e", "SELECT token, \"connectionStatus\" FROM \"Instance\" WHERE token = ANY($1::text[])"},
+        {DbRole::WUZAPI, "create_user_w", "INSERT INTO users (name, token, id) VALUES ($1, $2, $2) RETURNING id"},
+        {DbRole::WUZAPI, "qrcode_w", "SELECT qrcode FROM users WHERE id = $1 OR token = $1 LIMIT 1"},
+        {DbRole::WUZAPI, "update_webhook_w", "UPDATE users SET webhook = $1 WHERE id = $2"},
+    };
+    return list;
+}
+
+// Tables wasolution owns; `instances` and `logs` are created by the operator. Replicas serialise on the advisory lock.
+const char* const schema_sql = R"SQL(
+SELECT pg_advisory_xact_lock(hashtext('wasolution_schema'));
+
+CREATE TABLE IF NOT EXISTS wasolution_outbox (
+    id BIGSERIAL PRIMARY KEY,
+    instance_id TEXT NOT NULL,
+    number TEXT NOT NULL,
+    type TEXT NOT NULL,
+    body TEXT NOT NULL,
+    callback_url TEXT,
+    status TEXT NOT NULL DEFAULT 'queued',
+    attempts INTEGER NOT NULL DEFAULT 0,
+    next_attempt_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    last_error TEXT,
+    result JSONB,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT now(),
+    updated_at TIMESTAMPTZ NOT NULL DEFAULT now()
+);
+
+CREATE INDEX IF NOT EXISTS wasolution_outbox_due
+    ON wasolution_outbox (next_attempt_at) WHERE status IN ('queued', 'sending');
+
+CREATE TABLE IF NOT EXISTS wasolution_webhook_dead_letters (
+    id BIGSERIAL PRIMARY KEY,
+    instance_id TEXT,
+    url TEXT,
+    payload TEXT NOT NULL,
+    attempts INTEGER NOT NULL,
+    last_error TEXT,
+    created_at TIMESTAMPTZ NOT NULL DEFAULT now()
+);
+)SQL";
+
+// Indexes behind the filtered /retrieveInstances pages. Kept apart from schema_sql: `instances`
+// belongs to the operator and may be large and busy, so they are built CONCURRENTLY (no lock
+// against writes), which must run one statement at a time outside any transaction.
+constexpr std::array<std::pair<const char*, const char*>, 2> instance_indexes = {{
+    {"wasolution_instances_type", "instances (instance_type, instance_id)"},
+    {"wasolution_instances_active", "instances (is_active, instance_id)"},
+}};
+
+void ensureInstanceIndexes(pqxx::connection& conn) {
+    pqxx::nontransaction ntx(conn);
+    // Another process booting at the same time is already building them.
+    if (!ntx.exec("SELECT pg_try_advisory_lock(hashtext('wasolution_instance_indexes'))")[0][0].as<bool>()) {
+        apiLogger.info("Índices da tabela instances sendo criados por outro processo");
+        return;
+    }
+    try {
+        for (const auto& [name, definition] : instance_indexes) {
+            // An interrupted CONCURRENTLY build leaves an invalid index that IF NOT EXISTS would keep.
+            auto invalid = ntx.exec(fmt::format(
+                "SELECT 1 FROM pg_index i JOIN pg_class c ON c.oid = i.indexrelid "
+                "WHERE c.relname = '{}' AND NOT i.indisvalid", name));
+            if (!invalid.empty()) {
+                ntx.exec(fmt::format("DROP INDEX CONCURRENTLY IF EXISTS {}", name));
+            }
+            ntx.exec(fmt::format("CREATE INDEX CONCURRENTLY IF NOT EXISTS {} ON {}", name, definition));
+        }
+    } catch (...) {
+        ntx.exec("SELECT pg_advisory_unlock(hashtext('wasolution_instance_indexes'))");
+        throw;
+    }
+    ntx.exec("SELECT pg_advisory_unlock(hashtext('wasolution_instance_indexes'))");
+}
+
+// Runs until it succeeds once, statements on these tables can only be prepared afterwards.
+void ensureSchema(pqxx::connection& conn) {
+    static std::atomic<bool> ready{false};
+    if (ready.load(std::memory_order_acquire)) {
+        return;
+    }
+    try {
+        pqxx::work wrk(conn);
+        wrk.exec(schema_sql);
+        wrk.commit();
+        ready.store(true, std::memory_order_release);
+    } catch (const std::exception& e) {
+        apiLogger.warn("Falha ao criar as tabelas do wasolution: {}", e.what());
+        return;
+    }
+    try {
+        ensureInstanceIndexes(conn);
+    } catch (const std::exception& e) {
+        apiLogger.warn("Falha ao criar os índices da tabela instances: {}", e.what());
+    }
+}
+
+// The roles a URL serves, e.g. "main" or "main+evolution" when they share a database.
+std::string poolName(const std::string& db_url) {
+    auto env = Config::current();
+    std::string name;
+    for (const auto& [url, role] : {std::pair{&env->db_url, "main"}, std::pair{&env->db_url_evo, "evolution"}, std::pair{&env->db_url_wuz, "wuzapi"}}) {
+        if (db_url == *url) {
+            name += name.empty() ? role : std::string("+") + role;
+        }
+    }
+    return name.empty() ? "main" : name;
+}
+
+} // namespace
+
+void Database::prepareStatements(pqxx::connection& conn, const std::string& db_url) {
+    auto env = Config::current();
+    // The same URL may serve more than one role, e.g. a single database for everything.
+    bool main = db_url == env->db_url;
+    bool evo = db_url == env->db_url_evo;
+    bool wuz = db_url == env->db_url_wuz;
+    if (!main && !evo && !wuz) {
+        main = true;
+    }
+
+    if (main) {
+        ensureSchema(conn);
+    }
+
+    for (const auto& stmt : statements()) {
+        if ((stmt.role == DbRole::MAIN && !main) || (stmt.role == DbRole::EVOLUTION && !evo) || (stmt.role == DbRole::WUZAPI && !wuz)) {
+            continue;
+        }
+        try {
+            conn.prepare(stmt.name, stmt.sql);
+        } catch (const std::exception& e) {
+            apiLogger.warn("Falha ao preparar statement {}: {}", std::string(stmt.name), e.what());
+        }
+    }
+}
+
+std::string Database::toArrayLiteral(const std::vector<std::string>& values) {
+    std::string out = "{";
+    for (const auto& value : values) {
+        if (out.size() > 1) {
+            out += ',';
+        }
+        out += '"';
+        for (char ch : value) {
+            if (ch == '"' || ch == '\\') {
+                out += '\\';
+            }
+            out += ch;
+        }
+        out += '"';
+    }
+    out += '}';
+    return out;
+}
+
+std::optional<Database::Instance> Database::fromRow(const pqxx::row& row) {
+    Instance inst;
+    inst.instance_id = row[0].as<std::string>();
+    auto type = parseApiType(row[2].as<std::string>());
+    if (!type.has_value()) {
+        apiLogger.warn("Tipo de instância desconhecido para {}: {}", inst.instance_id, row[2].as<std::string>());
+        return std::nullopt;
+    }
+    inst.instance_name = row[1].as<std::string>();
+    inst.instance_type = type.value();
+    inst.is_active = row[3].as<bool>();
+
+    if (!row[4].is_null()) {
+        inst.webhook_url = row[4].as<std::string>();
+    }
+
+    if (!row[5].is_null()) {
+        inst.waba_id = row[5].as<std::string>();
+    }
+
+    if (!row[6].is_null()) {
+        inst.access_token = row[6].as<std::string>();
+    }
+
+    if (!row[7].is_null()) {
+        inst.phone_number_id = row[7].as<std::string>();
+    }
+    return inst;
+}
+
 Status Database::connect(const std::string& db_url) {
-    apiLogger.debug("Tentando conectar ao banco de dados");
+    apiLogger.debug("Obtendo conexão do pool do banco de dados");
     Status stat;
     try {
-        c = std::make_unique<pqxx::connection>(db_url);
+        c = ConnectionPool::forUrl(db_url, poolName(db_url), [db_url](pqxx::connection& conn) {
+            prepareStatements(conn, db_url);
+        }).acquire();
         if (!c->is_open()) {
             apiLogger.error("Falha ao abrir conexão com o banco de dados");
             stat.status_code = c_status::ERR;
             stat.status_string = "Failed to open DB connection";
+            stat.transient = true;
             return stat;
         }
-        apiLogger.info("Conexão com banco de dados estabelecida com sucesso");
+        apiLogger.debug("Conexão com banco de dados obtida do pool");
         stat.status_code = c_status::OK;
         stat.status_string = "DB connection opened successfully!";
         return stat;
     } catch (const std::exception& e) {
-        apiLogger.error("Erro na conexão com banco de dados: " + std::string(e.what()));
+        apiLogger.error("Erro na conexão com banco de dados: {}", e.what());
         stat.status_code = c_status::ERR;
         std::stringstream ss;
         ss << "Connection error: " << e.what();
         stat.status_string = ss.str();
+        stat.transient = true;
         return stat;
     }
 }
 
+void Database::disconnect() {
+    c.release();
+}
+
+void Database::invalidateOn(const std::exception& e) const {
+    if (c && dynamic_cast<const pqxx::failure*>(&e) != nullptr) {
+        c.invalidate();
+    }
+}
+
 std::optional<Database::Instance> Database::fetchInstance(const std::string& instance_id) const {
-    apiLogger.debug("Buscando instância: " + instance_id);
+    apiLogger.debug("Buscando instância: {}", instance_id);
     try {
-        Instance inst;
         if (!c || !c->is_open()) {
             apiLogger.error("Conexão com banco de dados não está aberta");
             return std::nullopt;
         }
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "SELECT instance_id, name, instance_type, is_active, webhook_url, waba_id, access_token FROM instances WHERE instance_id = " +
-            wrk.quote(instance_id) + " LIMIT 1"
-        );
+        pqxx::result res = execPrepared(wrk, "fetch_instance", instance_id);
         wrk.commit();
         if (res.empty()) {
-            apiLogger.debug("Instância não encontrada: " + instance_id);
+            apiLogger.debug("Instância não encontrada: {}", instance_id);
             return std::nullopt;
         }
-        const pqxx::row& r = res[0];
-        inst.instance_id = r[0].as<std::string>();
-        inst.instance_name = r[1].as<std::string>();
-        inst.instance_type = r[2].as<std::string>();
-        inst.is_active = r[3].as<bool>();
-        inst.webhook_url = r[4].as<std::string>();
-        inst.waba_id = r[5].as<std::string>();
-        inst.access_token = r[6].as<std::string>();
-        apiLogger.debug("Instância encontrada: " + inst.instance_name);
+        auto inst = fromRow(res[0]);
+        if (inst.has_value()) {
+            apiLogger.debug("Instância encontrada: {}", inst->instance_name);
+        }
         return inst;
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao buscar instância: " + std::string(e.what()));
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar instância: {}", e.what());
         return std::nullopt;
     }
 }
 
 Status Database::insertInstance(const std::string &instance_id, const std::string &instance_name, const ApiType &instance_type, std::optional<std::string> webhook_url, std::optional<std::string> waba_id, std::optional<std::string> token, std::optional<std::string> phone_number_id) {
-    apiLogger.info("Inserindo nova instância: " + instance_id + " (" + instance_name + ")");
+    apiLogger.info("Inserindo nova instância: {} ({})", instance_id, instance_name);
     Status stat;
     try {
         if (!c || !c->is_open()) {
@@ -73,49 +339,18 @@ Status Database::insertInstance(const std::string &instance_id, const std::strin
             stat.status_code = c_status::ERR;
             return stat;
         }
-        std::string inst_type;
-        if (instance_type == ApiType::EVOLUTION) {
-            inst_type = "EVOLUTION";
-        } else if (instance_type == ApiType::WUZAPI) {
-            inst_type = "WUZAPI";
-        } else if (instance_type == ApiType::CLOUD) {
-            inst_type = "CLOUD";
-        }
-        pqxx::result res;
-        pqxx::work wrk(*c);
-
-        std::string columns = "instance_id, name, instance_type, is_active";
-        std::string values = wrk.quote(instance_id) + ", " +
-                             wrk.quote(instance_name) + ", " +
-                             wrk.quote(inst_type) + ", true";
-
-        if (webhook_url.has_value()) {
-            columns += ", webhook_url";
-            values += ", " + wrk.quote(webhook_url.value());
-        }
-
+        const std::string inst_type(apiTypeName(instance_type));
         if (waba_id.has_value()) {
-            columns += ", waba_id";
-            values += ", " + wrk.quote(waba_id.value());
-            apiLogger.debug("Incluindo WABA ID na inserção: " + waba_id.value());
+            apiLogger.debug("Incluindo WABA ID na inserção: {}", waba_id.value());
         }
-
-        if (token.has_value()) {
-            columns += ", access_token";
-            values += ", " + wrk.quote(token.value());
-            apiLogger.debug("Incluindo ACCESS_TOKEN na inserção: " + (token.has_value() ? token.value() : "null"));
-        }
-
         if (phone_number_id.has_value()) {
-            columns += ", phone_number_id";
-            values += ", " + wrk.quote(phone_number_id.value());
-            apiLogger.debug("Incluindo PHONE_NUMBER_ID na inserção: " + phone_number_id.value());
+            apiLogger.debug("Incluindo PHONE_NUMBER_ID na inserção: {}", phone_number_id.value());
         }
 
-        res = wrk.exec(
-            "INSERT INTO instances (" + columns + ") VALUES (" + values + ") RETURNING instance_id"
-        );
-
+        // Fixed column list, absent values are bound as NULL.
+        pqxx::work wrk(*c);
+        pqxx::result res = execPrepared(wrk, "insert_instance", instance_id, instance_name, inst_type,
+                                             webhook_url, waba_id, token, phone_number_id);
         wrk.commit();
         if (res.empty()) {
             apiLogger.error("Falha ao inserir instância no banco de dados");
@@ -123,13 +358,14 @@ Status Database::insertInstance(const std::string &instance_id, const std::strin
             stat.status_code = c_status::ERR;
             return stat;
         }
-        apiLogger.info("Instância inserida com sucesso: " + instance_id);
+        apiLogger.info("Instância inserida com sucesso: {}", instance_id);
         stat.status_code = c_status::OK;
         stat.status_string = "Successfully inserted instance into the db!\n";
         return stat;
 
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao inserir instância: " + std::string(e.what()));
+        invalidateOn(e);
+        apiLogger.error("Erro ao inserir instância: {}", e.what());
         stat.status_string = e.what();
         stat.status_code = c_status::ERR;
         return stat;
@@ -146,11 +382,7 @@ Status Database::insertLog(const std::string& log_level, const std::string& log_
         }
 
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "INSERT INTO logs (log_level, log_text) VALUES (" +
-            wrk.quote(log_level) + ", " +
-            wrk.quote(log_text) + ") RETURNING id"
-        );
+        pqxx::result res = execPrepared(wrk, "insert_log", log_level, log_text);
         wrk.commit();
         if (res.empty()) {
             stat.status_string = "Couldn't insert the log into the db...\n";
@@ -162,6 +394,7 @@ Status Database::insertLog(const std::string& log_level, const std::string& log_
         return stat;
 
     } catch (const std::exception& e) {
+        invalidateOn(e);
         stat.status_string = e.what();
         stat.status_code = c_status::ERR;
         return stat;
@@ -177,12 +410,7 @@ Status Database::createInstance_w(std::string inst_token, std::string inst_name)
         }
 
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "INSERT INTO users (name, token, id) VALUES (" +
-            wrk.quote(inst_name) + ", " +
-            wrk.quote(inst_token) + ", " +
-            wrk.quote(inst_token) + ") RETURNING id"
-        );
+        pqxx::result res = execPrepared(wrk, "create_user_w", inst_name, inst_token);
         wrk.commit();
         if (res.empty()) {
             stat.status_string = "Couldn't insert the instance into the db...\n";
@@ -194,6 +422,7 @@ Status Database::createInstance_w(std::string inst_token, std::string inst_name)
         return stat;
 
     } catch (const std::exception& e) {
+        invalidateOn(e);
         stat.status_string = e.what();
         stat.status_code = c_status::ERR;
         return stat;
@@ -211,13 +440,7 @@ std::optional<std::string> Database::getQrCodeFromDB(const std::string& token) c
 
         pqxx::work wrk(*c);
 
-        std::string sql_query = "SELECT qrcode FROM users WHERE id = " +
-                               wrk.quote(token) + " OR token = " +
-                               wrk.quote(token) + " LIMIT 1";
-
-        std::cout << "Executando SQL: " << sql_query << std::endl;
-
-        pqxx::result res = wrk.exec(sql_query);
+        pqxx::result res = execPrepared(wrk, "qrcode_w", token);
         wrk.commit();
 
         std::cout << "Consulta executada, número de linhas: " << res.size() << std::endl;
@@ -237,6 +460,7 @@ std::optional<std::string> Database::getQrCodeFromDB(const std::string& token) c
 
         return qrcode;
     } catch (const std::exception& e) {
+        invalidateOn(e);
         std::cerr << "Erro ao recuperar QR Code: " << e.what() << std::endl;
         return std::nullopt;
     }
@@ -253,11 +477,7 @@ Status Database::insertWebhook_w(std::string inst_token, std::string webhook_url
         }
 
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "UPDATE users SET webhook = " +
-            wrk.quote(webhook_url) + " WHERE id = " +
-            wrk.quote(inst_token)
-        );
+        pqxx::result res = execPrepared(wrk, "update_webhook_w", webhook_url, inst_token);
         wrk.commit();
         if (res.empty()) {
             stat.status_string = "Couldn't update the webhook on the db...\n";
@@ -269,6 +489,7 @@ Status Database::insertWebhook_w(std::string inst_token, std::string webhook_url
         return stat;
 
     } catch (const std::exception& e) {
+        invalidateOn(e);
         stat.status_string = e.what();
         stat.status_code = c_status::ERR;
         return stat;
@@ -276,7 +497,7 @@ Status Database::insertWebhook_w(std::string inst_token, std::string webhook_url
 }
 
 Status Database::deleteInstance(const std::string &instance_id) {
-    apiLogger.info("Iniciando exclusão da instância: " + instance_id);
+    apiLogger.info("Iniciando exclusão da instância: {}", instance_id);
     Status stat;
     try {
         if (!c || !c->is_open()) {
@@ -287,105 +508,118 @@ Status Database::deleteInstance(const std::string &instance_id) {
         }
 
         pqxx::work wrk(*c);
-        std::string query = "DELETE FROM instances WHERE instance_id = " + wrk.quote(instance_id);
-        apiLogger.debug("Executando query: " + query);
-
-        pqxx::result res = wrk.exec(query);
+        pqxx::result res = execPrepared(wrk, "delete_instance", instance_id);
         wrk.commit();
 
-        apiLogger.info("Instância excluída com sucesso: " + instance_id);
+        apiLogger.info("Instância excluída com sucesso: {}", instance_id);
         stat.status_code = c_status::OK;
         stat.status_string = "Successfully deleted the instance from the db!\n";
         return stat;
 
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao excluir instância: " + std::string(e.what()));
+        invalidateOn(e);
+        apiLogger.error("Erro ao excluir instância: {}", e.what());
         stat.status_string = e.what();
         stat.status_code = c_status::ERR;
         return stat;
     }
 }
 
-std::vector<Database::Instance> Database::retrieveInstances() {
-    apiLogger.debug("Buscando instâncias.");
-    std::vector<Instance> instVec;
+Status Database::updateWebhook(const std::string &instance_id, const std::string &webhook_url) {
+    Status stat;
     try {
         if (!c || !c->is_open()) {
             apiLogger.error("Conexão com banco de dados não está aberta");
-            return instVec;
+            stat.status_string = "DB connection is not open, returning error...\n";
+            stat.status_code = c_status::ERR;
+            return stat;
         }
+
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "SELECT instance_id, name, instance_type, is_active, webhook_url, waba_id, access_token, phone_number_id FROM instances"
-        );
+        execPrepared(wrk, "update_webhook", instance_id, webhook_url);
         wrk.commit();
-        if (res.empty()) {
-            apiLogger.debug("Nenhuma instância encontrada.");
-            return instVec;
-        }
 
-        for (const auto& row : res) {
-            Instance inst;
-            inst.instance_id = row[0].as<std::string>();
-            inst.instance_name = row[1].as<std::string>();
-            inst.instance_type = row[2].as<std::string>();
-            inst.is_active = row[3].as<bool>();
-
-            if (!row[4].is_null()) {
-                inst.webhook_url = row[4].as<std::string>();
-            }
+        stat.status_code = c_status::OK;
+        stat.status_string = "Successfully updated the webhook on the db!\n";
+        return stat;
 
-            if (!row[5].is_null()) {
-                inst.waba_id = row[5].as<std::string>();
-            }
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao atualizar webhook da instância: {}", e.what());
+        stat.status_string = e.what();
+        stat.status_code = c_status::ERR;
+        return stat;
+    }
+}
 
-            if (!row[6].is_null()) {
-                inst.access_token = row[6].as<std::string>();
-            }
+std::optional<Database::InstancePage> Database::retrieveInstances(const InstanceQuery& query) {
+    apiLogger.debug("Buscando instâncias após '{}' (limite {}).", query.after, query.limit);
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+        const auto limit = static_cast<long long>(query.limit);
+        pqxx::work wrk(*c);
+        pqxx::result res;
+        if (query.type.has_value() && query.active.has_value()) {
+            res = execPrepared(wrk, "instances_page_type_active", query.after, limit, std::string(apiTypeName(query.type.value())), query.active.value());
+        } else if (query.type.has_value()) {
+            res = execPrepared(wrk, "instances_page_type", query.after, limit, std::string(apiTypeName(query.type.value())));
+        } else if (query.active.has_value()) {
+            res = execPrepared(wrk, "instances_page_active", query.after, limit, query.active.value());
+        } else {
+            res = execPrepared(wrk, "instances_page", query.after, limit);
+        }
+        wrk.commit();
 
-            if (!row[7].is_null()) {
-                inst.phone_number_id = row[7].as<std::string>();
+        InstancePage page;
+        page.instances.reserve(res.size());
+        for (const auto& row : res) {
+            auto inst = fromRow(row);
+            if (!inst.has_value()) {
+                continue;
             }
-
-            apiLogger.debug("Instância encontrada: " + inst.instance_name + " (ID: " + inst.instance_id + ")");
-            instVec.push_back(inst);
+            page.instances.push_back(std::move(inst.value()));
+        }
+        // A full page may be followed by more rows; the cursor is the last row read, even if it was skipped.
+        if (!res.empty() && static_cast<std::size_t>(res.size()) >= query.limit) {
+            page.next_after = res[res.size() - 1][0].as<std::string>();
         }
 
-        apiLogger.info("Recuperadas " + std::to_string(instVec.size()) + " instâncias do banco de dados");
-        return instVec;
+        apiLogger.debug("Recuperadas {} instâncias do banco de dados", page.instances.size());
+        return page;
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao buscar instâncias: " + std::string(e.what()));
-        return instVec;
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar instâncias: {}", e.what());
+        return std::nullopt;
     }
 }
 
-std::unique_ptr<pqxx::connection> *Database::getConn() {
-    return &c;
+pqxx::connection *Database::getConn() {
+    return c.get();
 }
 
 bool Database::fetchIsActive_e(std::string inst_id, Database& db) {
     apiLogger.debug("Buscando instância dentro da evolution...");
     try {
-        auto* conn = db.getConn();
-        if (!conn || !(*conn) || !(*conn)->is_open()) {
+        pqxx::connection* conn = db.getConn();
+        if (!conn || !conn->is_open()) {
             apiLogger.error("Conexão com banco de dados não está aberta");
             return false;
         }
 
-        pqxx::work wrk(*(*conn));
-        pqxx::result res;
-        res = wrk.exec(
-            "SELECT \"connectionStatus\" FROM \"Instance\" WHERE token = " + wrk.quote(inst_id)
-        );
+        pqxx::work wrk(*conn);
+        pqxx::result res = execPrepared(wrk, "connection_state_e", inst_id);
         wrk.commit();
 
         if (res.empty()) {
-            apiLogger.debug("Nenhuma instância encontrada no Evolution database para: " + inst_id);
+            apiLogger.debug("Nenhuma instância encontrada no Evolution database para: {}", inst_id);
             return false;
         }
 
         std::string resp = res[0][0].as<std::string>();
-        apiLogger.debug("Estado da instância no Evolution: " + resp);
+        apiLogger.debug("Estado da instância no Evolution: {}", resp);
 
         if (resp == "open" || resp == "connecting") {
             return true;
@@ -394,21 +628,130 @@ bool Database::fetchIsActive_e(std::string inst_id, Database& db) {
         }
 
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao buscar instância no Evolution DB: " + std::string(e.what()));
+        db.invalidateOn(e);
+        apiLogger.error("Erro ao buscar instância no Evolution DB: {}", e.what());
         return false;
     }
 }
 
-bool Database::isActive(const ApiType &instance_type, std::string inst_id, Database& db) {
-    apiLogger.debug("Verificando se instância está ativa: " + inst_id);
-    bool is_active = false;
-    if (instance_type == ApiType::EVOLUTION) {
-        is_active = fetchIsActive_e(inst_id, db);
-    } else if (instance_type == ApiType::CLOUD) {
-        is_active = true;
-    } else if (instance_type == ApiType::WUZAPI) {
-        is_active = true;
+std::optional<std::vector<Database::ActiveState>> Database::fetchActiveStates() const {
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+
+        pqxx::work wrk(*c);
+        pqxx::result res = execPrepared(wrk, "active_states");
+        wrk.commit();
+
+        std::vector<ActiveState> states;
+        states.reserve(res.size());
+        for (const auto& row : res) {
+            if (auto type = parseApiType(row[1].as<std::string>()); type.has_value()) {
+                states.push_back(ActiveState{row[0].as<std::string>(), type.value(), !row[2].is_null() && row[2].as<bool>()});
+            }
+        }
+        return states;
+
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar status das instâncias: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+std::optional<std::unordered_map<std::string, bool>> Database::fetchConnectionStates_e() const {
+    return fetchConnectionStates_e(std::nullopt);
+}
+
+std::optional<std::unordered_map<std::string, bool>> Database::fetchConnectionStates_e(const std::vector<std::string>& tokens) const {
+    if (tokens.empty()) {
+        return std::unordered_map<std::string, bool>{};
+    }
+    return fetchConnectionStates_e(std::optional<std::vector<std::string>>(tokens));
+}
+
+std::optional<std::unordered_map<std::string, bool>> Database::fetchConnectionStates_e(const std::optional<std::vector<std::string>>& tokens) const {
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+
+        pqxx::work wrk(*c);
+        pqxx::result res = tokens.has_value()
+            ? execPrepared(wrk, "connection_states_for_e", toArrayLiteral(tokens.value()))
+            : execPrepared(wrk, "connection_states_e");
+        wrk.commit();
+
+        std::unordered_map<std::string, bool> states;
+        states.reserve(res.size());
+        for (const auto& row : res) {
+            if (row[0].is_null()) {
+                continue;
+            }
+            std::string status = row[1].is_null() ? "" : row[1].as<std::string>();
+            states[row[0].as<std::string>()] = status == "open" || status == "connecting";
+        }
+        return states;
+
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar estados das instâncias no Evolution DB: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+Status Database::updateActiveStates(const std::vector<std::pair<std::string, bool>>& states) {
+    Status stat;
+    if (states.empty()) {
+        stat.status_code = c_status::OK;
+        stat.status_string = "Nothing to update";
+        return stat;
+    }
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            stat.status_string = "DB connection is not open, returning error...\n";
+            stat.status_code = c_status::ERR;
+            return stat;
+        }
+
+        std::vector<std::string> ids;
+        std::string flags = "{";
+        ids.reserve(states.size());
+        for (const auto& [instance_id, is_active] : states) {
+            ids.push_back(instance_id);
+            if (flags.size() > 1) {
+                flags += ',';
+            }
+            flags += is_active ? 't' : 'f';
+        }
+        flags += '}';
+
+        pqxx::work wrk(*c);
+        execPrepared(wrk, "update_active_states", toArrayLiteral(ids), flags);
+        wrk.commit();
+
+        apiLogger.info("Status de atividade atualizado para {} instâncias", states.size());
+        stat.status_code = c_status::OK;
+        stat.status_string = "Successfully updated the instance states!\n";
+        return stat;
+
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao atualizar status das instâncias: {}", e.what());
+        stat.status_string = e.what();
+        stat.status_code = c_status::ERR;
+        return stat;
     }
+}
+
+bool Database::isActive(const ApiType &instance_type, std::string inst_id, Database& db) {
+    apiLogger.debug("Verificando se instância está ativa: {}", inst_id);
+    // Only Evolution exposes a connection state, the other providers are always considered active.
+    bool is_active = instance_type == ApiType::EVOLUTION ? fetchIsActive_e(inst_id, db) : true;
 
     try {
         if (!c || !c->is_open()) {
@@ -417,9 +760,7 @@ bool Database::isActive(const ApiType &instance_type, std::string inst_id, Datab
         }
 
         pqxx::work wrk(*c);
-        pqxx::result res = wrk.exec(
-            "SELECT is_active FROM instances WHERE instance_id = " + wrk.quote(inst_id)
-        );
+        pqxx::result res = execPrepared(wrk, "instance_is_active", inst_id);
 
         if (res.empty()) {
             apiLogger.debug("Nenhuma instância encontrada no banco principal.");
@@ -429,9 +770,8 @@ bool Database::isActive(const ApiType &instance_type, std::string inst_id, Datab
         bool current_is_active = res[0][0].as<bool>();
 
         if (current_is_active != is_active) {
-            apiLogger.info("Atualizando status de atividade da instância: " + inst_id + " para " + (is_active ? "ativo" : "inativo"));
-            wrk.exec("UPDATE instances SET is_active = " + std::string(is_active ? "true" : "false") +
-                     " WHERE instance_id = " + wrk.quote(inst_id));
+            apiLogger.info("Atualizando status de atividade da instância: {} para {}", inst_id, (is_active ? "ativo" : "inativo"));
+            execPrepared(wrk, "set_instance_active", inst_id, is_active);
             wrk.commit();
         } else {
             wrk.abort();
@@ -440,7 +780,175 @@ bool Database::isActive(const ApiType &instance_type, std::string inst_id, Datab
         return is_active;
 
     } catch (const std::exception& e) {
-        apiLogger.error("Erro ao verificar/atualizar status da instância: " + std::string(e.what()));
+        invalidateOn(e);
+        apiLogger.error("Erro ao verificar/atualizar status da instância: {}", e.what());
         return is_active;
     }
 }
+
+std::optional<long long> Database::enqueueMessage(const std::string& instance_id, const std::string& number, const std::string& type, std::string_view body, const std::optional<std::string>& callback_url) {
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+        pqxx::work wrk(*c);
+        pqxx::result res = execPrepared(wrk, "outbox_insert", instance_id, number, type, std::string(body), callback_url);
+        wrk.commit();
+        if (res.empty()) {
+            return std::nullopt;
+        }
+        return res[0][0].as<long long>();
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao enfileirar mensagem: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+std::optional<Database::OutboxMessage> Database::claimMessage(int lease_s) {
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+        pqxx::work wrk(*c);
+        pqxx::result res = execPrepared(wrk, "outbox_claim", lease_s);
+        wrk.commit();
+        if (res.empty()) {
+            return std::nullopt;
+        }
+        const auto& row = res[0];
+        OutboxMessage msg;
+        msg.id = row[0].as<long long>();
+        msg.instance_id = row[1].as<std::string>();
+        msg.number = row[2].as<std::string>();
+        msg.type = row[3].as<std::string>();
+        msg.body = row[4].as<std::string>();
+        if (!row[5].is_null()) {
+            msg.callback_url = row[5].as<std::string>();
+        }
+        msg.status = "sending";
+        msg.attempts = row[6].as<int>();
+        return msg;
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar mensagens pendentes: {}", e.what());
+        return std::nullopt;
+    }
+}
+
+Status Database::execOutboxUpdate(const char* statement, long long id, const std::string& text, std::optional<int> delay_s) {
+    Status stat;
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return Status{c_status::ERR, "DB connection is not open"};
+        }
+        pqxx::work wrk(*c);
+        if (delay_s.has_value()) {
+            Database::execPrepared(wrk, statement, id, text, delay_s.value());
+        } else {
+            Database::execPrepared(wrk, statement, id, text);
+        }
+        wrk.commit();
+        stat.status_code = c_status::OK;
+        stat.status_string = "Outbox updated";
+        return stat;
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao atualizar mensagem {} da fila: {}", id, e.what());
+        stat.status_code = c_status::ERR;
+        stat.status_string = e.what();
+        return stat;
+    }
+}
+
+Status Database::markMessageSent(long long id, const std::string& result) {
+    return execOutboxUpdate("outbox_sent", id, result, std::nullopt);
+}
+
+Status Database::markMessageRetry(long long id, const std::string& error, int delay_s) {
+    return execOutboxUpdate("outbox_retry", id, error, delay_s);
+}
+
+Status Database::deferMessage(long long id, const std::string& reason, int delay_s) {
+    return execOutboxUpdate("outbox_defer", id, reason, delay_s);
+}
+
+Status Database::markMessageFailed(long long id, const std::string& error) {
+    return execOutboxUpdate("outbox_failed", id, error, std::nullopt);
+}
+
+std::optional<Database::OutboxMessage> Database::fetchMessage(long long id) const {
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return std::nullopt;
+        }
+        pqxx::work wrk(*c);
+        pqxx::result res = execPrepared(wrk, "outbox_fetch", id);
+        wrk.commit();
+        if (res.empty()) {
+            return std::nullopt;
+        }
+        const auto& row = res[0];
+        OutboxMessage msg;
+        msg.id = row[0].as<long long>();
+        msg.instance_id = row[1].as<std::string>();
+        msg.number = row[2].as<std::string>();
+        msg.type = row[3].as<std::string>();
+        if (!row[4].is_null()) {
+            msg.callback_url = row[4].as<std::string>();
+        }
+        msg.status = row[5].as<std::string>();
+        msg.attempts = row[6].as<int>();
+        if (!row[7].is_null()) {
+            msg.last_error = row[7].as<std::string>();
+        }
+        if (!row[8].is_null()) {
+            msg.result = row[8].as<std::string>();
+        }
+        msg.created_at = row[9].as<std::string>();
+        msg.updated_at = row[10].as<std::string>();
+        return msg;
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao buscar mensagem {} da fila: {}", id, e.what());
+        return std::nullopt;
+    }
+}
+
+Status Database::insertDeadLetters(const std::vector<DeadLetter>& letters) {
+    Status stat;
+    if (letters.empty()) {
+        return Status{c_status::OK, "Nothing to insert"};
+    }
+    try {
+        if (!c || !c->is_open()) {
+            apiLogger.error("Conexão com banco de dados não está aberta");
+            return Status{c_status::ERR, "DB connection is not open"};
+        }
+        std::vector<std::string> instance_ids, urls, payloads, attempts, errors;
+        for (const auto& letter : letters) {
+            instance_ids.push_back(letter.instance_id);
+            urls.push_back(letter.url);
+            payloads.push_back(letter.payload);
+            attempts.push_back(std::to_string(letter.attempts));
+            errors.push_back(letter.last_error);
+        }
+        pqxx::work wrk(*c);
+        execPrepared(wrk, "webhook_dead_letters", toArrayLiteral(instance_ids), toArrayLiteral(urls), toArrayLiteral(payloads),
+                     toArrayLiteral(attempts), toArrayLiteral(errors));
+        wrk.commit();
+        stat.status_code = c_status::OK;
+        stat.status_string = "Dead letters inserted";
+        return stat;
+    } catch (const std::exception& e) {
+        invalidateOn(e);
+        apiLogger.error("Erro ao gravar {} webhooks não entregues: {}", letters.size(), e.what());
+        stat.status_code = c_status::ERR;
+        stat.status_string = e.what();
+        return stat;
+    }
+}
@@ -2,18 +2,31 @@
 
 #include <pqxx/pqxx>
 #include "../constants.h"
+#include "connection_pool.h"
+#include "metrics/metrics.h"
+#include <chrono>
 #include <iostream>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class Database {
 private:
-    std::unique_ptr<pqxx::connection> c;
+    // Mutable so const queries can still mark the connection broken.
+    mutable ConnectionPool::Lease c;
     bool fetchIsActive_e(std::string inst_id, Database& db);
+    // Called from every query's catch block: after a libpqxx failure (lost connection, SQL error,
+    // statement missing) the connection is closed on release instead of being handed out again.
+    void invalidateOn(const std::exception& e) const;
+    Status execOutboxUpdate(const char* statement, long long id, const std::string& text, std::optional<int> delay_s);
+    std::optional<std::unordered_map<std::string, bool>> fetchConnectionStates_e(const std::optional<std::vector<std::string>>& tokens) const;
 public:
     typedef struct {
         std::string instance_id;
         std::string instance_name;
-        std::string instance_type;
+        ApiType instance_type{};
         bool is_active{};
         std::optional<std::string> webhook_url;
         std::optional<std::string> waba_id;
@@ -21,19 +34,110 @@ public:
         std::optional<std::string> phone_number_id;
     } Instance;
 
+    typedef struct {
+        std::string instance_id;
+        ApiType instance_type;
+        bool is_active;
+    } ActiveState;
+
+    // A row of wasolution_outbox. fetchMessage() leaves body empty.
+    typedef struct {
+        long long id{};
+        std::string instance_id;
+        std::string number;
+        std::string type;
+        std::string body;
+        std::optional<std::string> callback_url;
+        std::string status;
+        int attempts{};
+        std::optional<std::string> last_error;
+        std::optional<std::string> result;
+        std::string created_at;
+        std::string updated_at;
+    } OutboxMessage;
+
+    // Filters and keyset cursor for listing instances in instance_id order.
+    typedef struct {
+        std::optional<ApiType> type;
+        std::optional<bool> active;
+        // Exclusive: the page starts after this instance_id; empty for the first page.
+        std::string after;
+        std::size_t limit;
+    } InstanceQuery;
+
+    typedef struct {
+        std::vector<Instance> instances;
+        // The `after` of the next page, empty when this one was the last.
+        std::string next_after;
+    } InstancePage;
+
+    // A webhook event that could not be forwarded, kept in wasolution_webhook_dead_letters.
+    typedef struct {
+        std::string instance_id;
+        std::string url;
+        std::string payload;
+        int attempts;
+        std::string last_error;
+    } DeadLetter;
+
+    // Column list matching fromRow(), shared by every query that loads instances.
+    static const char* const instance_columns;
+    // Empty, with a warning, for rows whose instance_type is not a known provider.
+    static std::optional<Instance> fromRow(const pqxx::row& row);
+    // Registers the named statements used against db_url; called once for every new pooled connection.
+    static void prepareStatements(pqxx::connection& conn, const std::string& db_url);
+    // Postgres array literal for binding a list as a single text[] parameter.
+    static std::string toArrayLiteral(const std::vector<std::string>& values);
+    // exec_prepared, timed into the per-statement latency histogram.
+    template <typename Transaction, typename... Args>
+    static pqxx::result execPrepared(Transaction& tx, const char* statement, Args&&... args) {
+        auto started = std::chrono::steady_clock::now();
+        try {
+            pqxx::result res = tx.exec_prepared(statement, std::forward<Args>(args)...);
+            Metrics::instance().observeDb(statement, true, Metrics::secondsSince(started));
+            return res;
+        } catch (...) {
+            Metrics::instance().observeDb(statement, false, Metrics::secondsSince(started));
+            throw;
+        }
+    }
+
     bool isActive(const ApiType &instance_type, std::string inst_id, Database& db);
-    std::unique_ptr<pqxx::connection> *getConn();
+    std::optional<std::vector<ActiveState>> fetchActiveStates() const;
+    // Every Evolution instance token mapped to whether it is connected, in a single query.
+    std::optional<std::unordered_map<std::string, bool>> fetchConnectionStates_e() const;
+    // Same, restricted to the given tokens with a single token = ANY($1) query.
+    std::optional<std::unordered_map<std::string, bool>> fetchConnectionStates_e(const std::vector<std::string>& tokens) const;
+    // Writes all the given is_active flags with one UPDATE ... FROM unnest($1::text[], $2::bool[]) statement.
+    Status updateActiveStates(const std::vector<std::pair<std::string, bool>>& states);
+    pqxx::connection *getConn();
     Database() = default;
     Status connect(const std::string& db_url);
+    // Gives the borrowed connection back to the pool, e.g. before a slow upstream call.
+    void disconnect();
     std::optional<Instance> fetchInstance(const std::string& instance_id) const;
     Status insertInstance(const std::string& instance_id, const std::string& instance_name, const ApiType& instance_type, std::optional<std::string> webhook_url, std::optional<std::string> waba_id, std::optional<std::string> token, std::optional<std::string> phone_number_id);
     Status insertLog(const std::string& log_level, const std::string& log_text) const;
     Status deleteInstance(const std::string& instance_id);
+    Status updateWebhook(const std::string& instance_id, const std::string& webhook_url);
     std::optional<std::string> getQrCodeFromDB(const std::string& token) const;
     /* Some Wuzapi operations have to be done directly on the database, if someone
        with more knowledge about the api can fix this, I'd be glad to remove any
        api code from the database class.*/
     Status createInstance_w(std::string inst_token, std::string inst_name);
     Status insertWebhook_w(std::string inst_token, std::string webhook_url);
-    std::vector<Instance> retrieveInstances();
+    // One page, nullopt on database errors. `active` filters on the stored is_active column.
+    std::optional<InstancePage> retrieveInstances(const InstanceQuery& query);
+
+    std::optional<long long> enqueueMessage(const std::string& instance_id, const std::string& number, const std::string& type, std::string_view body, const std::optional<std::string>& callback_url);
+    // Takes the oldest due message for lease_s seconds, skipping rows other dispatchers hold.
+    std::optional<OutboxMessage> claimMessage(int lease_s);
+    Status markMessageSent(long long id, const std::string& result);
+    Status markMessageRetry(long long id, const std::string& error, int delay_s);
+    // Back to the queue for delay_s without counting the claim as an attempt.
+    Status deferMessage(long long id, const std::string& reason, int delay_s);
+    Status markMessageFailed(long long id, const std::string& error);
+    std::optional<OutboxMessage> fetchMessage(long long id) const;
+    // All rows in one INSERT ... SELECT FROM unnest(...).
+    Status insertDeadLetters(const std::vector<DeadLetter>& letters);
 };
\ No newline at end of file
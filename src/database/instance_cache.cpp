@@ -0,0 +1,201 @@
+#include "instance_cache.h"
+#include "logger/logger.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+extern Logger apiLogger;
+
+namespace {
+
+// Installed once per database; replicas serialise on the advisory lock.
+const char* const trigger_sql = R"SQL(
+SELECT pg_advisory_xact_lock(hashtext('wasolution_instances_notify'));
+
+CREATE OR REPLACE FUNCTION wasolution_notify_instance_change() RETURNS trigger AS $$
+BEGIN
+    IF TG_OP = 'DELETE' THEN
+        PERFORM pg_notify('wasolution_instances', OLD.instance_id::text);
+        RETURN OLD;
+    END IF;
+    IF TG_OP = 'UPDATE' THEN
+        IF NEW IS NOT DISTINCT FROM OLD THEN
+            RETURN NEW;
+        END IF;
+        IF NEW.instance_id IS DISTINCT FROM OLD.instance_id THEN
+            PERFORM pg_notify('wasolution_instances', OLD.instance_id::text);
+        END IF;
+    END IF;
+    PERFORM pg_notify('wasolution_instances', NEW.instance_id::text);
+    RETURN NEW;
+END;
+$$ LANGUAGE plpgsql;
+
+DO $$
+BEGIN
+    IF NOT EXISTS (SELECT 1 FROM pg_trigger WHERE tgname = 'wasolution_instances_notify' AND NOT tgisinternal) THEN
+        CREATE TRIGGER wasolution_instances_notify
+            AFTER INSERT OR UPDATE OR DELETE ON instances
+            FOR EACH ROW EXECUTE PROCEDURE wasolution_notify_instance_change();
+    END IF;
+END
+$$;
+)SQL";
+
+// Payloads are only collected here, the rows are re-read once await_notification returns.
+class InstanceReceiver : public pqxx::notification_receiver {
+public:
+    InstanceReceiver(pqxx::connection& conn, std::vector<std::string>& pending)
+        : pqxx::notification_receiver(conn, InstanceCache::channel), pending_(pending) {}
+
+    void operator()(const std::string& payload, int) override {
+        pending_.push_back(payload);
+    }
+
+private:
+    std::vector<std::string>& pending_;
+};
+
+} // namespace
+
+InstanceCache& InstanceCache::instance() {
+    static InstanceCache cache;
+    return cache;
+}
+
+InstanceCache::~InstanceCache() {
+    stopping_ = true;
+    if (listener_.joinable()) {
+        listener_.join();
+    }
+}
+
+void InstanceCache::start(const std::string& db_url) {
+    if (listener_.joinable()) {
+        return;
+    }
+    db_url_ = db_url;
+    listener_ = std::thread([this] { listen(); });
+}
+
+InstanceCache::Shard& InstanceCache::shardFor(const std::string& instance_id) {
+    return shards_[std::hash<std::string>{}(instance_id) % shard_count];
+}
+
+const InstanceCache::Shard& InstanceCache::shardFor(const std::string& instance_id) const {
+    return shards_[std::hash<std::string>{}(instance_id) % shard_count];
+}
+
+std::optional<Database::Instance> InstanceCache::get(const std::string& instance_id) const {
+    const Shard& shard = shardFor(instance_id);
+    std::shared_lock<std::shared_mutex> lock(shard.mtx);
+    auto it = shard.entries.find(instance_id);
+    if (it == shard.entries.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::optional<Database::Instance> InstanceCache::fetch(const std::string& instance_id, const Database& db) {
+    if (authoritative_.load(std::memory_order_acquire)) {
+        return get(instance_id);
+    }
+    return db.fetchInstance(instance_id);
+}
+
+void InstanceCache::put(const Database::Instance& instance) {
+    Shard& shard = shardFor(instance.instance_id);
+    std::unique_lock<std::shared_mutex> lock(shard.mtx);
+    shard.entries.insert_or_assign(instance.instance_id, instance);
+}
+
+void InstanceCache::erase(const std::string& instance_id) {
+    Shard& shard = shardFor(instance_id);
+    std::unique_lock<std::shared_mutex> lock(shard.mtx);
+    shard.entries.erase(instance_id);
+}
+
+void InstanceCache::installTrigger(pqxx::connection& conn) {
+    pqxx::work wrk(conn);
+    wrk.exec(trigger_sql);
+    wrk.commit();
+}
+
+void InstanceCache::reload(pqxx::connection& conn) {
+    std::array<std::unordered_map<std::string, Database::Instance>, shard_count> fresh;
+    std::size_t count = 0;
+    {
+        pqxx::nontransaction ntx(conn);
+        pqxx::result res = Database::execPrepared(ntx, "all_instances");
+        for (const auto& row : res) {
+            auto inst = Database::fromRow(row);
+            if (!inst.has_value()) {
+                continue;
+            }
+            std::size_t idx = std::hash<std::string>{}(inst->instance_id) % shard_count;
+            fresh[idx].insert_or_assign(inst->instance_id, std::move(inst.value()));
+            ++count;
+        }
+    }
+    for (std::size_t i = 0; i < shard_count; ++i) {
+        std::unique_lock<std::shared_mutex> lock(shards_[i].mtx);
+        shards_[i].entries.swap(fresh[i]);
+    }
+    apiLogger.info("Cache de instâncias carregado com {} instâncias", count);
+}
+
+void InstanceCache::refresh(pqxx::connection& conn, std::vector<std::string>& pending) {
+    std::sort(pending.begin(), pending.end());
+    pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+    pqxx::nontransaction ntx(conn);
+    for (const auto& instance_id : pending) {
+        pqxx::result res = Database::execPrepared(ntx, "fetch_instance", instance_id);
+        if (res.empty()) {
+            erase(instance_id);
+            apiLogger.debug("Instância removida do cache: {}", instance_id);
+        } else if (auto inst = Database::fromRow(res[0]); inst.has_value()) {
+            put(std::move(inst.value()));
+            apiLogger.debug("Instância atualizada no cache: {}", instance_id);
+        } else {
+            erase(instance_id);
+        }
+    }
+    pending.clear();
+}
+
+void InstanceCache::listen() {
+    auto backoff = std::chrono::seconds(1);
+    while (!stopping_) {
+        try {
+            pqxx::connection conn(db_url_);
+            Database::prepareStatements(conn, db_url_);
+            installTrigger(conn);
+
+            // LISTEN before loading, so changes committed during the load are not lost.
+            std::vector<std::string> pending;
+            InstanceReceiver receiver(conn, pending);
+            reload(conn);
+            authoritative_.store(true, std::memory_order_release);
+            backoff = std::chrono::seconds(1);
+            apiLogger.info("Escutando alterações de instâncias no canal {}", std::string(channel));
+
+            while (!stopping_) {
+                conn.await_notification(1, 0);
+                if (!pending.empty()) {
+                    refresh(conn, pending);
+                }
+            }
+        } catch (const std::exception& e) {
+            authoritative_.store(false, std::memory_order_release);
+            apiLogger.error("Listener do cache de instâncias falhou, usando o banco diretamente: {}", e.what());
+        }
+
+        for (auto waited = std::chrono::seconds(0); waited < backoff && !stopping_; waited += std::chrono::seconds(1)) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+        backoff = std::min(backoff * 2, std::chrono::seconds(30));
+    }
+    authoritative_.store(false, std::memory_order_release);
+}
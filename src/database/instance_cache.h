@@ -0,0 +1,66 @@
+#pragma once
+
+#include "database.h"
+#include <array>
+#include <atomic>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/* Process-wide copy of the `instances` table keyed by instance_id. It is filled
+   at startup, updated in place by the handlers that change instances and kept
+   coherent with other replicas through a trigger on `instances` that publishes
+   every change on a LISTEN/NOTIFY channel.
+
+   While the cache is warm and the listener is connected a miss is
+   authoritative. Otherwise lookups fall back to the database, so a dead
+   listener only costs performance, never correctness. */
+class InstanceCache {
+public:
+    static constexpr const char* channel = "wasolution_instances";
+
+    static InstanceCache& instance();
+
+    // Loads every row, installs the trigger and starts the LISTEN thread.
+    void start(const std::string& db_url);
+
+    std::optional<Database::Instance> get(const std::string& instance_id) const;
+    // True while a miss in get() means the instance does not exist.
+    bool authoritative() const { return authoritative_.load(std::memory_order_acquire); }
+    // Cache first, `db` (already connected) on a non-authoritative miss.
+    std::optional<Database::Instance> fetch(const std::string& instance_id, const Database& db);
+
+    void put(const Database::Instance& instance);
+    void erase(const std::string& instance_id);
+
+    InstanceCache(const InstanceCache&) = delete;
+    InstanceCache& operator=(const InstanceCache&) = delete;
+
+private:
+    static constexpr std::size_t shard_count = 16;
+
+    typedef struct {
+        mutable std::shared_mutex mtx;
+        std::unordered_map<std::string, Database::Instance> entries;
+    } Shard;
+
+    InstanceCache() = default;
+    ~InstanceCache();
+
+    Shard& shardFor(const std::string& instance_id);
+    const Shard& shardFor(const std::string& instance_id) const;
+
+    static void installTrigger(pqxx::connection& conn);
+    void listen();
+    void reload(pqxx::connection& conn);
+    void refresh(pqxx::connection& conn, std::vector<std::string>& pending);
+
+    std::array<Shard, shard_count> shards_;
+    std::string db_url_;
+    std::atomic<bool> authoritative_{false};
+    std::atomic<bool> stopping_{false};
+    std::thread listener_;
+};
@@ -0,0 +1,130 @@
+#include "instance_status.h"
+#include "database.h"
+#include "config/config.h"
+#include "logger/logger.h"
+#include <chrono>
+#include <utility>
+#include <vector>
+
+extern Logger apiLogger;
+
+InstanceStatus& InstanceStatus::instance() {
+    static InstanceStatus status;
+    return status;
+}
+
+InstanceStatus::~InstanceStatus() {
+    {
+        std::lock_guard<std::mutex> lock(run_mtx_);
+        stopping_ = true;
+    }
+    run_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void InstanceStatus::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+std::optional<bool> InstanceStatus::isActive(ApiType api_type, const std::string& instance_id) const {
+    // Only Evolution exposes a connection state, the other providers are always considered active.
+    if (api_type != ApiType::EVOLUTION) {
+        return true;
+    }
+    if (!ready_.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
+    std::shared_lock<std::shared_mutex> lock(mtx_);
+    auto it = states_.find(instance_id);
+    if (it == states_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void InstanceStatus::report(const std::string& instance_id, bool is_active) {
+    std::unique_lock<std::shared_mutex> lock(mtx_);
+    states_[instance_id] = is_active;
+}
+
+void InstanceStatus::run() {
+    while (true) {
+        try {
+            refresh();
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao atualizar status das instâncias: {}", e.what());
+        }
+
+        Config cfg;
+        auto interval = std::chrono::seconds(cfg.getEnv().instance_status_refresh_s > 0 ? cfg.getEnv().instance_status_refresh_s : 15);
+        std::unique_lock<std::mutex> lock(run_mtx_);
+        if (run_cv_.wait_for(lock, interval, [this] { return stopping_; })) {
+            return;
+        }
+    }
+}
+
+void InstanceStatus::refresh() {
+    Config cfg;
+    const auto& env = cfg.getEnv();
+
+    Database db;
+    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados: {}", connection.status_string.dump());
+        return;
+    }
+    auto rows = db.fetchActiveStates();
+    if (!rows.has_value()) {
+        return;
+    }
+
+    std::optional<std::unordered_map<std::string, bool>> evo_states;
+    if (!env.db_url_evo.empty()) {
+        Database evo_db;
+        if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
+            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: {}", evo_connection.status_string.dump());
+        } else {
+            evo_states = evo_db.fetchConnectionStates_e();
+        }
+    }
+
+    std::unordered_map<std::string, bool> fresh;
+    fresh.reserve(rows->size());
+    {
+        std::shared_lock<std::shared_mutex> lock(mtx_);
+        for (const auto& row : rows.value()) {
+            if (row.instance_type != ApiType::EVOLUTION) {
+                fresh[row.instance_id] = true;
+            } else if (evo_states.has_value()) {
+                auto it = evo_states->find(row.instance_id);
+                fresh[row.instance_id] = it != evo_states->end() && it->second;
+            } else if (auto known = states_.find(row.instance_id); known != states_.end()) {
+                // Evolution DB unavailable this round, keep what we knew.
+                fresh[row.instance_id] = known->second;
+            }
+        }
+    }
+
+    std::vector<std::pair<std::string, bool>> changed;
+    for (const auto& row : rows.value()) {
+        auto it = fresh.find(row.instance_id);
+        if (it != fresh.end() && it->second != row.is_active) {
+            changed.emplace_back(row.instance_id, it->second);
+        }
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mtx_);
+        states_.swap(fresh);
+    }
+    ready_.store(true, std::memory_order_release);
+
+    if (!changed.empty()) {
+        db.updateActiveStates(changed);
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../constants.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/* In-memory connection state of every instance. A background thread rebuilds
+   it every INSTANCE_STATUS_REFRESH_S seconds with one query on the Evolution
+   database and one on ours, and writes the is_active flags that changed in a
+   single batched UPDATE. Handlers only read the map. */
+class InstanceStatus {
+public:
+    static InstanceStatus& instance();
+
+    void start();
+
+    // Empty until the first refresh has seen the instance, callers then fall back to Database::isActive.
+    std::optional<bool> isActive(ApiType api_type, const std::string& instance_id) const;
+    // State learned from a provider call or event, persisted by the next refresh.
+    void report(const std::string& instance_id, bool is_active);
+
+    InstanceStatus(const InstanceStatus&) = delete;
+    InstanceStatus& operator=(const InstanceStatus&) = delete;
+
+private:
+    InstanceStatus() = default;
+    ~InstanceStatus();
+
+    void run();
+    void refresh();
+
+    mutable std::shared_mutex mtx_;
+    std::unordered_map<std::string, bool> states_;
+    std::atomic<bool> ready_{false};
+
+    std::mutex run_mtx_;
+    std::condition_variable run_cv_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
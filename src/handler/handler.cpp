@@ -1,194 +1,346 @@
 #include "handler.h"
 
-#include "cloud/cloud_api.h"
+#include "database/instance_cache.h"
+#include "database/instance_status.h"
+#include "outbox.h"
+#include "provider.h"
+#include "rate_limiter.h"
+#include "webhook_auth.h"
+#include "worker_pool.h"
 #include "logger/logger.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 using std::string;
 
 extern Logger apiLogger;
 
-Status Handler::sendMessage(const string &instance_id, string number, string body, MediaType type) {
-    apiLogger.info("Iniciando envio de mensagem para instância: " + instance_id);
+// Takes a pooled connection for `db` unless it already holds one.
+static Status connectOnce(Database &db, const string &db_url) {
+    if (db.getConn()) {
+        return Status{c_status::OK, nlohmann::json{{"message", "Already connected."}}};
+    }
+    auto connection = db.connect(db_url);
+    if (connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados: {}", connection.status_string.dump());
+    }
+    return connection;
+}
+
+// Cache first; `db` is connected only when the cache cannot answer a miss on its own.
+static Status lookupInstance(const string &instance_id, std::optional<Database::Instance> &inst, Database &db, const Env &env) {
+    InstanceCache& cache = InstanceCache::instance();
+    if (cache.authoritative()) {
+        inst = cache.get(instance_id);
+        return Status{c_status::OK, nlohmann::json{{"message", "Cache lookup."}}};
+    }
+    if (auto connection = connectOnce(db, env.db_url); connection.status_code == c_status::ERR) {
+        return connection;
+    }
+    inst = cache.fetch(instance_id, db);
+    return Status{c_status::OK, nlohmann::json{{"message", "Database lookup."}}};
+}
+
+// Connection state comes from InstanceStatus; the database is only queried until its first refresh.
+static bool instanceIsActive(ApiType api_type, const string &instance_id, Database &db, Database &evo_db, const Env &env) {
+    if (auto cached = InstanceStatus::instance().isActive(api_type, instance_id); cached.has_value()) {
+        return cached.value();
+    }
+    if (connectOnce(db, env.db_url).status_code == c_status::ERR) {
+        return false;
+    }
+    if (api_type == ApiType::EVOLUTION && !evo_db.getConn()) {
+        if (env.db_url_evo.empty()) {
+            apiLogger.warn("URL do banco de dados Evolution não configurada");
+        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
+            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: {}", evo_connection.status_string.dump());
+        }
+    }
+    return db.isActive(api_type, instance_id, evo_db);
+}
+
+static const char* const instance_not_found = "Couldn't get the instance from the db.";
+
+/* The lookup every instance operation starts with: the instance through the
+   cache and, when the operation needs a connected instance, its connection
+   state. A pooled connection is only taken when one of the caches misses,
+   and it is back in the pool before the caller talks to the provider. */
+static Status resolveInstance(const string &instance_id, std::optional<Database::Instance> &inst, bool must_be_active,
+                              const char *not_found = instance_not_found) {
     Config config;
     Database db;
     Database evo_db;
-    std::string instance_name;
-    Status stat;
 
-    auto env = config.getEnv();
-    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco de dados: " + connection.status_string.dump());
-        return connection;
+    const auto& env = config.getEnv();
+    if (auto lookup = lookupInstance(instance_id, inst, db, env); lookup.status_code == c_status::ERR) {
+        return lookup;
+    }
+    if (!inst.has_value()) {
+        apiLogger.error("Instância não encontrada: {}", instance_id);
+        return Status{c_status::ERR, nlohmann::json{{"error", not_found}}};
     }
+    apiLogger.debug("Instância encontrada: {} ({})", inst->instance_name, apiTypeName(inst->instance_type));
 
-    auto inst = db.fetchInstance(instance_id);
+    if (must_be_active && !instanceIsActive(inst->instance_type, instance_id, db, evo_db, env)) {
+        apiLogger.error("Instância não está ativa: {}", instance_id);
+        return Status{c_status::ERR, nlohmann::json{{"error", "Instance is not active. Please connect it first."}}};
+    }
+    return Status{c_status::OK, nlohmann::json{{"message", "Instance is ready."}}};
+}
+
+// Looks the instance up and checks that it can send. Used once per instance, also by bulk sends.
+static Status resolveSender(const string &instance_id, std::optional<Database::Instance> &inst) {
+    return resolveInstance(instance_id, inst, true, "Couldn't find any connections with this name.");
+}
 
-    if (inst.has_value()) {
-        instance_name = inst.value().instance_name;
-        apiLogger.debug("Instância encontrada: " + instance_name);
+static void logDelivery(const Provider &provider, const Status &snd) {
+    if (snd.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao enviar mensagem via {}: {}", provider.name(), snd.status_string.dump());
     } else {
-        apiLogger.error("Instância não encontrada: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't find any connections with this name."}};
-        return stat;
+        apiLogger.info("Mensagem enviada com sucesso via {}", provider.name());
     }
+}
 
-    ApiType api_type;
-    if (inst.value().instance_type == "EVOLUTION") {
-        api_type = ApiType::EVOLUTION;
-        if (env.db_url_evo.empty()) {
-            apiLogger.warn("URL do banco de dados Evolution não configurada");
-        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
-            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: " + evo_connection.status_string.dump());
+/* Hands the message to the provider once the rate limiter has a slot for it, which may be right away or from the
+   limiter thread after a short wait in the instance queue. `done` gets the refusal instead when the provider does not
+   take this message at all or the queue cannot hold it. body must outlive `done`. */
+static void deliverAsync(const Database::Instance &inst, const string &number, std::string_view body, MediaType type,
+                         std::shared_ptr<const Env> env, ResponseMode mode, StatusCallback done) {
+    const Provider& provider = Provider::of(inst.instance_type);
+    if (auto rejected = provider.rejects(type, body); rejected.has_value()) {
+        apiLogger.error("Mensagem recusada para instância {}: {}", inst.instance_id, rejected->status_string.dump());
+        done(std::move(rejected.value()));
+        return;
+    }
+
+    auto shared_done = std::make_shared<StatusCallback>(std::move(done));
+    auto send = [&provider, inst, number, body, type, env, mode, shared_done] {
+        apiLogger.info("Enviando mensagem via {}", provider.name());
+        try {
+            provider.sendAsync(inst, number, body, type, *env, mode, [&provider, shared_done](Status snd) {
+                logDelivery(provider, snd);
+                (*shared_done)(std::move(snd));
+            });
+        } catch (const std::exception& e) {
+            (*shared_done)(Status{c_status::ERR, nlohmann::json{{"error", e.what()}}});
         }
-    } else if (inst.value().instance_type == "WUZAPI") {
-        api_type = ApiType::WUZAPI;
-    } else if (inst.value().instance_type == "CLOUD") {
-        api_type = ApiType::CLOUD;
-    } else {
-        apiLogger.error("Tipo de instância desconhecido: " + inst.value().instance_type);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Unknown instance type"}};
-        return stat;
+    };
+    if (auto decision = RateLimiter::instance().schedule(inst.instance_id, string(provider.name()), std::move(send)); !decision.admitted) {
+        const int retry_after_s = static_cast<int>(std::max<long long>((decision.retry_after.count() + 999) / 1000, 1));
+        (*shared_done)(Status{c_status::ERR,
+                              nlohmann::json{{"error", "Rate limit exceeded for this instance, try again later"}, {"retry_after", retry_after_s}},
+                              {}, retry_after_s});
     }
+}
 
-    bool is_active = db.isActive(api_type, instance_id, evo_db);
-    if (!is_active) {
-        apiLogger.error("Instância não está ativa: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance is not active. Please connect it first."}};
-        return stat;
+void Handler::sendMessage(const string &instance_id, const string &number, std::string_view body, MediaType type, ResponseMode mode,
+                          StatusCallback done) {
+    apiLogger.info("Iniciando envio de mensagem para instância: {}", instance_id);
+    std::optional<Database::Instance> inst;
+
+    if (auto resolved = resolveSender(instance_id, inst); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
     }
+    deliverAsync(inst.value(), number, body, type, Config::current(), mode, std::move(done));
+}
 
-    Status snd;
+Status Handler::queueMessage(const string &instance_id, const string &number, std::string_view body, MediaType type, const std::optional<string> &callback_url) {
+    apiLogger.info("Enfileirando mensagem para instância: {}", instance_id);
+    Config config;
+    std::optional<Database::Instance> inst;
 
-    if (inst.value().instance_type == "EVOLUTION") {
-        apiLogger.info("Enviando mensagem via Evolution API");
-        snd = Evolution::sendMessage_e(number, env.evo_token, env.evo_url, type, body, instance_name);
-        if (snd.status_code == c_status::ERR) {
-            apiLogger.error("Erro ao enviar mensagem via Evolution: " + snd.status_string.dump());
-            return snd;
-        } else {
-            apiLogger.info("Mensagem enviada com sucesso via Evolution");
-            stat.status_code = c_status::OK;
-            try {
-                stat.status_string = nlohmann::json::parse(snd.status_string.dump());
-            } catch (const std::exception& e) {
-                stat.status_string = nlohmann::json{
-                    {"message", "Successfully sent the message!"},
-                    {"api_response", snd.status_string}
-                };
+    if (auto resolved = resolveSender(instance_id, inst); resolved.status_code == c_status::ERR) {
+        return resolved;
+    }
+    if (auto rejected = Provider::of(inst->instance_type).rejects(type, body); rejected.has_value()) {
+        return rejected.value();
+    }
+
+    Database db;
+    if (auto connection = db.connect(config.getEnv().db_url); connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados: {}", connection.status_string.dump());
+        return connection;
+    }
+    auto message_id = db.enqueueMessage(instance_id, number, string(mediaTypeName(type)), body, callback_url);
+    if (!message_id.has_value()) {
+        return Status{c_status::ERR, nlohmann::json{{"error", "Couldn't queue the message"}}};
+    }
+    Outbox::instance().wake();
+    apiLogger.info("Mensagem {} enfileirada para instância: {}", message_id.value(), instance_id);
+    return Status{c_status::OK, nlohmann::json{{"message_id", message_id.value()}, {"status", "queued"}}};
+}
+
+std::optional<Database::OutboxMessage> Handler::getMessage(long long message_id) {
+    Config config;
+    Database db;
+    if (auto connection = db.connect(config.getEnv().db_url); connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados: {}", connection.status_string.dump());
+        return std::nullopt;
+    }
+    return db.fetchMessage(message_id);
+}
+
+namespace {
+
+typedef struct {
+    Database::Instance inst;
+    std::vector<std::size_t> items;
+    std::size_t next;
+    std::size_t in_flight;
+} Batch;
+
+/* One /sendMessages request while its messages are out. Completions may come from any thread,
+   so everything below `mtx` is only touched under it. */
+struct Bulk {
+    std::shared_ptr<const std::vector<OutgoingMessage>> messages;
+    ResponseMode mode;
+    std::shared_ptr<const Env> env;
+    std::size_t per_instance;
+    std::size_t max_parallel;
+    Handler::StatusesCallback done;
+
+    std::mutex mtx;
+    std::vector<Status> results;
+    std::vector<Batch> batches;
+    std::size_t cursor = 0;
+    std::size_t in_flight = 0;
+    std::size_t pending = 0;
+    // Set while a thread is in pump(); a completion arriving meanwhile leaves the next start to it.
+    bool pumping = false;
+    bool reported = false;
+};
+
+// Starts messages until the limits are reached, round-robin over the instances that are still below theirs,
+// and answers once nothing is pending. Completions call it again, so no thread waits for the answers.
+void pump(const std::shared_ptr<Bulk> &bulk) {
+    std::unique_lock<std::mutex> lock(bulk->mtx);
+    if (bulk->pumping) {
+        return;
+    }
+    bulk->pumping = true;
+    while (true) {
+        Batch* batch = nullptr;
+        for (std::size_t n = 0; bulk->in_flight < bulk->max_parallel && n < bulk->batches.size() && !batch; ++n) {
+            Batch& candidate = bulk->batches[(bulk->cursor + n) % bulk->batches.size()];
+            if (candidate.next < candidate.items.size() && candidate.in_flight < bulk->per_instance) {
+                batch = &candidate;
+                bulk->cursor = (bulk->cursor + n + 1) % bulk->batches.size();
             }
-            return stat;
         }
-    } else if (inst.value().instance_type == "WUZAPI") {
-        apiLogger.info("Enviando mensagem via WuzAPI");
-        snd = Wuzapi::sendMessage_w(number, inst.value().instance_id, env.wuz_url, type, body);
-        if (snd.status_code == c_status::ERR) {
-            apiLogger.error("Erro ao enviar mensagem via WuzAPI: " + snd.status_string.dump());
-            return snd;
-        } else {
-            apiLogger.info("Mensagem enviada com sucesso via WuzAPI");
-            stat.status_code = c_status::OK;
-            try {
-                stat.status_string = nlohmann::json::parse(snd.status_string.dump());
-            } catch (const std::exception& e) {
-                stat.status_string = nlohmann::json{
-                    {"message", "Successfully sent the message!"},
-                    {"api_response", snd.status_string}
-                };
+        if (!batch) {
+            break;
+        }
+
+        std::size_t idx = batch->items[batch->next++];
+        ++batch->in_flight;
+        ++bulk->in_flight;
+        lock.unlock();
+
+        // May run right here (refusals, open circuit) or later on the engine thread.
+        auto finish = [bulk, batch, idx](Status result) {
+            {
+                std::lock_guard<std::mutex> guard(bulk->mtx);
+                bulk->results[idx] = std::move(result);
+                --batch->in_flight;
+                --bulk->in_flight;
+                --bulk->pending;
             }
-            return stat;
+            pump(bulk);
+        };
+
+        const auto& msg = (*bulk->messages)[idx];
+        try {
+            deliverAsync(batch->inst, msg.number, msg.body, msg.type, bulk->env, bulk->mode, finish);
+        } catch (const std::exception& e) {
+            finish(Status{c_status::ERR, nlohmann::json{{"error", e.what()}}});
         }
-    } else if (inst.value().instance_type == "CLOUD") {
-        apiLogger.info("Enviando mensagem via CLOUD");
-        snd = Cloud::sendMessage(instance_id, number, body, type, inst.value().phone_number_id.value(), inst.value().access_token.value());
-        if (snd.status_code == c_status::ERR) {
-            apiLogger.error("Erro ao enviar mensagem via CLOUD: " + snd.status_string.dump());
-            return snd;
-        } else {
-            apiLogger.info("Mensagem enviada com sucesso via CLOUD");
-            stat.status_code = c_status::OK;
-            try {
-                stat.status_string = nlohmann::json::parse(snd.status_string.dump());
-            } catch (const std::exception& e) {
-                stat.status_string = nlohmann::json{
-                        {"message", "Successfully sent the message!"},
-                        {"api_response", snd.status_string}
-                };
+        lock.lock();
+    }
+    bulk->pumping = false;
+    if (bulk->pending > 0 || bulk->reported) {
+        return;
+    }
+    bulk->reported = true;
+    lock.unlock();
+    bulk->done(std::move(bulk->results));
+}
+
+} // namespace
+
+void Handler::sendMessages(std::shared_ptr<const std::vector<OutgoingMessage>> messages, ResponseMode mode, StatusesCallback done) {
+    auto bulk = std::make_shared<Bulk>();
+    bulk->env = Config::current();
+    bulk->per_instance = bulk->env->bulk_instance_concurrency > 0 ? bulk->env->bulk_instance_concurrency : 1;
+    bulk->max_parallel = bulk->env->bulk_max_parallel > 0 ? bulk->env->bulk_max_parallel : 1;
+    bulk->mode = mode;
+    bulk->done = std::move(done);
+    bulk->results.resize(messages->size());
+    bulk->messages = std::move(messages);
+    const auto& queued = *bulk->messages;
+
+    // Each instance is resolved once, whatever the number of messages it has in the request.
+    std::unordered_map<string, std::vector<std::size_t>> grouped;
+    std::vector<string> order;
+    for (std::size_t i = 0; i < queued.size(); ++i) {
+        auto& items = grouped[queued[i].instance_id];
+        if (items.empty()) {
+            order.push_back(queued[i].instance_id);
+        }
+        items.push_back(i);
+    }
+
+    for (const auto& instance_id : order) {
+        std::optional<Database::Instance> inst;
+        Status resolved = resolveSender(instance_id, inst);
+        if (resolved.status_code == c_status::ERR) {
+            for (std::size_t i : grouped[instance_id]) {
+                bulk->results[i] = resolved;
             }
-            return stat;
+            continue;
         }
+        bulk->pending += grouped[instance_id].size();
+        bulk->batches.push_back(Batch{std::move(inst.value()), std::move(grouped[instance_id]), 0, 0});
     }
-    apiLogger.error("Tipo de API desconhecido para instância: " + instance_id);
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Unknown API, please choose between EVOLUTION and WUZAPI"}};
-    return stat;
+    apiLogger.info("Envio em lote: {} mensagens para {} instâncias, {} prontas para envio", queued.size(), order.size(), bulk->pending);
+
+    pump(bulk);
 }
 
-Status Handler::createInstance(const string &instance_id, const string &instance_name, ApiType api_type, std::string webhook_url, std::string proxy_url, std::string access_token, std::string waba_id) {
-    apiLogger.info("Iniciando criação de instância: " + instance_id + " (" + instance_name + ")");
-    Config config;
+// Saves what the provider created and builds the answer from what it said.
+static Status storeInstance(const Database::Instance &created, Status api_response, const Env &env) {
     Database db;
     Status stat;
-    Status api_response;
-
-    auto env = config.getEnv();
-    if (api_type == ApiType::EVOLUTION) {
-        apiLogger.info("Criando instância Evolution");
-        api_response = Evolution::createInstance_e(env.evo_token, instance_id, instance_name, env.evo_url, webhook_url, proxy_url);
-    } else if (api_type == ApiType::WUZAPI) {
-        apiLogger.info("Criando instância WuzAPI");
-        api_response = Wuzapi::createInstance_w(instance_id, instance_name, env.wuz_url, webhook_url, proxy_url, env.wuz_admin_token);
-    } else if (api_type == ApiType::CLOUD) {
-        apiLogger.info("Criando instância Cloud");
-        api_response = Cloud::registerNumber(waba_id, access_token);
-    }
-    else {
-        apiLogger.error("Tipo de API desconhecido");
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Unknown API, please choose between EVOLUTION and WUZAPI"}};
-        return stat;
-    }
-    if (api_response.status_code == c_status::ERR) {
-        apiLogger.error("Erro na criação da instância: " + api_response.status_string.dump());
-        return api_response;
-    }
 
     /*if (api_type == ApiType::EVOLUTION && !env.rabbit_url.empty()) {
-        apiLogger.info("Configurando RabbitMQ para instância Evolution: " + instance_name);
+        apiLogger.info("Configurando RabbitMQ para instância Evolution: {}", instance_name);
         Status rabbit_response = Evolution::setRabbit_e(instance_name, env.rabbit_url, env.evo_url, env.evo_token);
         if (rabbit_response.status_code == c_status::ERR) {
-            apiLogger.warn("Falha ao configurar RabbitMQ para instância: " + instance_name + " - " + rabbit_response.status_string.dump());
+            apiLogger.warn("Falha ao configurar RabbitMQ para instância: {} - {}", instance_name, rabbit_response.status_string.dump());
         } else {
-            apiLogger.info("RabbitMQ configurado com sucesso para instância: " + instance_name);
+            apiLogger.info("RabbitMQ configurado com sucesso para instância: {}", instance_name);
         }
     } */
 
     if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco principal: " + connection.status_string.dump());
+        apiLogger.error("Erro ao conectar ao banco principal: {}", connection.status_string.dump());
         return connection;
     }
-    std::string phone_number_id;
-    if (api_response.status_string.contains("id") && api_response.status_string.contains("data") && !api_response.status_string["data"].empty() &&
-        !api_response.status_string["data"][0]["id"].empty()) {
-        phone_number_id = api_response.status_string["data"][0]["id"];
-    } else {
-        phone_number_id = "";
-    }
-    auto insertion = db.insertInstance(instance_id, instance_name, api_type, webhook_url, waba_id, access_token, phone_number_id);
+    auto insertion = db.insertInstance(created.instance_id, created.instance_name, created.instance_type, created.webhook_url, created.waba_id, created.access_token, created.phone_number_id);
     if (insertion.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao inserir instância no banco principal: " + insertion.status_string.dump());
+        apiLogger.error("Erro ao inserir instância no banco principal: {}", insertion.status_string.dump());
         return insertion;
     }
-    apiLogger.info("Instância criada com sucesso: " + instance_id);
+    InstanceCache::instance().put(created);
+    apiLogger.info("Instância criada com sucesso: {}", created.instance_id);
     stat.status_code = c_status::OK;
 
-    try {
-        nlohmann::json response = nlohmann::json::parse(api_response.status_string.dump());
-        response["message"] = "Instance created successfully!";
-        stat.status_string = response;
-    } catch (const std::exception& e) {
+    if (api_response.status_string.is_object()) {
+        stat.status_string = std::move(api_response.status_string);
+        stat.status_string["message"] = "Instance created successfully!";
+    } else {
         stat.status_string = nlohmann::json{
             {"message", "Instance created successfully!"},
             {"api_response", api_response.status_string}
@@ -198,481 +350,256 @@ Status Handler::createInstance(const string &instance_id, const string &instance
     return stat;
 }
 
-Status Handler::connectInstance(string instance_id) {
-    Config config;
-    Database db;
-    Status stat;
-
-    auto env = config.getEnv();
-    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        return connection;
-    }
-
-    auto instance = db.fetchInstance(instance_id);
-    if (!instance.has_value()) {
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't get the instance from the db."}};
-        return stat;
+void Handler::createInstance(const string &instance_id, const string &instance_name, ApiType api_type, std::string webhook_url, std::string proxy_url,
+                             std::string access_token, std::string waba_id, StatusCallback done) {
+    apiLogger.info("Iniciando criação de instância: {} ({})", instance_id, instance_name);
+    auto env = Config::current();
+    const Provider& provider = Provider::of(api_type);
+
+    // Filled in further by the provider, so it has to outlive the call.
+    auto created = std::make_shared<Database::Instance>();
+    created->instance_id = instance_id;
+    created->instance_name = instance_name;
+    created->instance_type = api_type;
+    created->is_active = true;
+    created->webhook_url = webhook_url;
+    created->waba_id = waba_id;
+    created->access_token = access_token;
+    created->phone_number_id = "";
+
+    // The provider posts to our /webhook; webhook_url is only where the dispatcher forwards the events.
+    string receiver_url;
+    if (env->public_url.empty()) {
+        apiLogger.warn("PUBLIC_URL não configurada, a instância {} será criada sem webhook no provedor", instance_id);
+    } else {
+        receiver_url = WebhookAuth::receiverUrl(instance_id, env->public_url, env->token);
     }
-    if (instance.value().instance_type == "WUZAPI") {
-        Status response = Wuzapi::connectInstance_w(instance_id, env.wuz_url);
-        if (response.status_code == c_status::ERR) {
-            return response;
-        }
-
-        apiLogger.info("Instance connected successfully, fetching QR code");
-        Status qrResponse = Wuzapi::getQrCode_w(instance_id, env.wuz_url);
 
-        try {
-            if (qrResponse.status_code == c_status::OK) {
-                nlohmann::json combinedResponse = nlohmann::json::parse(qrResponse.status_string.dump());
-                combinedResponse["message"] = "Instance connected successfully!";
-                combinedResponse["connection_status"] = nlohmann::json::parse(response.status_string.dump());
-                qrResponse.status_string = combinedResponse;
-            }
-        } catch (const std::exception& e) {
-            if (qrResponse.status_code == c_status::OK) {
-                qrResponse.status_string = nlohmann::json{
-                    {"message", "Instance connected successfully!"},
-                    {"api_response", qrResponse.status_string},
-                    {"connection_status", response.status_string}
-                };
-            }
+    apiLogger.info("Criando instância {}", provider.name());
+    provider.create(*created, proxy_url, receiver_url, *env, [created, env, done = std::move(done)](Status api_response) mutable {
+        if (api_response.status_code == c_status::ERR) {
+            apiLogger.error("Erro na criação da instância: {}", api_response.status_string.dump());
+            done(std::move(api_response));
+            return;
         }
+        // The row is written from a worker, the answer may have arrived on the HttpClient thread.
+        WorkerPool::instance().submit([created, env, api_response = std::move(api_response), done = std::move(done)]() mutable {
+            done(storeInstance(*created, std::move(api_response), *env));
+        });
+    });
+}
 
-        return qrResponse;
-    } else if (instance.value().instance_type == "EVOLUTION") {
-        Status response = Evolution::connectInstance_e(instance.value().instance_name, env.evo_url, env.evo_token);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                    {"message", "Instance connected successfully!"},
-                    {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
+void Handler::connectInstance(string instance_id, StatusCallback done) {
+    Config config;
+    std::optional<Database::Instance> instance;
+    if (auto resolved = resolveInstance(instance_id, instance, false); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
     }
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Instance type is not valid."}};
-    return stat;
+    Provider::of(instance->instance_type).connect(instance.value(), config.getEnv(), std::move(done));
 }
 
-Status Handler::deleteInstance(string instance_id) {
-    apiLogger.info("Iniciando exclusão da instância: " + instance_id);
+void Handler::deleteInstance(string instance_id, StatusCallback done) {
+    apiLogger.info("Iniciando exclusão da instância: {}", instance_id);
     Config config;
     Database db;
     Status stat;
 
-    auto env = config.getEnv();
-    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco: " + connection.status_string.dump());
-        return connection;
+    const auto& env = config.getEnv();
+    std::optional<Database::Instance> instance;
+    if (auto lookup = lookupInstance(instance_id, instance, db, env); lookup.status_code == c_status::ERR) {
+        done(std::move(lookup));
+        return;
     }
-
-    auto instance = db.fetchInstance(instance_id);
     if (!instance.has_value()) {
-        apiLogger.error("Instância não encontrada: " + instance_id);
+        apiLogger.error("Instância não encontrada: {}", instance_id);
         stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't get the instance from the db."}};
-        return stat;
+        stat.status_string = nlohmann::json{{"error", instance_not_found}};
+        done(std::move(stat));
+        return;
     }
 
+    if (auto connection = connectOnce(db, env.db_url); connection.status_code == c_status::ERR) {
+        done(std::move(connection));
+        return;
+    }
     Status dbStatus = db.deleteInstance(instance_id);
     if (dbStatus.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao excluir instância do banco: " + dbStatus.status_string.dump());
+        apiLogger.error("Erro ao excluir instância do banco: {}", dbStatus.status_string.dump());
         stat.status_code = c_status::ERR;
         stat.status_string = nlohmann::json{{"error", "Couldn't delete the instance from the db..."}};
-        return stat;
+        done(std::move(stat));
+        return;
     }
+    InstanceCache::instance().erase(instance_id);
+    db.disconnect();
 
-    if (instance.value().instance_type == "WUZAPI") {
-        apiLogger.info("Excluindo instância WUZAPI");
-        Status response = Wuzapi::deleteInstance_w(instance_id,env.wuz_url, env.wuz_admin_token);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                        {"message", "Instance deleted successfully!"},
-                        {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-
-    } else if (instance.value().instance_type == "EVOLUTION") {
-        apiLogger.info("Excluindo instância Evolution");
-        Status response = Evolution::deleteInstance_e(instance_id, env.evo_token, env.evo_url);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                    {"message", "Instance deleted successfully!"},
-                    {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-    }
-    apiLogger.error("Tipo de instância inválido: " + instance_id);
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Instance type is not valid."}};
-    return stat;
+    const Provider& provider = Provider::of(instance->instance_type);
+    apiLogger.info("Excluindo instância {}", provider.name());
+    provider.remove(instance.value(), env, std::move(done));
 }
 
-
-Status Handler::logoutInstance(string instance_id) {
+void Handler::logoutInstance(string instance_id, StatusCallback done) {
     Config config;
-    Database db;
-    Database evo_db;
-    Status stat;
-
-    auto env = config.getEnv();
-    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco de dados: " + connection.status_string.dump());
-        return connection;
-    }
-
-    auto instance = db.fetchInstance(instance_id);
-    if (!instance.has_value()) {
-        apiLogger.error("Instância não encontrada: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't get the instance from the db."}};
-        return stat;
+    std::optional<Database::Instance> instance;
+    if (auto resolved = resolveInstance(instance_id, instance, true); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
     }
 
-    ApiType api_type;
-    if (instance.value().instance_type == "EVOLUTION") {
-        api_type = ApiType::EVOLUTION;
-        if (env.db_url_evo.empty()) {
-            apiLogger.warn("URL do banco de dados Evolution não configurada");
-        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
-            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: " + evo_connection.status_string.dump());
-        }
-    } else if (instance.value().instance_type == "WUZAPI") {
-        api_type = ApiType::WUZAPI;
-    } else if (instance.value().instance_type == "CLOUD") {
-        api_type = ApiType::CLOUD;
-    } else {
-        apiLogger.error("Tipo de instância desconhecido: " + instance.value().instance_type);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Unknown instance type"}};
-        return stat;
-    }
-
-    bool is_active = db.isActive(api_type, instance_id, evo_db);
-    if (!is_active) {
-        apiLogger.error("Instância não está ativa: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance is not active. Please connect it first."}};
-        return stat;
-    }
-
-    if (instance.value().instance_type == "WUZAPI") {
-        Status response = Wuzapi::logoutInstance_w(instance_id, env.wuz_url);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                    {"message", "Instance deleted successfully!"},
-                    {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-    } else if (instance.value().instance_type == "EVOLUTION") {
-        Status response = Evolution::logoutInstance_e(instance_id, env.evo_url, env.evo_token);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                    {"message", "Instance deleted successfully!"},
-                    {"api_response", response.status_string}
-                };
-            }
+    Provider::of(instance->instance_type).logout(instance.value(), config.getEnv(), [instance_id, done = std::move(done)](Status response) {
+        if (response.status_code == c_status::OK) {
+            InstanceStatus::instance().report(instance_id, false);
         }
-        return response;
-    }
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Instance type is not valid."}};
-    return stat;
+        done(std::move(response));
+    });
 }
 
-Status Handler::setWebhook(string token, string webhook_url) {
-    Config config;
+// Keeps instances.webhook_url, the forward target, and the instance cache in line with the request.
+static void storeWebhook(Database::Instance instance, const string &webhook_url, const Env &env) {
     Database db;
-    Database evo_db;
-    Status stat;
-
-    auto env = config.getEnv();
     if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco de dados: " + connection.status_string.dump());
-        return connection;
+        apiLogger.warn("Webhook configurado, mas não foi possível salvá-lo no banco: {}", connection.status_string.dump());
+        return;
     }
-
-    auto instance = db.fetchInstance(token);
-    if (!instance.has_value()) {
-        apiLogger.error("Instância não encontrada: " + token);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't get the instance from the db."}};
-        return stat;
-    }
-
-    ApiType api_type;
-    if (instance.value().instance_type == "EVOLUTION") {
-        api_type = ApiType::EVOLUTION;
-        if (env.db_url_evo.empty()) {
-            apiLogger.warn("URL do banco de dados Evolution não configurada");
-        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
-            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: " + evo_connection.status_string.dump());
-        }
-    } else if (instance.value().instance_type == "WUZAPI") {
-        api_type = ApiType::WUZAPI;
-    } else if (instance.value().instance_type == "CLOUD") {
-        api_type = ApiType::CLOUD;
-    } else {
-        apiLogger.error("Tipo de instância desconhecido: " + instance.value().instance_type);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Unknown instance type"}};
-        return stat;
-    }
-
-    bool is_active = db.isActive(api_type, token, evo_db);
-    if (!is_active) {
-        apiLogger.error("Instância não está ativa: " + token);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance is not active. Please connect it first."}};
-        return stat;
+    if (auto update = db.updateWebhook(instance.instance_id, webhook_url); update.status_code == c_status::ERR) {
+        apiLogger.warn("Webhook configurado, mas não foi possível salvá-lo no banco: {}", update.status_string.dump());
+        return;
     }
+    instance.webhook_url = webhook_url;
+    InstanceCache::instance().put(instance);
+}
 
-    if (instance.value().instance_type == "WUZAPI") {
-        Status response = Wuzapi::setWebhook_w(token, webhook_url, env.wuz_url);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
+void Handler::setWebhook(string token, string webhook_url, StatusCallback done) {
+    auto env = Config::current();
+    std::optional<Database::Instance> instance;
+    if (auto resolved = resolveInstance(token, instance, true); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
+    }
+
+    // Re-points the provider at this instance's /webhook receiver; webhook_url is where its events are forwarded.
+    if (env->public_url.empty()) {
+        apiLogger.error("PUBLIC_URL não configurada, não é possível registrar o webhook da instância {}", token);
+        done(Status{c_status::ERR, nlohmann::json{{"error", "PUBLIC_URL is not configured, the provider cannot reach /webhook"}}});
+        return;
+    }
+    const string receiver_url = WebhookAuth::receiverUrl(instance->instance_id, env->public_url, env->token);
+    Provider::of(instance->instance_type).setWebhook(instance.value(), receiver_url, *env,
+        [instance = std::move(instance.value()), webhook_url, env, done = std::move(done)](Status response) mutable {
+            if (response.status_code != c_status::OK) {
+                done(std::move(response));
+                return;
             }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                        {"message", "Instance deleted successfully!"},
-                        {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-    } else if (instance.value().instance_type == "EVOLUTION") {
-        Status response = Evolution::setWebhook_e(instance.value().instance_name, webhook_url, env.evo_url, env.evo_token);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                        {"message", "Instance deleted successfully!"},
-                        {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-    }
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Instance type is not valid."}};
-    return stat;
+            WorkerPool::instance().submit([instance = std::move(instance), webhook_url, env, response = std::move(response), done = std::move(done)]() mutable {
+                storeWebhook(std::move(instance), webhook_url, *env);
+                done(std::move(response));
+            });
+        });
 }
 
-std::vector<Database::Instance> Handler::retrieveInstances() {
+std::optional<Database::InstancePage> Handler::retrieveInstances(const Database::InstanceQuery &query) {
     Database db;
-    Database evo_db;
     Config cfg;
-    auto env = cfg.getEnv();
-
-    apiLogger.info("Retrieving all instances from database");
+    const auto& env = cfg.getEnv();
 
-    std::vector<Database::Instance> instances;
     auto connection = db.connect(env.db_url);
     if (connection.status_code == c_status::ERR) {
-        apiLogger.error("Failed to connect to database: " + connection.status_string.dump());
-        return instances;
-    }
-
-    bool evo_db_connected = false;
-    if (!env.db_url_evo.empty()) {
-        auto evo_connection = evo_db.connect(env.db_url_evo);
-        if (evo_connection.status_code == c_status::OK) {
-            evo_db_connected = true;
-            apiLogger.debug("Connected to Evolution database for instance status verification");
-        } else {
-            apiLogger.warn("Failed to connect to Evolution database: " + evo_connection.status_string.dump());
+        apiLogger.error("Failed to connect to database: {}", connection.status_string.dump());
+        return std::nullopt;
+    }
+
+    auto page = db.retrieveInstances(query);
+    if (!page.has_value()) {
+        return std::nullopt;
+    }
+    auto& instances = page->instances;
+
+    // Evolution instances the status cache has not seen yet are resolved together below.
+    std::vector<std::size_t> unresolved;
+    std::vector<std::string> tokens;
+    std::vector<std::pair<std::string, bool>> changed;
+    for (std::size_t i = 0; i < instances.size(); ++i) {
+        auto& instance = instances[i];
+        const ApiType api_type = instance.instance_type;
+        if (auto cached = InstanceStatus::instance().isActive(api_type, instance.instance_id); cached.has_value()) {
+            if (api_type != ApiType::EVOLUTION && cached.value() != instance.is_active) {
+                changed.emplace_back(instance.instance_id, cached.value());
+            }
+            instance.is_active = cached.value();
+            continue;
         }
+        unresolved.push_back(i);
+        tokens.push_back(instance.instance_id);
     }
 
-    instances = db.retrieveInstances();
-    apiLogger.info("Retrieved " + std::to_string(instances.size()) + " instances");
-
-    for (auto& instance : instances) {
-        ApiType api_type;
-        if (instance.instance_type == "EVOLUTION") {
-            api_type = ApiType::EVOLUTION;
-        } else if (instance.instance_type == "WUZAPI") {
-            api_type = ApiType::WUZAPI;
-        } else if (instance.instance_type == "CLOUD") {
-            api_type = ApiType::CLOUD;
+    if (!unresolved.empty()) {
+        Database evo_db;
+        std::optional<std::unordered_map<std::string, bool>> states;
+        if (env.db_url_evo.empty()) {
+            apiLogger.debug("Skipping activity verification for {} Evolution instances - Evolution DB not configured", unresolved.size());
+        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
+            apiLogger.warn("Failed to connect to Evolution database: {}", evo_connection.status_string.dump());
         } else {
-            apiLogger.warn("Unknown instance type for instance " + instance.instance_id + ": " + instance.instance_type);
-            continue;
+            states = evo_db.fetchConnectionStates_e(tokens);
         }
 
-        if (instance.instance_type == "EVOLUTION" && !evo_db_connected) {
-            apiLogger.debug("Skipping activity verification for Evolution instance " + instance.instance_id + " - Evolution DB not connected");
-            continue;
+        if (states.has_value()) {
+            for (std::size_t i : unresolved) {
+                auto& instance = instances[i];
+                auto it = states->find(instance.instance_id);
+                bool is_active = it != states->end() && it->second;
+                if (is_active != instance.is_active) {
+                    changed.emplace_back(instance.instance_id, is_active);
+                }
+                instance.is_active = is_active;
+                InstanceStatus::instance().report(instance.instance_id, is_active);
+                apiLogger.debug("Instance {} (EVOLUTION) activity status: {}", instance.instance_id, (is_active ? "active" : "inactive"));
+            }
         }
-
-        bool is_active = db.isActive(api_type, instance.instance_id, evo_db);
-        instance.is_active = is_active;
-
-        apiLogger.debug("Instance " + instance.instance_id + " (" + instance.instance_type + ") activity status: " +
-                       (is_active ? "active" : "inactive"));
     }
 
-    return instances;
+    // The `active` filter stays in the SQL WHERE: pages keep their size and cursor, and an
+    // instance whose live state differs from the stored one moves to the right filter once
+    // the write below lands.
+    if (!changed.empty()) {
+        db.updateActiveStates(changed);
+    }
+    return page;
 }
 
- Status Handler::sendTemplate(string instance_id, string number, string body, MediaType type, std::vector<FB_VARS> vars, std::string template_name) {
+std::optional<Database::Instance> Handler::getInstance(const string &instance_id) {
     Database db;
+    Database evo_db;
     Config cfg;
-    Status stat;
-    auto env = cfg.getEnv();
+    const auto& env = cfg.getEnv();
 
-    apiLogger.info("Sending template from instance: " + instance_id + " - Template: " + template_name);
-
-    auto connection = db.connect(env.db_url);
-    if (connection.status_code == c_status::ERR) {
-        apiLogger.error("Failed to connect to database: " + connection.status_string.dump());
-        return connection;
+    std::optional<Database::Instance> instance;
+    if (lookupInstance(instance_id, instance, db, env).status_code == c_status::ERR || !instance.has_value()) {
+        return std::nullopt;
     }
+    instance->is_active = instanceIsActive(instance->instance_type, instance_id, db, evo_db, env);
+    return instance;
+}
 
-    auto instance_opt = db.fetchInstance(instance_id);
-    if (!instance_opt.has_value()) {
-        apiLogger.error("Instance not found: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance not found"}};
-        return stat;
-    }
+void Handler::sendTemplate(string instance_id, string number, string body, MediaType type, std::vector<FB_VARS> vars, std::string template_name,
+                           ResponseMode mode, StatusCallback done) {
+    apiLogger.info("Sending template from instance: {} - Template: {}", instance_id, template_name);
 
-    auto instance = instance_opt.value();
-    if (instance.instance_type != "CLOUD") {
-        apiLogger.error("Instance type not compatible, should be CLOUD. Current: " + instance.instance_type);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance type not compatible, should be CLOUD"}};
-        return stat;
+    std::optional<Database::Instance> instance;
+    if (auto resolved = resolveInstance(instance_id, instance, false, "Instance not found"); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
     }
-
-    if (!instance.phone_number_id.has_value() || !instance.access_token.has_value()) {
-        apiLogger.error("Missing required fields for Cloud API (phone_number_id or access_token)");
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Missing required Cloud API configuration"}};
-        return stat;
-    }
-
-    apiLogger.info("Sending template via Cloud API");
-    return Cloud::sendTemplate(
-        instance_id,
-        number,
-        body,
-        type,
-        instance.phone_number_id.value(),
-        instance.access_token.value(),
-        vars,
-        template_name
-    );
+    Provider::of(instance->instance_type).sendTemplate(instance.value(), number, body, type, vars, template_name, mode, std::move(done));
 }
 
-Status Handler::createGroup(string instance_id, string subject, string description, std::vector<string> participants) {
+void Handler::createGroup(string instance_id, string subject, string description, std::vector<string> participants, StatusCallback done) {
     Config config;
-    Database db;
-    Database evo_db;
-    Status stat;
-
-    auto env = config.getEnv();
-    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
-        apiLogger.error("Erro ao conectar ao banco de dados: " + connection.status_string.dump());
-        return connection;
-    }
-
-    auto instance = db.fetchInstance(instance_id);
-    if (!instance.has_value()) {
-        apiLogger.error("Instância não encontrada: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Couldn't get the instance from the db."}};
-        return stat;
+    std::optional<Database::Instance> instance;
+    if (auto resolved = resolveInstance(instance_id, instance, true); resolved.status_code == c_status::ERR) {
+        done(std::move(resolved));
+        return;
     }
-
-    ApiType api_type;
-    if (instance.value().instance_type == "EVOLUTION") {
-        api_type = ApiType::EVOLUTION;
-        if (env.db_url_evo.empty()) {
-            apiLogger.warn("URL do banco de dados Evolution não configurada");
-        } else if (auto evo_connection = evo_db.connect(env.db_url_evo); evo_connection.status_code == c_status::ERR) {
-            apiLogger.warn("Erro ao conectar ao banco de dados Evolution: " + evo_connection.status_string.dump());
-        }
-    } else if (instance.value().instance_type == "WUZAPI") {
-        api_type = ApiType::WUZAPI;
-    } else if (instance.value().instance_type == "CLOUD") {
-        api_type = ApiType::CLOUD;
-    } else {
-        apiLogger.error("Tipo de instância desconhecido: " + instance.value().instance_type);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Unknown instance type"}};
-        return stat;
-    }
-
-    bool is_active = db.isActive(api_type, instance_id, evo_db);
-    if (!is_active) {
-        apiLogger.error("Instância não está ativa: " + instance_id);
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{{"error", "Instance is not active. Please connect it first."}};
-        return stat;
-    }
-
-    if (instance.value().instance_type == "WUZAPI") {
-        stat.status_code = c_status::ERR;
-        stat.status_string = nlohmann::json{ { "error", "Still not implemented for Wuzapi"}};
-    } else if (instance.value().instance_type == "EVOLUTION") {
-        Status response = Evolution::createGroup_e(env.evo_token, env.evo_url, instance.value().instance_name, subject, description, participants);
-        try {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json::parse(response.status_string.dump());
-            }
-        } catch (const std::exception& e) {
-            if (response.status_code == c_status::OK) {
-                response.status_string = nlohmann::json{
-                            {"message", "Group created successfully!"},
-                            {"api_response", response.status_string}
-                };
-            }
-        }
-        return response;
-    }
-    stat.status_code = c_status::ERR;
-    stat.status_string = nlohmann::json{{"error", "Instance type is not valid."}};
-    return stat;
-
-
+    Provider::of(instance->instance_type).createGroup(instance.value(), subject, description, participants, config.getEnv(), std::move(done));
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "../constants.h"
 #include "../api/evolution.h"
 #include "../api/wuzapi.h"
@@ -11,17 +15,33 @@
 using std::string;
 
 
+/* Operations that talk to a provider are asynchronous: they return once the
+   request is handed over and `done` runs exactly once with the outcome, on
+   the HttpClient thread, a worker, or right away when nothing is sent. */
 class Handler {
     public:
+        using StatusesCallback = std::function<void(std::vector<Status>)>;
+
         Handler() = delete;
 
-        static Status sendMessage(const string &instance_id, string number, string body, MediaType type);
-        static Status createInstance(const string &instance_id, const string &instance_name, ApiType api_type, std::string webhook_url, std::string proxy_url, std::string access_token, std::string waba_id);
-        static Status deleteInstance(string instance_id);
-        static Status connectInstance(string instance_id);
-        static Status logoutInstance(string instance_id);
-        static Status setWebhook(string token, string webhook_url);
-        static std::vector<Database::Instance> retrieveInstances();
-        static Status sendTemplate(string instance_id, string number, string body, MediaType type, std::vector<FB_VARS> vars, std::string template_name);
-        static Status createGroup(string instance_id, string subject, string description, std::vector<string> participants);
+        // With ResponseMode::RAW a successful send carries the provider's answer in raw_body. body must outlive `done`.
+        static void sendMessage(const string &instance_id, const string &number, std::string_view body, MediaType type, ResponseMode mode,
+                                StatusCallback done);
+        // One result per message, in request order. The messages are shared so the caller can read them once `done` runs.
+        static void sendMessages(std::shared_ptr<const std::vector<OutgoingMessage>> messages, ResponseMode mode, StatusesCallback done);
+        // Checks the instance and stores the message for the Outbox dispatcher; the id is in status_string["message_id"].
+        static Status queueMessage(const string &instance_id, const string &number, std::string_view body, MediaType type, const std::optional<string> &callback_url);
+        static std::optional<Database::OutboxMessage> getMessage(long long message_id);
+        static void createInstance(const string &instance_id, const string &instance_name, ApiType api_type, std::string webhook_url, std::string proxy_url,
+                                   std::string access_token, std::string waba_id, StatusCallback done);
+        static void deleteInstance(string instance_id, StatusCallback done);
+        static void connectInstance(string instance_id, StatusCallback done);
+        static void logoutInstance(string instance_id, StatusCallback done);
+        static void setWebhook(string token, string webhook_url, StatusCallback done);
+        // One keyset page with the live connection state filled in.
+        static std::optional<Database::InstancePage> retrieveInstances(const Database::InstanceQuery &query);
+        static std::optional<Database::Instance> getInstance(const string &instance_id);
+        static void sendTemplate(string instance_id, string number, string body, MediaType type, std::vector<FB_VARS> vars, std::string template_name,
+                                 ResponseMode mode, StatusCallback done);
+        static void createGroup(string instance_id, string subject, string description, std::vector<string> participants, StatusCallback done);
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "multipart.h"
+#include <algorithm>
+#include <cctype>
+#include <string>
+
+namespace {
+
+bool startsWithIgnoreCase(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() &&
+           std::equal(prefix.begin(), prefix.end(), s.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+           });
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+    return s;
+}
+
+// Value of `key` in a header such as `form-data; name="file"; filename="a.png"`.
+std::string_view headerParam(std::string_view header, std::string_view key) {
+    std::size_t pos = 0;
+    while ((pos = header.find(';', pos)) != std::string_view::npos) {
+        std::string_view rest = trim(header.substr(pos + 1));
+        pos += 1;
+        if (!startsWithIgnoreCase(rest, key) || rest.size() <= key.size() || rest[key.size()] != '=') {
+            continue;
+        }
+        std::string_view value = rest.substr(key.size() + 1);
+        if (!value.empty() && value.front() == '"') {
+            std::size_t close = value.find('"', 1);
+            return close == std::string_view::npos ? std::string_view{} : value.substr(1, close - 1);
+        }
+        return trim(value.substr(0, value.find(';')));
+    }
+    return {};
+}
+
+} // namespace
+
+std::string_view Multipart::boundary(std::string_view content_type) {
+    if (!startsWithIgnoreCase(trim(content_type), "multipart/form-data")) {
+        return {};
+    }
+    return headerParam(content_type, "boundary");
+}
+
+std::optional<std::vector<Multipart::Part>> Multipart::parse(std::string_view body, std::string_view boundary) {
+    if (boundary.empty()) {
+        return std::nullopt;
+    }
+    const std::string delimiter = "--" + std::string(boundary);
+    const std::string separator = "\r\n" + delimiter;
+
+    std::size_t pos = body.find(delimiter);
+    if (pos == std::string_view::npos) {
+        return std::nullopt;
+    }
+    pos += delimiter.size();
+
+    std::vector<Part> parts;
+    while (true) {
+        if (body.substr(pos, 2) == "--") {
+            return parts;
+        }
+        if (body.substr(pos, 2) != "\r\n") {
+            return std::nullopt;
+        }
+        pos += 2;
+
+        std::size_t headers_end = body.find("\r\n\r\n", pos);
+        if (headers_end == std::string_view::npos) {
+            return std::nullopt;
+        }
+        Part part{};
+        std::string_view headers = body.substr(pos, headers_end - pos);
+        while (!headers.empty()) {
+            std::size_t eol = headers.find("\r\n");
+            std::string_view line = headers.substr(0, eol);
+            if (startsWithIgnoreCase(line, "content-disposition:")) {
+                std::string_view value = line.substr(20);
+                part.name = headerParam(value, "name");
+                part.filename = headerParam(value, "filename");
+            } else if (startsWithIgnoreCase(line, "content-type:")) {
+                part.content_type = trim(line.substr(13));
+            }
+            headers = eol == std::string_view::npos ? std::string_view{} : headers.substr(eol + 2);
+        }
+
+        std::size_t data_start = headers_end + 4;
+        std::size_t data_end = body.find(separator, data_start);
+        if (data_end == std::string_view::npos) {
+            return std::nullopt;
+        }
+        part.data = body.substr(data_start, data_end - data_start);
+        parts.push_back(part);
+        pos = data_end + separator.size();
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+/* In-place multipart/form-data parser (RFC 7578). Parts are views into the
+   request body, so file contents are never copied. */
+class Multipart {
+public:
+    typedef struct {
+        std::string_view name;
+        std::string_view filename;
+        std::string_view content_type;
+        std::string_view data;
+    } Part;
+
+    Multipart() = delete;
+
+    // The boundary parameter of a multipart/form-data Content-Type, empty for anything else.
+    static std::string_view boundary(std::string_view content_type);
+    // Empty when the body is not well formed.
+    static std::optional<std::vector<Part>> parse(std::string_view body, std::string_view boundary);
+};
@@ -0,0 +1,252 @@
+#include "outbox.h"
+#include "handler.h"
+#include "api/http_client.h"
+#include "logger/logger.h"
+#include "logger/log_policy.h"
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <random>
+
+extern Logger apiLogger;
+
+namespace {
+
+size_t discardBody(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+} // namespace
+
+Outbox& Outbox::instance() {
+    static Outbox outbox;
+    return outbox;
+}
+
+Outbox::~Outbox() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+void Outbox::start() {
+    if (!threads_.empty()) {
+        return;
+    }
+    Config cfg;
+    int workers = std::max(cfg.getEnv().outbox_workers, 0);
+    for (int i = 0; i < workers; ++i) {
+        threads_.emplace_back([this] { run(); });
+    }
+    apiLogger.info("Dispatcher da fila de mensagens iniciado com {} threads", workers);
+}
+
+void Outbox::wake() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        ++wakeups_;
+    }
+    cv_.notify_one();
+}
+
+void Outbox::run() {
+    while (true) {
+        // Answers first: their rows are still leased, and the in-flight slot is only given back once they are written.
+        std::optional<Result> result;
+        bool reserved = false;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (stopping_) {
+                return;
+            }
+            if (!results_.empty()) {
+                result = std::move(results_.front());
+                results_.pop_front();
+            } else if (in_flight_ < static_cast<std::size_t>(std::max(Config::current()->outbox_max_in_flight, 1))) {
+                ++in_flight_;
+                reserved = true;
+            }
+        }
+
+        if (result.has_value()) {
+            try {
+                record(*result->msg, result->snd, *Config::current());
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao gravar o resultado da mensagem {}: {}", result->msg->id, e.what());
+            }
+            std::lock_guard<std::mutex> lock(mtx_);
+            --in_flight_;
+            continue;
+        }
+
+        // With a slot reserved, dispatchOne() either hands it to a send (returned through results_) or nothing was due.
+        bool dispatched = false;
+        if (reserved) {
+            try {
+                dispatched = dispatchOne();
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro no dispatcher da fila de mensagens: {}", e.what());
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        if (reserved && !dispatched) {
+            --in_flight_;
+        }
+        if (stopping_) {
+            return;
+        }
+        if (dispatched || !results_.empty()) {
+            continue;
+        }
+        if (wakeups_ > 0 && reserved) {
+            --wakeups_;
+            continue;
+        }
+        // Without a free slot only an answer can let this thread go on; it arrives through cv_ as well.
+        Config cfg;
+        auto poll = std::chrono::milliseconds(std::max(cfg.getEnv().outbox_poll_ms, 10));
+        cv_.wait_for(lock, poll, [this, reserved] { return stopping_ || !results_.empty() || (reserved && wakeups_ > 0); });
+        if (reserved && wakeups_ > 0) {
+            --wakeups_;
+        }
+    }
+}
+
+bool Outbox::dispatchOne() {
+    Config cfg;
+    const auto& env = cfg.getEnv();
+
+    Database db;
+    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados: {}", connection.status_string.dump());
+        return false;
+    }
+    auto claimed = db.claimMessage(std::max(env.outbox_lease_s, 1));
+    if (!claimed.has_value()) {
+        return false;
+    }
+    // The send can take seconds, the connection goes back to the pool meanwhile.
+    db.disconnect();
+    auto msg = std::make_shared<const Database::OutboxMessage>(std::move(claimed.value()));
+    apiLogger.info("Enviando mensagem {} da fila (tentativa {})", msg->id, msg->attempts);
+
+    auto type = parseMediaType(msg->type);
+    if (!type.has_value()) {
+        finish(msg, Status{c_status::ERR, nlohmann::json{{"error", "Unknown message type: " + msg->type}}});
+        return true;
+    }
+    try {
+        // msg holds the body the provider streams from until the send is answered.
+        Handler::sendMessage(msg->instance_id, msg->number, msg->body, type.value(), ResponseMode::PARSED,
+                             [this, msg](Status snd) { finish(msg, std::move(snd)); });
+    } catch (const std::exception& e) {
+        Status failed{c_status::ERR, nlohmann::json{{"error", e.what()}}};
+        failed.transient = true;
+        finish(msg, std::move(failed));
+    }
+    return true;
+}
+
+void Outbox::finish(std::shared_ptr<const Database::OutboxMessage> msg, Status snd) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        results_.push_back(Result{std::move(msg), std::move(snd)});
+    }
+    cv_.notify_one();
+}
+
+void Outbox::record(const Database::OutboxMessage& msg, const Status& snd, const Env& env) {
+    Database db;
+    if (auto connection = db.connect(env.db_url); connection.status_code == c_status::ERR) {
+        // The lease runs out and the message is sent again; providers do not deduplicate, so log it loudly.
+        apiLogger.error("Mensagem {} enviada mas o resultado não pôde ser gravado: {}", msg.id, connection.status_string.dump());
+        return;
+    }
+
+    if (snd.status_code == c_status::OK) {
+        db.markMessageSent(msg.id, snd.status_string.dump());
+        apiLogger.info("Mensagem {} da fila enviada", msg.id);
+        db.disconnect();
+        notify(msg, "sent", nlohmann::json{{"result", snd.status_string}});
+        return;
+    }
+
+    std::string error = snd.status_string.dump();
+    if (snd.retry_after_s > 0) {
+        db.deferMessage(msg.id, error, snd.retry_after_s);
+        apiLogger.info("Mensagem {} da fila adiada {}s pelo limite de envio", msg.id, snd.retry_after_s);
+        return;
+    }
+    // A refused body, an unknown or inactive instance or a 4xx fails the same way on every attempt.
+    if (!snd.transient) {
+        db.markMessageFailed(msg.id, error);
+        apiLogger.error("Mensagem {} da fila falhou sem possibilidade de nova tentativa: {}", msg.id, error);
+        db.disconnect();
+        notify(msg, "failed", nlohmann::json{{"error", snd.status_string}});
+        return;
+    }
+    if (msg.attempts >= env.outbox_max_attempts) {
+        db.markMessageFailed(msg.id, error);
+        apiLogger.error("Mensagem {} da fila falhou após {} tentativas: {}", msg.id, msg.attempts, error);
+        db.disconnect();
+        notify(msg, "failed", nlohmann::json{{"error", snd.status_string}});
+        return;
+    }
+    int delay = backoffSeconds(msg.attempts, env);
+    db.markMessageRetry(msg.id, error, delay);
+    apiLogger.warn("Mensagem {} da fila falhou, nova tentativa em {}s: {}", msg.id, delay, error);
+}
+
+int Outbox::backoffSeconds(int attempts, const Env& env) {
+    // Exponential with jitter in [delay/2, delay], so a provider outage does not retry in lockstep.
+    const long long base = std::max(env.outbox_backoff_base_s, 1);
+    const long long cap = std::max<long long>(env.outbox_backoff_max_s, base);
+    long long delay = base << std::min(std::max(attempts - 1, 0), 20);
+    delay = std::min(delay, cap);
+    thread_local std::mt19937 rng{std::random_device{}()};
+    std::uniform_int_distribution<long long> jitter(delay / 2, delay);
+    return static_cast<int>(std::max<long long>(jitter(rng), 1));
+}
+
+void Outbox::notify(const Database::OutboxMessage& msg, const std::string& status, const nlohmann::json& detail) {
+    if (!msg.callback_url.has_value() || msg.callback_url->empty()) {
+        return;
+    }
+    nlohmann::json payload = detail;
+    payload["message_id"] = msg.id;
+    payload["instance_id"] = msg.instance_id;
+    payload["number"] = msg.number;
+    payload["status"] = status;
+    payload["attempts"] = msg.attempts;
+    std::string body = payload.dump();
+
+    auto call = std::make_shared<HttpCall>();
+    CURL* curl = call->curl;
+    if (!curl) {
+        apiLogger.error("Falha ao inicializar CURL para o callback da mensagem {}", msg.id);
+        return;
+    }
+    call->headers = curl_slist_append(call->headers, "Content-Type: application/json");
+    curl_easy_setopt(curl, CURLOPT_URL, msg.callback_url->c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, call->headers);
+    curl_easy_setopt(curl, CURLOPT_COPYPOSTFIELDS, body.c_str());
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardBody);
+
+    // Nothing waits for the client's answer, it is only logged.
+    HttpClient::instance().async_perform(curl, [call, id = msg.id, url = msg.callback_url.value(), body = std::move(body)](HttpResult res) {
+        if (res.code != CURLE_OK || res.http_code >= 400) {
+            apiLogger.warn("Callback da mensagem {} falhou ({} {}): {}", id, res.http_code, res.error, LogPolicy::body(body));
+        } else {
+            apiLogger.debug("Callback da mensagem {} entregue em {}", id, url);
+        }
+    }, {"CALLBACK", "outbox", false});
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../constants.h"
+#include "../config/config.h"
+#include "../database/database.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Dispatcher for asynchronous sends. Handler::queueMessage stores the message
+   in wasolution_outbox and answers right away; OUTBOX_WORKERS threads claim
+   due rows one at a time (FOR UPDATE SKIP LOCKED, so replicas can share the
+   table), hand them to Handler::sendMessage and retry failures with
+   exponential backoff until OUTBOX_MAX_ATTEMPTS. Threads do not wait for the
+   provider: up to OUTBOX_MAX_IN_FLIGHT sends are out at once, and their
+   results come back to these threads to be written. A claimed row is leased for
+   OUTBOX_LEASE_S seconds, after which a crashed dispatcher's work is picked
+   up again. The final state is kept in the row and, when the message has a
+   callback_url, POSTed there once. */
+class Outbox {
+public:
+    static Outbox& instance();
+
+    void start();
+    // Called after an insert, so a local dispatcher does not wait for the next poll.
+    void wake();
+
+    Outbox(const Outbox&) = delete;
+    Outbox& operator=(const Outbox&) = delete;
+
+private:
+    Outbox() = default;
+    ~Outbox();
+
+    typedef struct {
+        std::shared_ptr<const Database::OutboxMessage> msg;
+        Status snd;
+    } Result;
+
+    void run();
+    // False when nothing was due.
+    bool dispatchOne();
+    // Called from the send's completion, on whatever thread that runs.
+    void finish(std::shared_ptr<const Database::OutboxMessage> msg, Status snd);
+    static void record(const Database::OutboxMessage& msg, const Status& snd, const Env& env);
+    static int backoffSeconds(int attempts, const Env& env);
+    static void notify(const Database::OutboxMessage& msg, const std::string& status, const nlohmann::json& detail);
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::size_t wakeups_ = 0;
+    std::size_t in_flight_ = 0;
+    std::deque<Result> results_;
+    bool stopping_ = false;
+    std::vector<std::thread> threads_;
+};
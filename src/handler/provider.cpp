@@ -0,0 +1,207 @@
+#include "provider.h"
+
+#include "../api/evolution.h"
+#include "../api/wuzapi.h"
+#include "../cloud/cloud_api.h"
+#include "logger/logger.h"
+#include <array>
+
+extern Logger apiLogger;
+
+namespace {
+
+Status unsupported() {
+    return Status{c_status::ERR, nlohmann::json{{"error", "Instance type is not valid."}}};
+}
+
+class EvolutionProvider final : public Provider {
+public:
+    ApiType type() const override { return ApiType::EVOLUTION; }
+
+    void sendAsync(const Database::Instance& inst, const std::string& number, std::string_view body, MediaType type, const Env& env,
+                   ResponseMode mode, StatusCallback done) const override {
+        Evolution::sendMessage_e(number, env.evo_token, env.evo_url, type, body, inst.instance_name, mode, std::move(done));
+    }
+
+    void create(Database::Instance& inst, const std::string& proxy_url, const std::string& receiver_url, const Env& env,
+                StatusCallback done) const override {
+        Evolution::createInstance_e(env.evo_token, inst.instance_id, inst.instance_name, env.evo_url, receiver_url, proxy_url, std::move(done));
+    }
+
+    void connect(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Evolution::connectInstance_e(inst.instance_name, env.evo_url, env.evo_token, std::move(done));
+    }
+
+    void remove(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Evolution::deleteInstance_e(inst.instance_id, env.evo_token, env.evo_url, std::move(done));
+    }
+
+    void logout(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Evolution::logoutInstance_e(inst.instance_id, env.evo_url, env.evo_token, std::move(done));
+    }
+
+    void setWebhook(const Database::Instance& inst, const std::string& receiver_url, const Env& env, StatusCallback done) const override {
+        Evolution::setWebhook_e(inst.instance_name, receiver_url, env.evo_url, env.evo_token, std::move(done));
+    }
+
+    void createGroup(const Database::Instance& inst, const std::string& subject, const std::string& description,
+                     const std::vector<std::string>& participants, const Env& env, StatusCallback done) const override {
+        Evolution::createGroup_e(env.evo_token, env.evo_url, inst.instance_name, subject, description, participants, std::move(done));
+    }
+};
+
+class WuzapiProvider final : public Provider {
+public:
+    ApiType type() const override { return ApiType::WUZAPI; }
+
+    void sendAsync(const Database::Instance& inst, const std::string& number, std::string_view body, MediaType type, const Env& env,
+                   ResponseMode mode, StatusCallback done) const override {
+        Wuzapi::sendMessage_w(number, inst.instance_id, env.wuz_url, type, body, mode, std::move(done));
+    }
+
+    void create(Database::Instance& inst, const std::string& proxy_url, const std::string& receiver_url, const Env& env,
+                StatusCallback done) const override {
+        Wuzapi::createInstance_w(inst.instance_id, inst.instance_name, env.wuz_url, receiver_url, proxy_url, env.wuz_admin_token, std::move(done));
+    }
+
+    // Starts the session and answers with the QR code to scan.
+    void connect(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Wuzapi::connectInstance_w(inst.instance_id, env.wuz_url, [token = inst.instance_id, url = env.wuz_url, done = std::move(done)](Status response) mutable {
+            if (response.status_code == c_status::ERR) {
+                done(std::move(response));
+                return;
+            }
+
+            apiLogger.info("Instance connected successfully, fetching QR code");
+            Wuzapi::getQrCode_w(token, url, [connection = std::move(response.status_string), done = std::move(done)](Status qr) {
+                if (qr.status_code == c_status::OK) {
+                    if (qr.status_string.is_object()) {
+                        qr.status_string["message"] = "Instance connected successfully!";
+                        qr.status_string["connection_status"] = connection;
+                    } else {
+                        qr.status_string = nlohmann::json{
+                            {"message", "Instance connected successfully!"},
+                            {"api_response", qr.status_string},
+                            {"connection_status", connection}
+                        };
+                    }
+                }
+                done(std::move(qr));
+            });
+        });
+    }
+
+    void remove(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Wuzapi::deleteInstance_w(inst.instance_id, env.wuz_url, env.wuz_admin_token, std::move(done));
+    }
+
+    void logout(const Database::Instance& inst, const Env& env, StatusCallback done) const override {
+        Wuzapi::logoutInstance_w(inst.instance_id, env.wuz_url, std::move(done));
+    }
+
+    void setWebhook(const Database::Instance& inst, const std::string& receiver_url, const Env& env, StatusCallback done) const override {
+        Wuzapi::setWebhook_w(inst.instance_id, receiver_url, env.wuz_url, std::move(done));
+    }
+};
+
+class CloudProvider final : public Provider {
+public:
+    ApiType type() const override { return ApiType::CLOUD; }
+
+    std::optional<Status> rejects(MediaType type, std::string_view body) const override {
+        if (type != MediaType::TEXT && body.substr(0, 5) == "data:") {
+            return Status{c_status::ERR, nlohmann::json{{"error", "Cloud API instances only accept media links, not uploaded files"}}};
+        }
+        return std::nullopt;
+    }
+
+    void sendAsync(const Database::Instance& inst, const std::string& number, std::string_view body, MediaType type, const Env&,
+                   ResponseMode mode, StatusCallback done) const override {
+        if (auto missing = configured(inst)) {
+            done(std::move(missing.value()));
+            return;
+        }
+        Cloud::sendMessage(inst.instance_id, number, body, type, inst.phone_number_id.value(), inst.access_token.value(), mode, std::move(done));
+    }
+
+    // Cloud API webhooks are set up once in the Meta app, not per number, so receiver_url goes unused.
+    void create(Database::Instance& inst, const std::string&, const std::string&, const Env&, StatusCallback done) const override {
+        Cloud::registerNumber(inst.waba_id.value_or(""), inst.access_token.value_or(""), [&inst, done = std::move(done)](Status response) {
+            const auto& json = response.status_string;
+            if (response.status_code == c_status::OK && json.contains("id") && json.contains("data") && !json["data"].empty() &&
+                !json["data"][0]["id"].empty()) {
+                inst.phone_number_id = json["data"][0]["id"].get<std::string>();
+            }
+            done(std::move(response));
+        });
+    }
+
+    // Nothing is held for the instance on Meta's side once its row is gone.
+    void remove(const Database::Instance&, const Env&, StatusCallback done) const override {
+        done(Status{c_status::OK, nlohmann::json{{"message", "Instance deleted successfully!"}}});
+    }
+
+    void sendTemplate(const Database::Instance& inst, const std::string& number, const std::string& body, MediaType type,
+                      const std::vector<FB_VARS>& vars, const std::string& template_name, ResponseMode mode, StatusCallback done) const override {
+        if (auto missing = configured(inst)) {
+            done(std::move(missing.value()));
+            return;
+        }
+        apiLogger.info("Sending template via Cloud API");
+        Cloud::sendTemplate(inst.instance_id, number, body, type, inst.phone_number_id.value(), inst.access_token.value(), vars, template_name, mode,
+                            std::move(done));
+    }
+
+private:
+    static std::optional<Status> configured(const Database::Instance& inst) {
+        if (!inst.phone_number_id.has_value() || !inst.access_token.has_value()) {
+            apiLogger.error("Missing required fields for Cloud API (phone_number_id or access_token)");
+            return Status{c_status::ERR, nlohmann::json{{"error", "Missing required Cloud API configuration"}}};
+        }
+        return std::nullopt;
+    }
+};
+
+const EvolutionProvider evolution;
+const WuzapiProvider wuzapi;
+const CloudProvider cloud;
+
+// Indexed by ApiType.
+const std::array<const Provider*, 3> providers = {&evolution, &wuzapi, &cloud};
+
+} // namespace
+
+const Provider& Provider::of(ApiType type) {
+    return *providers[static_cast<std::size_t>(type)];
+}
+
+std::optional<Status> Provider::rejects(MediaType, std::string_view) const {
+    return std::nullopt;
+}
+
+void Provider::connect(const Database::Instance&, const Env&, StatusCallback done) const {
+    done(unsupported());
+}
+
+void Provider::remove(const Database::Instance&, const Env&, StatusCallback done) const {
+    done(unsupported());
+}
+
+void Provider::logout(const Database::Instance&, const Env&, StatusCallback done) const {
+    done(unsupported());
+}
+
+void Provider::setWebhook(const Database::Instance&, const std::string&, const Env&, StatusCallback done) const {
+    done(unsupported());
+}
+
+void Provider::sendTemplate(const Database::Instance&, const std::string&, const std::string&, MediaType,
+                            const std::vector<FB_VARS>&, const std::string&, ResponseMode, StatusCallback done) const {
+    apiLogger.error("Instance type not compatible, should be CLOUD. Current: {}", name());
+    done(Status{c_status::ERR, nlohmann::json{{"error", "Instance type not compatible, should be CLOUD"}}});
+}
+
+void Provider::createGroup(const Database::Instance&, const std::string&, const std::string&, const std::vector<std::string>&, const Env&,
+                           StatusCallback done) const {
+    done(unsupported());
+}
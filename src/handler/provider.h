@@ -0,0 +1,48 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../constants.h"
+#include "../config/config.h"
+#include "../database/database.h"
+#include "../cloud/cloud_constants.h"
+
+/* One adapter per WhatsApp provider. Handler looks the instance up and checks
+   it once, then calls Provider::of(instance.instance_type), an index into a
+   table with one entry per ApiType. Operations a provider does not offer keep
+   the default, which answers with an error, so adding a provider means a new
+   ApiType value, its name in constants.h and one adapter in provider.cpp. */
+class Provider {
+public:
+    static const Provider& of(ApiType type);
+
+    virtual ~Provider() = default;
+
+    virtual ApiType type() const = 0;
+    std::string_view name() const { return apiTypeName(type()); }
+
+    // Set when the provider cannot send this message at all; checked before sending or queueing.
+    virtual std::optional<Status> rejects(MediaType type, std::string_view body) const;
+
+    // Hands the message to the HttpClient engine; `done` runs once it is answered. body must outlive that.
+    virtual void sendAsync(const Database::Instance& inst, const std::string& number, std::string_view body, MediaType type, const Env& env,
+                           ResponseMode mode, StatusCallback done) const = 0;
+    // The operations below are asynchronous too: `done` runs once, on the HttpClient thread or at once when
+    // nothing is sent. Arguments are copied before they return, except where noted.
+
+    // Registers the instance with the provider and fills in what it assigned, e.g. the Cloud phone number id,
+    // so inst must stay alive until `done` runs. receiver_url is where the provider should post its events, empty for none.
+    virtual void create(Database::Instance& inst, const std::string& proxy_url, const std::string& receiver_url, const Env& env,
+                        StatusCallback done) const = 0;
+    virtual void connect(const Database::Instance& inst, const Env& env, StatusCallback done) const;
+    virtual void remove(const Database::Instance& inst, const Env& env, StatusCallback done) const;
+    virtual void logout(const Database::Instance& inst, const Env& env, StatusCallback done) const;
+    // Points the provider's webhook at receiver_url.
+    virtual void setWebhook(const Database::Instance& inst, const std::string& receiver_url, const Env& env, StatusCallback done) const;
+    virtual void sendTemplate(const Database::Instance& inst, const std::string& number, const std::string& body, MediaType type,
+                              const std::vector<FB_VARS>& vars, const std::string& template_name, ResponseMode mode, StatusCallback done) const;
+    virtual void createGroup(const Database::Instance& inst, const std::string& subject, const std::string& description,
+                             const std::vector<std::string>& participants, const Env& env, StatusCallback done) const;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Query string helpers shared by the router and anything that inspects URLs without a parsed request.
+
+std::string percent_decode(std::string_view in);
+// Escapes everything but the RFC 3986 unreserved characters.
+std::string percent_encode(std::string_view in);
+// The decoded value of `name` in the query of `target` ("/path?a=1&b=2"), empty when absent.
+std::string query_value(std::string_view target, std::string_view name);
@@ -0,0 +1,167 @@
+#include "rate_limiter.h"
+#include "config/config.h"
+#include "logger/logger.h"
+#include "metrics/metrics.h"
+#include <algorithm>
+#include <boost/asio/steady_timer.hpp>
+#include <mutex>
+
+extern Logger apiLogger;
+
+namespace net = boost::asio;
+
+namespace {
+
+std::int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
+RateLimiter& RateLimiter::instance() {
+    static RateLimiter limiter;
+    return limiter;
+}
+
+RateLimiter::RateLimiter() : work_(net::make_work_guard(ioc_)) {
+    thread_ = std::thread([this] { ioc_.run(); });
+}
+
+RateLimiter::~RateLimiter() {
+    work_.reset();
+    ioc_.stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::optional<RateLimiter::Limit> RateLimiter::limitFor(int per_minute, int burst) {
+    if (per_minute <= 0) {
+        return std::nullopt;
+    }
+    const std::int64_t interval = 60'000'000'000LL / per_minute;
+    return Limit{interval, interval * (std::max(burst, 1) - 1)};
+}
+
+RateLimiter::Slot RateLimiter::reserve(Bucket& bucket, const Limit& limit, std::int64_t now, std::int64_t max_wait_ns) {
+    std::int64_t tat = bucket.tat.load(std::memory_order_relaxed);
+    while (true) {
+        const std::int64_t base = std::max(tat, now);
+        const std::int64_t wait = std::max<std::int64_t>(base - limit.tolerance_ns - now, 0);
+        if (wait > max_wait_ns) {
+            return Slot{false, wait - max_wait_ns};
+        }
+        if (bucket.tat.compare_exchange_weak(tat, base + limit.interval_ns, std::memory_order_relaxed)) {
+            return Slot{true, wait};
+        }
+    }
+}
+
+void RateLimiter::release(Bucket& bucket, const Limit& limit) {
+    bucket.tat.fetch_sub(limit.interval_ns, std::memory_order_relaxed);
+}
+
+RateLimiter::Bucket& RateLimiter::bucketFor(std::array<Shard, shard_count>& shards, const std::string& key) {
+    Shard& shard = shards[std::hash<std::string>{}(key) % shard_count];
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mtx);
+        if (auto it = shard.buckets.find(key); it != shard.buckets.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(shard.mtx);
+    auto& slot = shard.buckets[key];
+    if (!slot) {
+        slot = std::make_unique<Bucket>();
+    }
+    return *slot;
+}
+
+RateLimiter::Decision RateLimiter::schedule(const std::string& instance_id, const std::string& provider, Job send) {
+    Config cfg;
+    const auto& env = cfg.getEnv();
+    auto instance_limit = limitFor(env.rate_limit_instance_per_min, env.rate_limit_instance_burst);
+    auto provider_limit = limitFor(env.rate_limit_provider_per_min, env.rate_limit_provider_burst);
+    if (!instance_limit && !provider_limit) {
+        send();
+        return Decision{true, std::chrono::milliseconds{0}};
+    }
+
+    // Rounded up, so a client that honours Retry-After does not come back a moment too early.
+    auto refused = [&](const char* scope, std::int64_t wait_ns) {
+        ::Metrics::instance().observeRateLimit(scope, provider, false, wait_ns / 1e9);
+        return Decision{false, std::chrono::milliseconds{(wait_ns + 999'999) / 1'000'000}};
+    };
+
+    const std::int64_t now = nowNs();
+    const std::int64_t max_wait = std::max<std::int64_t>(env.rate_limit_max_wait_ms, 0) * 1'000'000;
+    // The instance bucket also holds the queue, so it exists even when only the provider is limited.
+    Bucket& instance_bucket = bucketFor(instances_, instance_id);
+    Bucket* provider_bucket = provider_limit ? &bucketFor(providers_, provider) : nullptr;
+
+    Slot instance_slot{true, 0};
+    if (instance_limit) {
+        instance_slot = reserve(instance_bucket, instance_limit.value(), now, max_wait);
+        if (!instance_slot.taken) {
+            apiLogger.warn("Limite de envio da instância {} excedido", instance_id);
+            return refused("instance", instance_slot.wait_ns);
+        }
+    }
+    Slot provider_slot{true, 0};
+    if (provider_bucket) {
+        provider_slot = reserve(*provider_bucket, provider_limit.value(), now, max_wait);
+        if (!provider_slot.taken) {
+            if (instance_limit) {
+                release(instance_bucket, instance_limit.value());
+            }
+            apiLogger.warn("Limite de envio do provedor {} excedido", provider);
+            return refused("provider", provider_slot.wait_ns);
+        }
+    }
+
+    const char* scope = provider_slot.wait_ns > instance_slot.wait_ns ? "provider" : (instance_limit ? "instance" : "provider");
+    const std::int64_t wait = std::max(instance_slot.wait_ns, provider_slot.wait_ns);
+    if (wait == 0) {
+        ::Metrics::instance().observeRateLimit(scope, provider, true, 0.0);
+        send();
+        return Decision{true, std::chrono::milliseconds{0}};
+    }
+
+    if (instance_bucket.queued.fetch_add(1, std::memory_order_relaxed) >= env.rate_limit_queue_size) {
+        instance_bucket.queued.fetch_sub(1, std::memory_order_relaxed);
+        if (instance_limit) {
+            release(instance_bucket, instance_limit.value());
+        }
+        if (provider_bucket) {
+            release(*provider_bucket, provider_limit.value());
+        }
+        apiLogger.warn("Fila de envio da instância {} cheia", instance_id);
+        return refused("instance", wait);
+    }
+
+    ::Metrics::instance().observeRateLimit(scope, provider, true, wait / 1e9);
+    waiting_.fetch_add(1, std::memory_order_relaxed);
+    auto timer = std::make_shared<net::steady_timer>(ioc_, std::chrono::nanoseconds{wait});
+    timer->async_wait([this, timer, &instance_bucket, instance_id, send = std::move(send)](const boost::system::error_code& ec) {
+        instance_bucket.queued.fetch_sub(1, std::memory_order_relaxed);
+        waiting_.fetch_sub(1, std::memory_order_relaxed);
+        if (ec) {
+            return;
+        }
+        try {
+            send();
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro ao liberar envio da fila da instância {}: {}", instance_id, e.what());
+        }
+    });
+    return Decision{true, std::chrono::milliseconds{0}};
+}
+
+RateLimiter::Metrics RateLimiter::metrics() const {
+    std::size_t instances = 0;
+    for (const auto& shard : instances_) {
+        std::shared_lock<std::shared_mutex> lock(shard.mtx);
+        instances += shard.buckets.size();
+    }
+    return Metrics{instances, waiting_.load(std::memory_order_relaxed)};
+}
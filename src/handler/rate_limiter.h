@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+/* Send throttling per instance and per provider (RATE_LIMIT_* settings).
+
+   Each key is a GCRA bucket, the token bucket expressed as a single
+   "theoretical arrival time" that callers advance with a CAS. A send that
+   finds no token reserves the next free one instead and waits for it in a
+   short per-instance queue: a steady_timer on the limiter's own Asio thread
+   starts it when the slot comes up, so no worker ever sleeps on a slot.
+   Only when that queue is full (RATE_LIMIT_QUEUE_SIZE) or the slot is further
+   away than RATE_LIMIT_MAX_WAIT_MS is the send turned down, together with the
+   time until a token frees up: the HTTP layer answers 429 with Retry-After
+   and the outbox puts the message back in the queue for that long. Buckets
+   live in sharded maps that are only write-locked the first time a key is
+   seen. */
+class RateLimiter {
+public:
+    using Job = std::function<void()>;
+
+    typedef struct {
+        std::size_t instances;
+        std::size_t waiting;
+    } Metrics;
+
+    typedef struct {
+        bool admitted;
+        // Retry-After for a refused send; 0 when admitted.
+        std::chrono::milliseconds retry_after;
+    } Decision;
+
+    static RateLimiter& instance();
+
+    /* Takes one token from both the instance and its provider bucket, or from
+       neither. When admitted, `send` runs right here if the token was free and
+       otherwise later on the limiter thread, so keep it to handing the
+       message over; a refused `send` is dropped without running. */
+    Decision schedule(const std::string& instance_id, const std::string& provider, Job send);
+    Metrics metrics() const;
+
+    ~RateLimiter();
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+private:
+    static constexpr std::size_t shard_count = 16;
+
+    typedef struct {
+        std::atomic<std::int64_t> tat{0};
+        // Sends of this instance waiting for their slot; only used in the instance buckets.
+        std::atomic<int> queued{0};
+    } Bucket;
+
+    typedef struct {
+        mutable std::shared_mutex mtx;
+        std::unordered_map<std::string, std::unique_ptr<Bucket>> buckets;
+    } Shard;
+
+    typedef struct {
+        std::int64_t interval_ns;
+        std::int64_t tolerance_ns;
+    } Limit;
+
+    typedef struct {
+        bool taken;
+        // Until the token is due; when not taken, until the bucket has one within max_wait again.
+        std::int64_t wait_ns;
+    } Slot;
+
+    RateLimiter();
+
+    static std::optional<Limit> limitFor(int per_minute, int burst);
+    // Takes the next token if it is due within max_wait_ns, otherwise takes nothing.
+    static Slot reserve(Bucket& bucket, const Limit& limit, std::int64_t now, std::int64_t max_wait_ns);
+    static void release(Bucket& bucket, const Limit& limit);
+    static Bucket& bucketFor(std::array<Shard, shard_count>& shards, const std::string& key);
+
+    std::array<Shard, shard_count> instances_;
+    std::array<Shard, shard_count> providers_;
+    std::atomic<std::size_t> waiting_{0};
+
+    boost::asio::io_context ioc_;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> work_;
+    std::thread thread_;
+};
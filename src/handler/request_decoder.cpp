@@ -0,0 +1,514 @@
+#include "request_decoder.h"
+
+namespace {
+
+using json = nlohmann::json;
+
+enum class Kind {
+    NUL,
+    BOOLEAN,
+    NUMBER,
+    STRING,
+    OBJECT,
+    ARRAY
+};
+
+/* SAX plumbing shared by the decoders. It keeps the path to the value being
+   read and hands every value, containers included, to value() with that
+   path in place; leave() runs when a container closes. Decoders look at
+   depth() and key() to tell which member they are on and return false
+   through fail() to stop the parse. */
+class Decoder : public json::json_sax_t {
+public:
+    bool null() override { return scalar(Kind::NUL, nullptr, false); }
+    bool boolean(bool val) override { return scalar(Kind::BOOLEAN, nullptr, val); }
+    bool number_integer(number_integer_t) override { return scalar(Kind::NUMBER, nullptr, false); }
+    bool number_unsigned(number_unsigned_t) override { return scalar(Kind::NUMBER, nullptr, false); }
+    bool number_float(number_float_t, const string_t&) override { return scalar(Kind::NUMBER, nullptr, false); }
+    bool string(string_t& val) override { return scalar(Kind::STRING, &val, false); }
+    // Only produced by the binary formats.
+    bool binary(binary_t&) override { return fail("tipo de valor não suportado"); }
+
+    bool start_object(std::size_t) override { return open(Kind::OBJECT); }
+    bool start_array(std::size_t) override { return open(Kind::ARRAY); }
+    bool end_object() override { return close(); }
+    bool end_array() override { return close(); }
+
+    bool key(string_t& val) override {
+        frames_.back().key = std::move(val);
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const json::exception&) override {
+        error_ = DecodeError{"", "JSON inválido na posição " + std::to_string(position)};
+        return false;
+    }
+
+    // Runs the parse, then finish() for what can only be checked once the body is complete.
+    std::optional<DecodeError> run(std::string_view body) {
+        if (json::sax_parse(body.begin(), body.end(), this) && !error_.has_value()) {
+            finish();
+        }
+        return std::move(error_);
+    }
+
+protected:
+    typedef struct {
+        bool is_array;
+        std::string key;
+        std::size_t index;
+    } Frame;
+
+    virtual bool value(Kind kind, string_t* str, bool flag) = 0;
+    virtual bool leave() { return true; }
+    virtual void finish() {}
+
+    std::size_t depth() const { return frames_.size(); }
+    // Member name of the enclosing object at `level` (0 is the root).
+    const std::string& key(std::size_t level) const { return frames_[level].key; }
+    bool isArray(std::size_t level) const { return frames_[level].is_array; }
+
+    // "messages[3].type" for the value being read.
+    std::string path() const {
+        std::string out;
+        for (const auto& frame : frames_) {
+            if (frame.is_array) {
+                out.append("[").append(std::to_string(frame.index)).append("]");
+            } else {
+                if (!out.empty()) {
+                    out.push_back('.');
+                }
+                out.append(frame.key);
+            }
+        }
+        return out;
+    }
+
+    bool fail(std::string_view message) {
+        std::string field = path();
+        error_ = DecodeError{field, field.empty() ? std::string(message) : field + " " + std::string(message)};
+        return false;
+    }
+
+    // For required members that never showed up; `member` is relative to the current path.
+    void missing(std::string_view member) {
+        std::string field = path();
+        if (!field.empty()) {
+            field.push_back('.');
+        }
+        field.append(member);
+        error_ = DecodeError{field, field + " é obrigatório"};
+    }
+
+    bool failed() const { return error_.has_value(); }
+
+    bool take(std::string& out, Kind kind, string_t* str) {
+        if (kind != Kind::STRING) {
+            return fail("deve ser texto");
+        }
+        out = std::move(*str);
+        return true;
+    }
+
+    bool take(bool& out, Kind kind, bool flag) {
+        if (kind != Kind::BOOLEAN) {
+            return fail("deve ser true ou false");
+        }
+        out = flag;
+        return true;
+    }
+
+    bool takeMode(ResponseMode& out, Kind kind, bool flag) {
+        bool raw = false;
+        if (!take(raw, kind, flag)) {
+            return false;
+        }
+        out = raw ? ResponseMode::RAW : ResponseMode::PARSED;
+        return true;
+    }
+
+    bool takeMediaType(MediaType& out, Kind kind, string_t* str) {
+        if (kind != Kind::STRING) {
+            return fail("deve ser texto");
+        }
+        auto type = parseMediaType(*str);
+        if (!type.has_value()) {
+            return fail("inválido");
+        }
+        out = type.value();
+        return true;
+    }
+
+    // For other checks that only make sense on the whole body.
+    void reject(std::string field, std::string message) { error_ = DecodeError{std::move(field), std::move(message)}; }
+
+    // Set by decoders that also take a bare array as the body.
+    bool accepts_root_array_ = false;
+
+private:
+    bool scalar(Kind kind, string_t* str, bool flag) {
+        if (frames_.empty()) {
+            return fail("o corpo deve ser um objeto JSON");
+        }
+        if (!value(kind, str, flag)) {
+            return false;
+        }
+        advance();
+        return true;
+    }
+
+    bool open(Kind kind) {
+        if (frames_.empty() && kind == Kind::ARRAY && !accepts_root_array_) {
+            return fail("o corpo deve ser um objeto JSON");
+        }
+        if (!value(kind, nullptr, false)) {
+            return false;
+        }
+        frames_.push_back(Frame{kind == Kind::ARRAY, {}, 0});
+        return true;
+    }
+
+    bool close() {
+        frames_.pop_back();
+        if (!leave()) {
+            return false;
+        }
+        advance();
+        return true;
+    }
+
+    void advance() {
+        if (!frames_.empty() && frames_.back().is_array) {
+            ++frames_.back().index;
+        }
+    }
+
+    std::vector<Frame> frames_;
+    std::optional<DecodeError> error_;
+};
+
+class SendMessageDecoder final : public Decoder {
+public:
+    explicit SendMessageDecoder(SendMessageRequest& out) : out_(out) {}
+
+private:
+    bool value(Kind kind, string_t* str, bool flag) override {
+        if (depth() != 1) {
+            return true;
+        }
+        const auto& name = key(0);
+        if (name == "instance_id") {
+            has_instance_id_ = true;
+            return take(out_.instance_id, kind, str);
+        }
+        if (name == "number") {
+            has_number_ = true;
+            return take(out_.number, kind, str);
+        }
+        if (name == "body") {
+            has_body_ = true;
+            return take(out_.body, kind, str);
+        }
+        if (name == "type") {
+            return takeMediaType(out_.type, kind, str);
+        }
+        if (name == "async") {
+            return take(out_.async, kind, flag);
+        }
+        if (name == "callback_url") {
+            out_.callback_url.emplace();
+            return take(out_.callback_url.value(), kind, str);
+        }
+        if (name == "raw") {
+            return takeMode(out_.mode, kind, flag);
+        }
+        return true;
+    }
+
+    void finish() override {
+        if (!has_instance_id_) {
+            missing("instance_id");
+        } else if (!has_number_) {
+            missing("number");
+        } else if (!has_body_) {
+            missing("body");
+        }
+    }
+
+    SendMessageRequest& out_;
+    bool has_instance_id_ = false;
+    bool has_number_ = false;
+    bool has_body_ = false;
+};
+
+class SendMessagesDecoder final : public Decoder {
+public:
+    explicit SendMessagesDecoder(SendMessagesRequest& out) : out_(out) { accepts_root_array_ = true; }
+
+private:
+    // Depth of the messages themselves: right under the root array, or under "messages".
+    std::size_t itemDepth() const { return isArray(0) ? 1 : 2; }
+    bool inMessages() const { return isArray(0) || (depth() >= 2 && key(0) == "messages"); }
+
+    bool value(Kind kind, string_t* str, bool flag) override {
+        if (depth() == 0) {
+            return true;
+        }
+        if (depth() == 1 && !isArray(0)) {
+            if (key(0) == "messages") {
+                return kind == Kind::ARRAY || fail("deve ser uma lista não vazia");
+            }
+            if (key(0) == "raw") {
+                return takeMode(out_.mode, kind, flag);
+            }
+            return true;
+        }
+        if (!inMessages()) {
+            return true;
+        }
+        if (depth() == itemDepth()) {
+            if (kind != Kind::OBJECT) {
+                return fail("deve ser um objeto");
+            }
+            item_ = OutgoingMessage{{}, {}, {}, MediaType::TEXT};
+            has_instance_id_ = has_number_ = has_body_ = false;
+            return true;
+        }
+        if (depth() != itemDepth() + 1) {
+            return true;
+        }
+        const auto& name = key(itemDepth());
+        if (name == "instance_id") {
+            has_instance_id_ = true;
+            return take(item_.instance_id, kind, str);
+        }
+        if (name == "number") {
+            has_number_ = true;
+            return take(item_.number, kind, str);
+        }
+        if (name == "body") {
+            has_body_ = true;
+            return take(item_.body, kind, str);
+        }
+        if (name == "type") {
+            return takeMediaType(item_.type, kind, str);
+        }
+        return true;
+    }
+
+    // A message object just closed: check it and keep it.
+    bool leave() override {
+        if (depth() == 0 || depth() != itemDepth() || !inMessages()) {
+            return true;
+        }
+        if (!has_instance_id_) {
+            missing("instance_id");
+        } else if (!has_number_) {
+            missing("number");
+        } else if (!has_body_) {
+            missing("body");
+        }
+        if (failed()) {
+            return false;
+        }
+        out_.messages.push_back(std::move(item_));
+        return true;
+    }
+
+    void finish() override {
+        if (out_.messages.empty()) {
+            reject("messages", "messages deve ser uma lista não vazia");
+        }
+    }
+
+    SendMessagesRequest& out_;
+    OutgoingMessage item_{};
+    bool has_instance_id_ = false;
+    bool has_number_ = false;
+    bool has_body_ = false;
+};
+
+class SendTemplateDecoder final : public Decoder {
+public:
+    explicit SendTemplateDecoder(SendTemplateRequest& out) : out_(out) {}
+
+private:
+    bool value(Kind kind, string_t* str, bool flag) override {
+        if (depth() == 0) {
+            return true;
+        }
+        if (depth() == 1) {
+            const auto& name = key(0);
+            if (name == "instance_id") {
+                has_instance_id_ = true;
+                return take(out_.instance_id, kind, str);
+            }
+            if (name == "number") {
+                has_number_ = true;
+                return take(out_.number, kind, str);
+            }
+            if (name == "template_name") {
+                has_template_name_ = true;
+                return take(out_.template_name, kind, str);
+            }
+            if (name == "image_url") {
+                return take(out_.image_url, kind, str);
+            }
+            // null is taken as no variables.
+            if (name == "variables") {
+                return kind == Kind::ARRAY || kind == Kind::NUL || fail("deve ser uma lista");
+            }
+            if (name == "raw") {
+                return takeMode(out_.mode, kind, flag);
+            }
+            return true;
+        }
+        if (key(0) != "variables") {
+            return true;
+        }
+        if (depth() == 2) {
+            if (kind != Kind::OBJECT) {
+                return fail("deve ser um objeto");
+            }
+            variable_ = FB_VARS{VARIABLE_T::TEXT, {}};
+            has_value_ = false;
+            return true;
+        }
+        if (depth() != 3) {
+            return true;
+        }
+        if (key(2) == "type") {
+            std::string type;
+            if (!take(type, kind, str)) {
+                return false;
+            }
+            // Anything unknown is sent as text, as before.
+            if (type == "currency") {
+                variable_.var = VARIABLE_T::CURRENCY;
+            } else if (type == "datetime") {
+                variable_.var = VARIABLE_T::DATE_TIME;
+            } else {
+                variable_.var = VARIABLE_T::TEXT;
+            }
+            return true;
+        }
+        if (key(2) == "value") {
+            has_value_ = true;
+            return take(variable_.body, kind, str);
+        }
+        return true;
+    }
+
+    bool leave() override {
+        if (depth() != 2 || key(0) != "variables") {
+            return true;
+        }
+        if (!has_value_) {
+            missing("value");
+            return false;
+        }
+        out_.variables.push_back(std::move(variable_));
+        return true;
+    }
+
+    void finish() override {
+        if (!has_instance_id_) {
+            missing("instance_id");
+        } else if (!has_number_) {
+            missing("number");
+        } else if (!has_template_name_) {
+            missing("template_name");
+        }
+    }
+
+    SendTemplateRequest& out_;
+    FB_VARS variable_{};
+    bool has_instance_id_ = false;
+    bool has_number_ = false;
+    bool has_template_name_ = false;
+    bool has_value_ = false;
+};
+
+class CreateInstanceDecoder final : public Decoder {
+public:
+    explicit CreateInstanceDecoder(CreateInstanceRequest& out) : out_(out) {}
+
+private:
+    bool value(Kind kind, string_t* str, bool) override {
+        if (depth() != 1) {
+            return true;
+        }
+        const auto& name = key(0);
+        if (name == "instance_id") {
+            has_instance_id_ = true;
+            return take(out_.instance_id, kind, str);
+        }
+        if (name == "instance_name") {
+            has_instance_name_ = true;
+            return take(out_.instance_name, kind, str);
+        }
+        if (name == "api_type") {
+            has_api_type_ = true;
+            if (kind != Kind::STRING) {
+                return fail("deve ser texto");
+            }
+            auto type = parseApiType(*str);
+            if (!type.has_value()) {
+                return fail("inválido");
+            }
+            out_.api_type = type.value();
+            return true;
+        }
+        if (name == "webhook_url") {
+            out_.webhook_url.emplace();
+            return take(out_.webhook_url.value(), kind, str);
+        }
+        if (name == "proxy_url") {
+            return take(out_.proxy_url, kind, str);
+        }
+        if (name == "access_token") {
+            return take(out_.access_token, kind, str);
+        }
+        if (name == "waba_id") {
+            return take(out_.waba_id, kind, str);
+        }
+        return true;
+    }
+
+    void finish() override {
+        if (!has_instance_id_) {
+            missing("instance_id");
+        } else if (!has_instance_name_) {
+            missing("instance_name");
+        } else if (!has_api_type_) {
+            missing("api_type");
+        }
+    }
+
+    CreateInstanceRequest& out_;
+    bool has_instance_id_ = false;
+    bool has_instance_name_ = false;
+    bool has_api_type_ = false;
+};
+
+} // namespace
+
+std::optional<DecodeError> RequestDecoder::decode(std::string_view body, SendMessageRequest& out) {
+    SendMessageDecoder decoder(out);
+    return decoder.run(body);
+}
+
+std::optional<DecodeError> RequestDecoder::decode(std::string_view body, SendMessagesRequest& out) {
+    SendMessagesDecoder decoder(out);
+    return decoder.run(body);
+}
+
+std::optional<DecodeError> RequestDecoder::decode(std::string_view body, SendTemplateRequest& out) {
+    SendTemplateDecoder decoder(out);
+    return decoder.run(body);
+}
+
+std::optional<DecodeError> RequestDecoder::decode(std::string_view body, CreateInstanceRequest& out) {
+    CreateInstanceDecoder decoder(out);
+    return decoder.run(body);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../constants.h"
+#include "../cloud/cloud_constants.h"
+
+typedef struct {
+    std::string instance_id;
+    std::string number;
+    std::string body;
+    MediaType type = MediaType::TEXT;
+    bool async = false;
+    std::optional<std::string> callback_url;
+    ResponseMode mode = ResponseMode::PARSED;
+} SendMessageRequest;
+
+typedef struct {
+    std::vector<OutgoingMessage> messages;
+    ResponseMode mode = ResponseMode::PARSED;
+} SendMessagesRequest;
+
+typedef struct {
+    std::string instance_id;
+    std::string number;
+    std::string template_name;
+    std::string image_url;
+    std::vector<FB_VARS> variables;
+    ResponseMode mode = ResponseMode::PARSED;
+} SendTemplateRequest;
+
+typedef struct {
+    std::string instance_id;
+    std::string instance_name;
+    ApiType api_type = ApiType::EVOLUTION;
+    // Empty when the client did not send one, so the route can fall back to DEFAULT_WEBHOOK.
+    std::optional<std::string> webhook_url;
+    std::string proxy_url;
+    std::string access_token;
+    std::string waba_id;
+} CreateInstanceRequest;
+
+typedef struct {
+    // Path of the offending member, e.g. "messages[3].type"; empty when the body is not valid JSON.
+    std::string field;
+    std::string message;
+} DecodeError;
+
+/* Typed decoders for the busiest endpoints. Each one runs nlohmann's SAX
+   parser over the body and fills the request struct as the values go by,
+   so no DOM is built: strings, media bodies included, are moved out of the
+   lexer's buffer and unknown members are skipped. Nothing throws; the
+   first problem found stops the parse and comes back as a DecodeError,
+   leaving `out` partially filled. */
+class RequestDecoder {
+public:
+    RequestDecoder() = delete;
+
+    static std::optional<DecodeError> decode(std::string_view body, SendMessageRequest& out);
+    // Accepts {"messages": [...], "raw": bool} or a bare array of messages.
+    static std::optional<DecodeError> decode(std::string_view body, SendMessagesRequest& out);
+    static std::optional<DecodeError> decode(std::string_view body, SendTemplateRequest& out);
+    static std::optional<DecodeError> decode(std::string_view body, CreateInstanceRequest& out);
+};
@@ -0,0 +1,203 @@
+#include "router.h"
+#include "query.h"
+#include "logger/logger.h"
+#include "logger/log_policy.h"
+#include "metrics/metrics.h"
+#include <memory>
+
+extern Logger apiLogger;
+
+std::string_view RouteParams::get(std::string_view name) const {
+    for (std::size_t i = 0; i < count_; ++i) {
+        if (params_[i].first == name) {
+            return params_[i].second;
+        }
+    }
+    return {};
+}
+
+Response make_json_response(const Request& req, http::status status, const nlohmann::json& body) {
+    return make_json_response(req, status, body.dump());
+}
+
+Response make_json_response(const Request& req, http::status status, std::string body) {
+    Response res{status, req.version()};
+    res.set(http::field::server, "Beast");
+    res.set(http::field::content_type, "application/json");
+    res.keep_alive(req.keep_alive());
+    res.body() = std::move(body);
+    res.prepare_payload();
+    return res;
+}
+
+Response error_response(const Request& req, http::status status, const std::string& message) {
+    return make_json_response(req, status, nlohmann::json{{"error", message}});
+}
+
+std::string query_param(const Request& req, std::string_view name) {
+    auto target = req.target();
+    return query_value(std::string_view(target.data(), target.size()), name);
+}
+
+std::string_view Router::firstSegment(std::string_view path) {
+    // "/instances/abc" -> "/instances"
+    std::size_t end = path.find('/', 1);
+    return end == std::string_view::npos ? path : path.substr(0, end);
+}
+
+RouteHandler Router::findVerb(const std::vector<VerbHandler>& handlers, http::verb verb) {
+    for (const auto& vh : handlers) {
+        if (vh.verb == verb) {
+            return vh.handler;
+        }
+    }
+    return nullptr;
+}
+
+void Router::add(http::verb verb, std::string_view pattern, RouteHandler handler) {
+    if (pattern.find('{') == std::string_view::npos) {
+        exact_[std::string(pattern)].push_back(VerbHandler{verb, handler});
+        return;
+    }
+
+    std::vector<Segment> segments;
+    std::size_t pos = 1;
+    while (pos <= pattern.size()) {
+        std::size_t end = pattern.find('/', pos);
+        if (end == std::string_view::npos) {
+            end = pattern.size();
+        }
+        std::string_view seg = pattern.substr(pos, end - pos);
+        if (seg.size() >= 2 && seg.front() == '{' && seg.back() == '}') {
+            segments.push_back(Segment{std::string(seg.substr(1, seg.size() - 2)), true});
+        } else {
+            segments.push_back(Segment{std::string(seg), false});
+        }
+        pos = end + 1;
+    }
+
+    auto& bucket = patterns_[std::string(firstSegment(pattern))];
+    for (auto& p : bucket) {
+        bool same = p.segments.size() == segments.size();
+        for (std::size_t i = 0; same && i < segments.size(); ++i) {
+            same = p.segments[i].is_param == segments[i].is_param &&
+                   (segments[i].is_param || p.segments[i].literal == segments[i].literal);
+        }
+        if (same) {
+            p.handlers.push_back(VerbHandler{verb, handler});
+            return;
+        }
+    }
+    bucket.push_back(Pattern{std::string(pattern), std::move(segments), {VerbHandler{verb, handler}}});
+}
+
+Router::Match Router::match(http::verb verb, std::string_view target) const {
+    Match m{nullptr, {}, false, {}};
+    std::string_view path = target.substr(0, target.find('?'));
+
+    if (auto it = exact_.find(path); it != exact_.end()) {
+        m.path_found = true;
+        m.route = it->first;
+        m.handler = findVerb(it->second, verb);
+        return m;
+    }
+
+    auto it = patterns_.find(firstSegment(path));
+    if (it == patterns_.end()) {
+        return m;
+    }
+    for (const auto& pattern : it->second) {
+        RouteParams params;
+        std::size_t pos = 1;
+        std::size_t i = 0;
+        bool ok = true;
+        for (; i < pattern.segments.size(); ++i) {
+            if (pos > path.size()) {
+                ok = false;
+                break;
+            }
+            std::size_t end = path.find('/', pos);
+            if (end == std::string_view::npos) {
+                end = path.size();
+            }
+            std::string_view seg = path.substr(pos, end - pos);
+            const auto& expected = pattern.segments[i];
+            if (expected.is_param) {
+                if (seg.empty() || params.count_ == RouteParams::max_params) {
+                    ok = false;
+                    break;
+                }
+                params.params_[params.count_++] = {expected.literal, seg};
+            } else if (seg != expected.literal) {
+                ok = false;
+                break;
+            }
+            pos = end + 1;
+        }
+        // Every segment of the path has to be consumed, "/instances/a/b" is not "/instances/{id}".
+        if (!ok || pos <= path.size()) {
+            continue;
+        }
+        m.path_found = true;
+        m.route = pattern.route;
+        m.handler = findVerb(pattern.handlers, verb);
+        if (m.handler) {
+            m.params = params;
+            return m;
+        }
+    }
+    return m;
+}
+
+std::string Router::allowed(std::string_view target) const {
+    static constexpr std::array verbs = {http::verb::get, http::verb::head, http::verb::post, http::verb::put,
+                                         http::verb::patch, http::verb::delete_, http::verb::options};
+    std::string allow;
+    for (auto verb : verbs) {
+        if (match(verb, target).handler) {
+            if (!allow.empty()) {
+                allow.append(", ");
+            }
+            auto name = http::to_string(verb);
+            allow.append(name.data(), name.size());
+        }
+    }
+    return allow;
+}
+
+Reply Router::dispatch(const Request& req) const {
+    auto in_flight = std::make_shared<Metrics::InFlight>();
+    auto start = std::chrono::steady_clock::now();
+    auto target = req.target();
+    auto method = req.method_string();
+    Match m = match(req.method(), std::string_view(target.data(), target.size()));
+
+    Reply reply;
+    if (m.handler) {
+        reply = m.handler(req, m.params);
+    } else if (m.path_found) {
+        apiLogger.warn("Método não permitido: {} {}", std::string_view(method.data(), method.size()),
+                       LogPolicy::target(std::string_view(target.data(), target.size())));
+        reply = error_response(req, http::status::method_not_allowed, "Método não permitido");
+        reply.res.set(http::field::allow, allowed(std::string_view(target.data(), target.size())));
+    } else {
+        reply = error_response(req, http::status::not_found, "Endpoint não encontrado");
+    }
+
+    // Observed with the status it completes with; the request stays in flight until then.
+    if (reply.pending) {
+        reply.pending = [pending = std::move(reply.pending), route = m.path_found ? m.route : "unmatched",
+                         method = std::string(method.data(), method.size()), start, in_flight](Completion complete) {
+            pending([complete = std::move(complete), route, method, start, in_flight](Response res) {
+                Metrics::instance().observeRequest(route, method, res.result_int(), Metrics::secondsSince(start));
+                complete(std::move(res));
+            });
+        };
+        return reply;
+    }
+
+    // For streamed replies this is the time to the first byte, the body is produced afterwards.
+    Metrics::instance().observeRequest(m.path_found ? m.route : "unmatched", std::string_view(method.data(), method.size()),
+                                       reply.res.result_int(), Metrics::secondsSince(start));
+    return reply;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <boost/beast/http.hpp>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../../dependencies/json.h"
+
+namespace http = boost::beast::http;
+
+using Request = http::request<http::string_body>;
+using Response = http::response<http::string_body>;
+
+// Values captured from `{name}` segments. They point into the request target, so they are
+// only valid while the request is alive.
+class RouteParams {
+public:
+    static constexpr std::size_t max_params = 4;
+
+    std::string_view get(std::string_view name) const;
+    std::size_t size() const { return count_; }
+
+private:
+    friend class Router;
+    std::array<std::pair<std::string_view, std::string_view>, max_params> params_{};
+    std::size_t count_ = 0;
+};
+
+/* Produces a streamed body piece by piece: fills `chunk` and returns true, or returns false
+   once the body is complete. Each call is its own worker pool job, made only when the
+   connection wants more, so it may block on the database but must not rely on running on
+   the route's thread; calls never overlap. Throwing aborts the response mid-body. */
+using ChunkSource = std::function<bool(std::string& chunk)>;
+
+// Hands the final response of a pending reply back to the connection. Call it exactly once, from any thread.
+using Completion = std::function<void(Response)>;
+// Starts the work behind a pending reply; it returns as soon as that work is handed off.
+using Deferred = std::function<void(Completion)>;
+
+/* What a route answers. Usually a complete response; with `stream` set, `res` is only
+   the status line and headers and the body goes out with chunked transfer encoding as
+   the source produces it, so it never has to be held in memory at once. With `pending`
+   set the answer is not known yet: the connection starts it and writes whatever it
+   completes with, and no thread waits in between. It must not capture the request or
+   the route params, they are gone by then. */
+struct Reply {
+    Reply() = default;
+    Reply(Response r) : res(std::move(r)) {}
+    Reply(Response r, ChunkSource s) : res(std::move(r)), stream(std::move(s)) {}
+    Reply(Deferred d) : pending(std::move(d)) {}
+
+    Response res;
+    ChunkSource stream;
+    Deferred pending;
+};
+
+using RouteHandler = Reply (*)(const Request& req, const RouteParams& params);
+
+// Response with the usual headers and a JSON body, shared by every route.
+Response make_json_response(const Request& req, http::status status, const nlohmann::json& body);
+// Same, for a body that is already serialized JSON.
+Response make_json_response(const Request& req, http::status status, std::string body);
+Response error_response(const Request& req, http::status status, const std::string& message);
+// Percent-decoded value of `name` in the query string, empty when absent.
+std::string query_param(const Request& req, std::string_view name);
+
+/* Maps (verb, path) to a handler. Routes are registered once at startup and the
+   table is read-only afterwards, so it is shared by every thread without locks.
+   Literal paths are a single hash lookup; patterns such as /instances/{id} are
+   bucketed by their first segment and matched segment by segment. Lookups work
+   on string_views of the request target and do not allocate. */
+class Router {
+public:
+    typedef struct {
+        RouteHandler handler;
+        RouteParams params;
+        bool path_found;
+        // The registered pattern, e.g. "/instances/{id}"; used as the metrics label.
+        std::string_view route;
+    } Match;
+
+    void add(http::verb verb, std::string_view pattern, RouteHandler handler);
+    Match match(http::verb verb, std::string_view target) const;
+    // The verbs registered for the path of `target`, e.g. "GET, DELETE", for the Allow header of a 405.
+    std::string allowed(std::string_view target) const;
+    // Resolves the route and runs it, answering 404/405 when nothing matches. Every call is
+    // recorded in the per-route request metrics, pending replies once they complete.
+    Reply dispatch(const Request& req) const;
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+    };
+
+    typedef struct {
+        http::verb verb;
+        RouteHandler handler;
+    } VerbHandler;
+
+    typedef struct {
+        std::string literal;
+        bool is_param;
+    } Segment;
+
+    typedef struct {
+        std::string route;
+        std::vector<Segment> segments;
+        std::vector<VerbHandler> handlers;
+    } Pattern;
+
+    template <typename T>
+    using StringMap = std::unordered_map<std::string, T, StringHash, std::equal_to<>>;
+
+    static RouteHandler findVerb(const std::vector<VerbHandler>& handlers, http::verb verb);
+    static std::string_view firstSegment(std::string_view path);
+
+    StringMap<std::vector<VerbHandler>> exact_;
+    StringMap<std::vector<Pattern>> patterns_;
+};
@@ -0,0 +1,605 @@
+#include "routes.h"
+#include "handler.h"
+#include "logger/logger.h"
+#include "cloud/cloud_api.h"
+#include "api/base64.h"
+#include "api/media.h"
+#include "multipart.h"
+#include "request_decoder.h"
+#include "webhook_auth.h"
+#include "webhook_dispatcher.h"
+#include "metrics/metrics.h"
+#include <charconv>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+extern Logger apiLogger;
+
+namespace {
+
+/* Writes "status_code":...,"status_string":... straight into `out`, the same
+   bytes dumping the equivalent object would give. status_string is serialized
+   once, without being copied into an envelope tree first; a raw_body kept by
+   the provider adapter is spliced in as it came. */
+void append_status_fields(std::string& out, const Status& stat) {
+    out.append(R"("status_code":)");
+    out.append(std::to_string(static_cast<int>(stat.status_code)));
+    out.append(R"(,"status_string":)");
+    if (!stat.raw_body.empty()) {
+        out.append(stat.raw_body);
+    } else {
+        out.append(stat.status_string.dump());
+    }
+}
+
+Response status_response(const Request& req, const Status& stat, http::status ok_status = http::status::ok) {
+    std::string body = "{";
+    append_status_fields(body, stat);
+    body.push_back('}');
+    if (stat.retry_after_s > 0) {
+        auto res = make_json_response(req, http::status::too_many_requests, std::move(body));
+        res.set(http::field::retry_after, std::to_string(stat.retry_after_s));
+        return res;
+    }
+    auto status = stat.status_code == c_status::ERR ? http::status::internal_server_error : ok_status;
+    return make_json_response(req, status, std::move(body));
+}
+
+// The request fields make_json_response uses, copied so a pending reply does not depend on the request.
+Request response_head(const Request& req) {
+    Request head;
+    head.version(req.version());
+    head.keep_alive(req.keep_alive());
+    return head;
+}
+
+/* Answers with the Status a Handler operation completes with, without holding the worker
+   while the provider is asked. `start` runs on the worker once the route returns, so it
+   must capture its arguments by value. */
+Reply deferred_status(const Request& req, std::function<void(StatusCallback)> start, http::status ok_status = http::status::ok) {
+    return Reply([head = response_head(req), start = std::move(start), ok_status](Completion complete) {
+        try {
+            start([head, complete, ok_status](Status stat) {
+                complete(status_response(head, stat, ok_status));
+            });
+        } catch (const std::exception& e) {
+            complete(error_response(head, http::status::bad_request, e.what()));
+        }
+    });
+}
+
+// 400 with the decoder's message and, when there is one, the member it is about.
+Response decode_error_response(const Request& req, const DecodeError& error) {
+    apiLogger.debug("Requisição recusada: {}", error.message);
+    nlohmann::json body{{"error", error.message}};
+    if (!error.field.empty()) {
+        body["field"] = error.field;
+    }
+    return make_json_response(req, http::status::bad_request, body);
+}
+
+nlohmann::json instance_json(const Database::Instance& instance) {
+    nlohmann::json instance_json = {
+        {"instance_id", instance.instance_id},
+        {"instance_name", instance.instance_name},
+        {"instance_type", apiTypeName(instance.instance_type)},
+        {"is_active", instance.is_active}
+    };
+
+    if (instance.webhook_url.has_value()) {
+        instance_json["webhook_url"] = instance.webhook_url.value();
+    }
+    // Where this instance's provider should send its events.
+    auto env = Config::current();
+    instance_json["webhook_receiver"] = WebhookAuth::receiverUrl(instance.instance_id, env->public_url, env->token);
+    if (instance.waba_id.has_value()) {
+        instance_json["waba_id"] = instance.waba_id.value();
+    }
+    if (instance.access_token.has_value()) {
+        instance_json["access_token"] = instance.access_token.value();
+    }
+    if (instance.phone_number_id.has_value()) {
+        instance_json["phone_number_id"] = instance.phone_number_id.value();
+    }
+    return instance_json;
+}
+
+Reply reloadConfig(const Request& req, const RouteParams&) {
+    apiLogger.info("Recarregando configuração a pedido do cliente");
+    Config::reload();
+    if (!apiLogger.set_level(Config::current()->log_level)) {
+        apiLogger.warn("LOG_LEVEL inválido, mantendo o nível atual: {}", apiLogger.level());
+    }
+    nlohmann::json resp_json;
+    resp_json["status_code"] = c_status::OK;
+    resp_json["status_string"] = nlohmann::json{{"message", "Configuration reloaded"}};
+    return make_json_response(req, http::status::ok, resp_json);
+}
+
+Reply getLogLevel(const Request& req, const RouteParams&) {
+    return make_json_response(req, http::status::ok, nlohmann::json{{"level", apiLogger.level()}});
+}
+
+Reply setLogLevel(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string level = body.at("level").get<std::string>();
+        if (!apiLogger.set_level(level)) {
+            return error_response(req, http::status::bad_request, "Invalid log level: " + level);
+        }
+        apiLogger.info("Nível de log alterado para: {}", level);
+        return make_json_response(req, http::status::ok, nlohmann::json{{"level", apiLogger.level()}});
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply metrics(const Request& req, const RouteParams&) {
+    Response res{http::status::ok, req.version()};
+    res.set(http::field::server, "Beast");
+    res.set(http::field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+    res.keep_alive(req.keep_alive());
+    res.body() = Metrics::instance().render();
+    res.prepare_payload();
+    return res;
+}
+
+Reply webhook(const Request& req, const RouteParams&) {
+    if (!WebhookDispatcher::instance().push(query_param(req, "instance_id"), req.body())) {
+        apiLogger.warn("Fila de webhooks cheia, rejeitando evento");
+        auto res = error_response(req, http::status::service_unavailable, "Fila de webhooks cheia, tente novamente");
+        res.set(http::field::retry_after, std::to_string(std::max(Config::current()->retry_after_s, 1)));
+        res.prepare_payload();
+        return res;
+    }
+    nlohmann::json resp_json;
+    resp_json["status_code"] = c_status::OK;
+    resp_json["status_string"] = nlohmann::json{{"webhook", "Webhook queued"}};
+    return make_json_response(req, http::status::ok, resp_json);
+}
+
+Reply createInstance(const Request& req, const RouteParams&) {
+    try {
+        Config cfg;
+        const auto& env = cfg.getEnv();
+        CreateInstanceRequest body;
+        if (auto error = RequestDecoder::decode(req.body(), body)) {
+            return decode_error_response(req, error.value());
+        }
+
+        apiLogger.debug("Criando instância: ID={}, Nome={}, Tipo={}", body.instance_id, body.instance_name, apiTypeName(body.api_type));
+
+        return deferred_status(req, [webhook_url = body.webhook_url.value_or(env.default_webhook), body = std::move(body)](StatusCallback done) {
+            Handler::createInstance(body.instance_id, body.instance_name, body.api_type, webhook_url, body.proxy_url, body.access_token, body.waba_id,
+                                    std::move(done));
+        });
+    } catch (const std::exception& e) {
+        apiLogger.error("Erro ao processar requisição createInstance: {}", e.what());
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply sendMessage(const Request& req, const RouteParams&) {
+    try {
+        // The media payload is moved out of the parser's buffer into msg.body, not copied.
+        SendMessageRequest msg;
+        if (auto error = RequestDecoder::decode(req.body(), msg)) {
+            return decode_error_response(req, error.value());
+        }
+
+        apiLogger.debug("Enviando mensagem: Instância={}, Número={}, Tipo={}", msg.instance_id, msg.number, mediaTypeName(msg.type));
+
+        if (msg.async) {
+            Status stat = Handler::queueMessage(msg.instance_id, msg.number, msg.body, msg.type, msg.callback_url);
+            return status_response(req, stat, http::status::accepted);
+        }
+        // Shared with the completion, the provider streams the body from it until the send is answered.
+        auto shared = std::make_shared<SendMessageRequest>(std::move(msg));
+        return deferred_status(req, [shared](StatusCallback done) {
+            Handler::sendMessage(shared->instance_id, shared->number, shared->body, shared->type, shared->mode,
+                                 [shared, done = std::move(done)](Status stat) { done(std::move(stat)); });
+        });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply getMessage(const Request& req, const RouteParams& params) {
+    std::string_view id = params.get("id");
+    long long message_id = 0;
+    auto [end, ec] = std::from_chars(id.data(), id.data() + id.size(), message_id);
+    if (ec != std::errc() || end != id.data() + id.size()) {
+        return error_response(req, http::status::bad_request, "id inválido");
+    }
+    auto message = Handler::getMessage(message_id);
+    if (!message.has_value()) {
+        return error_response(req, http::status::not_found, "Mensagem não encontrada");
+    }
+    nlohmann::json message_json = {
+        {"message_id", message->id},
+        {"instance_id", message->instance_id},
+        {"number", message->number},
+        {"type", message->type},
+        {"status", message->status},
+        {"attempts", message->attempts},
+        {"created_at", message->created_at},
+        {"updated_at", message->updated_at}
+    };
+    if (message->callback_url.has_value()) {
+        message_json["callback_url"] = message->callback_url.value();
+    }
+    // Both columns hold the provider's JSON answer, kept as text when it was not JSON.
+    auto stored = [](const std::string& text) {
+        auto parsed = nlohmann::json::parse(text, nullptr, false);
+        return parsed.is_discarded() ? nlohmann::json(text) : parsed;
+    };
+    if (message->last_error.has_value()) {
+        message_json["last_error"] = stored(message->last_error.value());
+    }
+    if (message->result.has_value()) {
+        message_json["result"] = stored(message->result.value());
+    }
+    return make_json_response(req, http::status::ok, nlohmann::json{{"status", "success"}, {"message", message_json}});
+}
+
+Reply sendMedia(const Request& req, const RouteParams&) {
+    try {
+        std::string instance_id;
+        std::string number;
+        std::string type_str;
+        std::string_view declared_type;
+        std::string_view file;
+
+        auto content_type_header = req[http::field::content_type];
+        std::string_view content_type(content_type_header.data(), content_type_header.size());
+        if (std::string_view boundary = Multipart::boundary(content_type); !boundary.empty()) {
+            auto parts = Multipart::parse(req.body(), boundary);
+            if (!parts.has_value()) {
+                return error_response(req, http::status::bad_request, "Corpo multipart inválido");
+            }
+            for (const auto& part : parts.value()) {
+                if (part.name == "instance_id") {
+                    instance_id = part.data;
+                } else if (part.name == "number") {
+                    number = part.data;
+                } else if (part.name == "type") {
+                    type_str = part.data;
+                } else if (part.name == "file" || (file.empty() && !part.filename.empty())) {
+                    file = part.data;
+                    declared_type = part.content_type;
+                }
+            }
+        } else {
+            instance_id = query_param(req, "instance_id");
+            number = query_param(req, "number");
+            type_str = query_param(req, "type");
+            declared_type = content_type;
+            file = req.body();
+        }
+
+        if (instance_id.empty() || number.empty()) {
+            return error_response(req, http::status::bad_request, "instance_id e number são obrigatórios");
+        }
+        if (file.empty()) {
+            return error_response(req, http::status::bad_request, "Arquivo ausente");
+        }
+
+        auto sniffed = Media::sniff(file);
+        MediaType type = sniffed ? sniffed->type : MediaType::DOCUMENT;
+        if (!type_str.empty()) {
+            auto parsed_type = parseMediaType(type_str);
+            if (!parsed_type.has_value() || parsed_type.value() == MediaType::TEXT) {
+                apiLogger.error("Tipo de mídia inválido: {}", type_str);
+                return error_response(req, http::status::bad_request, "type inválido");
+            }
+            type = parsed_type.value();
+        }
+
+        std::string_view mime = "application/octet-stream";
+        if (sniffed) {
+            mime = sniffed->mime;
+        } else if (!declared_type.empty() && declared_type.find('/') != std::string_view::npos) {
+            mime = declared_type.substr(0, declared_type.find(';'));
+        }
+
+        // The providers take base64 data URLs; the file is encoded once, straight after the prefix.
+        std::string data_url;
+        data_url.reserve(std::string_view("data:;base64,").size() + mime.size() + Base64::encodedSize(file.size()));
+        data_url.append("data:").append(mime).append(";base64,");
+        Base64::encode(file, data_url);
+
+        apiLogger.debug("Enviando mídia: Instância={}, Número={}, MIME={}, Tamanho={}", instance_id, number, mime, file.size());
+        const auto mode = query_param(req, "raw") == "true" ? ResponseMode::RAW : ResponseMode::PARSED;
+        auto shared = std::make_shared<std::string>(std::move(data_url));
+        return deferred_status(req, [shared, instance_id = std::move(instance_id), number = std::move(number), type, mode](StatusCallback done) {
+            Handler::sendMessage(instance_id, number, *shared, type, mode, [shared, done = std::move(done)](Status stat) { done(std::move(stat)); });
+        });
+    } catch (const std::exception& e) {
+        apiLogger.error("Erro ao processar requisição sendMedia: {}", e.what());
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply sendMessages(const Request& req, const RouteParams&) {
+    try {
+        Config cfg;
+        const auto& env = cfg.getEnv();
+        SendMessagesRequest body;
+        if (auto error = RequestDecoder::decode(req.body(), body)) {
+            return decode_error_response(req, error.value());
+        }
+        if (env.bulk_max_items > 0 && body.messages.size() > static_cast<std::size_t>(env.bulk_max_items)) {
+            return error_response(req, http::status::payload_too_large,
+                                  "Máximo de " + std::to_string(env.bulk_max_items) + " mensagens por requisição");
+        }
+
+        auto messages = std::make_shared<const std::vector<OutgoingMessage>>(std::move(body.messages));
+        return Reply([head = response_head(req), messages, mode = body.mode](Completion complete) {
+            Handler::sendMessages(messages, mode, [head, messages, complete](std::vector<Status> statuses) {
+                std::size_t sent = 0;
+                for (const auto& stat : statuses) {
+                    if (stat.status_code == c_status::OK) {
+                        ++sent;
+                    }
+                }
+
+                // Written out in the key order nlohmann would use, so each result is serialized once.
+                std::string out = R"({"count":)" + std::to_string(statuses.size()) +
+                                  R"(,"failed":)" + std::to_string(statuses.size() - sent) + R"(,"results":[)";
+                for (std::size_t i = 0; i < statuses.size(); ++i) {
+                    if (i > 0) {
+                        out.push_back(',');
+                    }
+                    out.append(R"({"index":)").append(std::to_string(i));
+                    out.append(R"(,"instance_id":)").append(nlohmann::json((*messages)[i].instance_id).dump());
+                    out.append(R"(,"number":)").append(nlohmann::json((*messages)[i].number).dump());
+                    out.push_back(',');
+                    append_status_fields(out, statuses[i]);
+                    out.push_back('}');
+                }
+                out.append(R"(],"sent":)").append(std::to_string(sent)).push_back('}');
+                complete(make_json_response(head, http::status::ok, std::move(out)));
+            });
+        });
+    } catch (const std::exception& e) {
+        apiLogger.error("Erro ao processar requisição sendMessages: {}", e.what());
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply deleteInstance(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string instance_id = body.at("instance_id").get<std::string>();
+        return deferred_status(req, [instance_id](StatusCallback done) { Handler::deleteInstance(instance_id, std::move(done)); });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply logoutInstance(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string instance_id = body.at("instance_id").get<std::string>();
+        return deferred_status(req, [instance_id](StatusCallback done) { Handler::logoutInstance(instance_id, std::move(done)); });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+// Rows fetched per database round trip while streaming a full listing.
+constexpr std::size_t kInstanceStreamPage = 500;
+constexpr std::size_t kMaxInstancePage = 1000;
+
+Reply retrieveInstances(const Request& req, const RouteParams&) {
+    Database::InstanceQuery query{};
+    if (auto type = query_param(req, "type"); !type.empty()) {
+        query.type = parseApiType(type);
+        if (!query.type.has_value()) {
+            return error_response(req, http::status::bad_request, "type inválido");
+        }
+    }
+    if (auto active = query_param(req, "active"); !active.empty()) {
+        if (active != "true" && active != "false") {
+            return error_response(req, http::status::bad_request, "active deve ser true ou false");
+        }
+        query.active = active == "true";
+    }
+    query.after = query_param(req, "after");
+
+    const auto limit = query_param(req, "limit");
+    if (!limit.empty()) {
+        std::size_t n = 0;
+        auto [ptr, ec] = std::from_chars(limit.data(), limit.data() + limit.size(), n);
+        if (ec != std::errc() || ptr != limit.data() + limit.size() || n == 0 || n > kMaxInstancePage) {
+            return error_response(req, http::status::bad_request,
+                                  "limit deve estar entre 1 e " + std::to_string(kMaxInstancePage));
+        }
+        query.limit = n;
+
+        auto page = Handler::retrieveInstances(query);
+        if (!page.has_value()) {
+            return error_response(req, http::status::internal_server_error, "Falha ao listar instâncias");
+        }
+
+        std::string body = R"({"status":"success","count":)";
+        body.append(std::to_string(page->instances.size()));
+        body.append(R"(,"instances":[)");
+        for (std::size_t i = 0; i < page->instances.size(); ++i) {
+            if (i > 0) body.push_back(',');
+            body.append(instance_json(page->instances[i]).dump());
+        }
+        body.push_back(']');
+        if (!page->next_after.empty()) {
+            body.append(R"(,"next_after":)");
+            body.append(nlohmann::json(page->next_after).dump());
+        }
+        body.push_back('}');
+        apiLogger.debug("Retrieved {} instances", page->instances.size());
+        return make_json_response(req, http::status::ok, std::move(body));
+    }
+
+    // No limit: walk every page and stream it, so the listing is never held in memory whole.
+    // The first page is fetched here, so a database failure still gets a proper 500.
+    query.limit = kInstanceStreamPage;
+    auto first = Handler::retrieveInstances(query);
+    if (!first.has_value()) {
+        return error_response(req, http::status::internal_server_error, "Falha ao listar instâncias");
+    }
+
+    auto head = make_json_response(req, http::status::ok, std::string());
+    head.chunked(true);
+
+    struct Cursor {
+        Database::InstanceQuery query;
+        std::optional<Database::InstancePage> page;
+        std::size_t count = 0;
+        bool opened = false;
+        bool done = false;
+    };
+    auto cursor = std::make_shared<Cursor>(Cursor{query, std::move(first)});
+
+    ChunkSource source = [cursor](std::string& chunk) {
+        if (cursor->done) {
+            return false;
+        }
+        if (!cursor->opened) {
+            cursor->opened = true;
+            chunk = R"({"status":"success","instances":[)";
+        }
+        while (!cursor->page.has_value() || cursor->page->instances.empty()) {
+            if (cursor->page.has_value() && cursor->page->next_after.empty()) {
+                chunk.append(R"(],"count":)");
+                chunk.append(std::to_string(cursor->count));
+                chunk.push_back('}');
+                cursor->done = true;
+                apiLogger.debug("Streamed {} instances", cursor->count);
+                return true;
+            }
+            if (cursor->page.has_value()) {
+                cursor->query.after = std::move(cursor->page->next_after);
+            }
+            cursor->page = Handler::retrieveInstances(cursor->query);
+            if (!cursor->page.has_value()) {
+                throw std::runtime_error("Falha ao listar instâncias");
+            }
+        }
+        for (const auto& instance : cursor->page->instances) {
+            if (cursor->count++ > 0) chunk.push_back(',');
+            chunk.append(instance_json(instance).dump());
+        }
+        cursor->page->instances.clear();
+        return true;
+    };
+    return Reply(std::move(head), std::move(source));
+}
+
+Reply getInstance(const Request& req, const RouteParams& params) {
+    std::string instance_id(params.get("id"));
+    try {
+        auto instance = Handler::getInstance(instance_id);
+        if (!instance.has_value()) {
+            return error_response(req, http::status::not_found, "Instância não encontrada");
+        }
+        nlohmann::json resp_json;
+        resp_json["status"] = "success";
+        resp_json["instance"] = instance_json(instance.value());
+        return make_json_response(req, http::status::ok, resp_json);
+    } catch (const std::exception& e) {
+        apiLogger.error("Error processing getInstance request: {}", e.what());
+        return error_response(req, http::status::internal_server_error, e.what());
+    }
+}
+
+Reply connectInstance(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string instance_id = body.at("instance_id").get<std::string>();
+        return deferred_status(req, [instance_id](StatusCallback done) { Handler::connectInstance(instance_id, std::move(done)); });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply setWebhook(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string instance_id = body.at("instance_id").get<std::string>();
+        std::string webhook_url = body.at("webhook_url").get<std::string>();
+        return deferred_status(req, [instance_id, webhook_url](StatusCallback done) {
+            Handler::setWebhook(instance_id, webhook_url, std::move(done));
+        });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply sendTemplate(const Request& req, const RouteParams&) {
+    try {
+        SendTemplateRequest body;
+        if (auto error = RequestDecoder::decode(req.body(), body)) {
+            return decode_error_response(req, error.value());
+        }
+        const MediaType type = body.image_url.empty() ? MediaType::TEXT : MediaType::IMAGE;
+
+        apiLogger.debug("Sending template message: Instance={}, Number={}, Template={}, Variables={}", body.instance_id, body.number, body.template_name, body.variables.size());
+
+        return deferred_status(req, [body = std::move(body), type](StatusCallback done) {
+            Handler::sendTemplate(body.instance_id, body.number, body.image_url, type, body.variables, body.template_name, body.mode, std::move(done));
+        });
+    } catch (const std::exception& e) {
+        apiLogger.error("Error processing sendTemplate request: {}", e.what());
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Reply createGroup(const Request& req, const RouteParams&) {
+    try {
+        auto body = nlohmann::json::parse(req.body());
+        std::string instance_id = body.at("instance_id").get<std::string>();
+        std::string subject = body.at("subject").get<std::string>();
+        std::string description = body.at("description").get<std::string>();
+        std::vector<std::string> participants;
+        if (body.contains("participants") && body["participants"].is_array()) {
+            for (const auto& p : body["participants"]) {
+                participants.push_back(p.get<std::string>());
+            }
+        }
+        return deferred_status(req, [instance_id, subject, description, participants = std::move(participants)](StatusCallback done) {
+            Handler::createGroup(instance_id, subject, description, participants, std::move(done));
+        });
+    } catch (const std::exception& e) {
+        return error_response(req, http::status::bad_request, e.what());
+    }
+}
+
+Router buildRoutes() {
+    Router router;
+    router.add(http::verb::post, "/reloadConfig", reloadConfig);
+    router.add(http::verb::get, "/logLevel", getLogLevel);
+    router.add(http::verb::put, "/logLevel", setLogLevel);
+    router.add(http::verb::get, "/metrics", metrics);
+    router.add(http::verb::post, "/createInstance", createInstance);
+    router.add(http::verb::post, "/sendMessage", sendMessage);
+    router.add(http::verb::post, "/sendMessages", sendMessages);
+    router.add(http::verb::post, "/sendMedia", sendMedia);
+    router.add(http::verb::get, "/messages/{id}", getMessage);
+    router.add(http::verb::post, "/webhook", webhook);
+    router.add(http::verb::delete_, "/deleteInstance", deleteInstance);
+    router.add(http::verb::delete_, "/logoutInstance", logoutInstance);
+    router.add(http::verb::get, "/retrieveInstances", retrieveInstances);
+    router.add(http::verb::get, "/instances/{id}", getInstance);
+    router.add(http::verb::post, "/connectInstance", connectInstance);
+    router.add(http::verb::post, "/setWebhook", setWebhook);
+    router.add(http::verb::post, "/sendTemplate", sendTemplate);
+    router.add(http::verb::post, "/createGroup", createGroup);
+    return router;
+}
+
+} // namespace
+
+const Router& apiRoutes() {
+    static const Router router = buildRoutes();
+    return router;
+}
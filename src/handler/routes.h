@@ -0,0 +1,6 @@
+#pragma once
+
+#include "router.h"
+
+// Route table for the public API, built on first use.
+const Router& apiRoutes();
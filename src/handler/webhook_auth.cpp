@@ -0,0 +1,37 @@
+#include "webhook_auth.h"
+#include "query.h"
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+std::string WebhookAuth::secretFor(std::string_view instance_id, std::string_view token) {
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    HMAC(EVP_sha256(), token.data(), static_cast<int>(token.size()), reinterpret_cast<const unsigned char*>(instance_id.data()),
+         instance_id.size(), digest, &length);
+
+    static const char hex[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(length * 2);
+    for (unsigned int i = 0; i < length; ++i) {
+        out += hex[digest[i] >> 4];
+        out += hex[digest[i] & 0x0f];
+    }
+    return out;
+}
+
+std::string WebhookAuth::receiverPath(std::string_view instance_id, std::string_view token) {
+    return "/webhook?instance_id=" + percent_encode(instance_id) + "&secret=" + secretFor(instance_id, token);
+}
+
+std::string WebhookAuth::receiverUrl(std::string_view instance_id, std::string_view public_url, std::string_view token) {
+    return std::string(public_url) + receiverPath(instance_id, token);
+}
+
+bool WebhookAuth::accepts(std::string_view instance_id, std::string_view secret, std::string_view token) {
+    if (instance_id.empty() || token.empty()) {
+        return false;
+    }
+    const std::string expected = secretFor(instance_id, token);
+    return secret.size() == expected.size() && CRYPTO_memcmp(secret.data(), expected.data(), expected.size()) == 0;
+}
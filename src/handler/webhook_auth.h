@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/* Who may post events to /webhook, and where each provider should post them.
+
+   Providers cannot add headers to their webhooks, so each instance gets its
+   own receiver URL, /webhook?instance_id=<id>&secret=<hex>, instead of
+   carrying the API TOKEN in the query string. The secret is
+   HMAC-SHA256(TOKEN, instance_id): nothing is stored, a leaked receiver URL
+   only lets someone inject events for that one instance, and rotating TOKEN
+   rotates every secret. The receiver URL is what gets registered with the
+   provider; the instance's webhook_url is only where events are forwarded. */
+class WebhookAuth {
+public:
+    WebhookAuth() = delete;
+
+    static std::string secretFor(std::string_view instance_id, std::string_view token);
+    // Path and query the provider should call for this instance.
+    static std::string receiverPath(std::string_view instance_id, std::string_view token);
+    // receiverPath under PUBLIC_URL; just the path while public_url is empty.
+    static std::string receiverUrl(std::string_view instance_id, std::string_view public_url, std::string_view token);
+    // Constant-time check of the secret given in the query string.
+    static bool accepts(std::string_view instance_id, std::string_view secret, std::string_view token);
+};
@@ -0,0 +1,223 @@
+#include "webhook_dispatcher.h"
+#include "api/http_client.h"
+#include "config/config.h"
+#include "database/instance_cache.h"
+#include "logger/logger.h"
+#include "logger/log_policy.h"
+#include <algorithm>
+
+extern Logger apiLogger;
+
+namespace {
+
+size_t discardBody(void*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+// Evolution sends the instance token as "apikey", WuzAPI as "token"; both are our instance_id.
+std::string instanceFromPayload(const std::string& payload) {
+    auto json = nlohmann::json::parse(payload, nullptr, false);
+    if (!json.is_object()) {
+        return {};
+    }
+    for (const char* key : {"apikey", "token", "instance_id"}) {
+        if (auto it = json.find(key); it != json.end() && it->is_string()) {
+            return it->get<std::string>();
+        }
+    }
+    return {};
+}
+
+} // namespace
+
+WebhookDispatcher& WebhookDispatcher::instance() {
+    static WebhookDispatcher dispatcher;
+    return dispatcher;
+}
+
+WebhookDispatcher::~WebhookDispatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void WebhookDispatcher::start() {
+    if (thread_.joinable()) {
+        return;
+    }
+    thread_ = std::thread([this] { run(); });
+}
+
+bool WebhookDispatcher::push(std::string instance_id, std::string payload) {
+    auto capacity = static_cast<std::size_t>(std::max(Config::current()->webhook_queue_size, 1));
+    auto event = std::make_unique<Event>(Event{std::move(instance_id), std::move(payload), {}, 0});
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (queue_.size() >= capacity) {
+            ++rejected_;
+            return false;
+        }
+        queue_.push_back(std::move(event));
+        ++received_;
+    }
+    cv_.notify_one();
+    return true;
+}
+
+WebhookDispatcher::Metrics WebhookDispatcher::metrics() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return Metrics{queue_.size(), in_flight_, retries_.size(), received_, rejected_, forwarded_, retried_, dead_lettered_, dropped_};
+}
+
+void WebhookDispatcher::run() {
+    std::vector<EventPtr> batch;
+    std::vector<Database::DeadLetter> letters;
+    while (true) {
+        Config cfg;
+        const auto& env = cfg.getEnv();
+        const std::size_t max_in_flight = static_cast<std::size_t>(std::max(env.webhook_max_in_flight, 1));
+        const std::size_t batch_size = static_cast<std::size_t>(std::max(env.webhook_batch_size, 1));
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            auto ready = [&] {
+                if (stopping_ || !dead_letters_.empty()) {
+                    return true;
+                }
+                if (in_flight_ >= max_in_flight) {
+                    return false;
+                }
+                return !queue_.empty() || (!retries_.empty() && retries_.begin()->first <= std::chrono::steady_clock::now());
+            };
+            // Completions can schedule an earlier retry while we sleep, so the deadline is re-read on every wakeup.
+            while (!ready()) {
+                if (!retries_.empty() && in_flight_ < max_in_flight) {
+                    cv_.wait_until(lock, retries_.begin()->first);
+                } else {
+                    cv_.wait(lock);
+                }
+            }
+            if (stopping_) {
+                return;
+            }
+
+            // Retries that are due go first, then new events, without going over the in-flight limit.
+            const auto now = std::chrono::steady_clock::now();
+            while (batch.size() < batch_size && in_flight_ + batch.size() < max_in_flight &&
+                   !retries_.empty() && retries_.begin()->first <= now) {
+                batch.push_back(std::move(retries_.begin()->second));
+                retries_.erase(retries_.begin());
+            }
+            while (batch.size() < batch_size && in_flight_ + batch.size() < max_in_flight && !queue_.empty()) {
+                batch.push_back(std::move(queue_.front()));
+                queue_.pop_front();
+            }
+            in_flight_ += batch.size();
+            letters.swap(dead_letters_);
+        }
+
+        for (auto& event : batch) {
+            if (event->attempts == 0 && !resolve(*event)) {
+                std::lock_guard<std::mutex> lock(mtx_);
+                --in_flight_;
+                ++dropped_;
+                continue;
+            }
+            forward(std::move(event));
+        }
+        batch.clear();
+        flushDeadLetters(letters);
+    }
+}
+
+bool WebhookDispatcher::resolve(Event& event) {
+    if (event.instance_id.empty()) {
+        event.instance_id = instanceFromPayload(event.payload);
+    }
+    if (!event.instance_id.empty()) {
+        if (auto inst = InstanceCache::instance().get(event.instance_id); inst.has_value() && inst->webhook_url.has_value()) {
+            event.url = inst->webhook_url.value();
+        }
+    }
+    if (event.url.empty()) {
+        event.url = Config::current()->default_webhook;
+    }
+    if (event.url.empty()) {
+        apiLogger.debug("Webhook da instância {} descartado, nenhuma URL de encaminhamento configurada", event.instance_id);
+        return false;
+    }
+    return true;
+}
+
+void WebhookDispatcher::forward(EventPtr event) {
+    ++event->attempts;
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        completed(std::move(event), false, "Failed to initialize CURL");
+        return;
+    }
+    struct curl_slist* headers = nullptr;
+    headers = curl_slist_append(headers, "Content-Type: application/json");
+    if (!event->instance_id.empty()) {
+        headers = curl_slist_append(headers, ("X-Instance-Id: " + event->instance_id).c_str());
+    }
+    curl_easy_setopt(curl, CURLOPT_URL, event->url.c_str());
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDS, event->payload.data());
+    curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(event->payload.size()));
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(std::max(Config::current()->webhook_timeout_ms, 1)));
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, discardBody);
+
+    // The payload and headers must outlive the transfer, the completion owns them.
+    auto* raw = event.release();
+    HttpClient::instance().async_perform(curl, [this, raw, curl, headers](HttpResult res) {
+        EventPtr owned(raw);
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(curl);
+        bool ok = res.code == CURLE_OK && res.http_code >= 200 && res.http_code < 300;
+        std::string error = res.code != CURLE_OK ? res.error : "HTTP " + std::to_string(res.http_code);
+        completed(std::move(owned), ok, ok ? std::string() : std::move(error));
+    }, {"WEBHOOK", "forward", false});
+}
+
+// Runs on the HttpClient thread: only bookkeeping, the dead-letter INSERT happens on the dispatcher thread.
+void WebhookDispatcher::completed(EventPtr event, bool ok, std::string error) {
+    auto env = Config::current();
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        --in_flight_;
+        if (ok) {
+            ++forwarded_;
+        } else if (event->attempts < std::max(env->webhook_max_attempts, 1)) {
+            ++retried_;
+            const long long base = std::max(env->webhook_backoff_ms, 1);
+            const auto delay = std::chrono::milliseconds(base << std::min(event->attempts - 1, 16));
+            apiLogger.warn("Falha ao encaminhar webhook da instância {} para {} ({}), tentativa {} em {}ms",
+                           event->instance_id, LogPolicy::target(event->url), error, event->attempts + 1, delay.count());
+            retries_.emplace(std::chrono::steady_clock::now() + delay, std::move(event));
+        } else {
+            ++dead_lettered_;
+            apiLogger.error("Webhook da instância {} não entregue após {} tentativas: {} - {}",
+                            event->instance_id, event->attempts, error, LogPolicy::body(event->payload));
+            dead_letters_.push_back(Database::DeadLetter{event->instance_id, event->url, std::move(event->payload), event->attempts, std::move(error)});
+        }
+    }
+    cv_.notify_one();
+}
+
+void WebhookDispatcher::flushDeadLetters(std::vector<Database::DeadLetter>& letters) {
+    if (letters.empty()) {
+        return;
+    }
+    Database db;
+    if (auto connection = db.connect(Config::current()->db_url); connection.status_code == c_status::ERR) {
+        apiLogger.error("Erro ao conectar ao banco de dados, {} webhooks não entregues perdidos: {}", letters.size(), connection.status_string.dump());
+    } else {
+        db.insertDeadLetters(letters);
+    }
+    letters.clear();
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../database/database.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Forwards provider events received on /webhook to each instance's
+   webhook_url (or DEFAULT_WEBHOOK).
+
+   push() only appends to a bounded in-memory queue (WEBHOOK_QUEUE_SIZE), so
+   the route answers without touching the database or the network. A single
+   dispatcher thread takes events off the queue in batches, resolves the
+   instance from InstanceCache and hands the forward to HttpClient, which
+   keeps the keep-alive connections to each destination; up to
+   WEBHOOK_MAX_IN_FLIGHT forwards run at once. A failed forward (curl error
+   or non-2xx) is retried with backoff up to WEBHOOK_MAX_ATTEMPTS times and
+   then written, batched, to wasolution_webhook_dead_letters. Events are lost
+   if the process stops while they are queued. */
+class WebhookDispatcher {
+public:
+    typedef struct {
+        std::size_t queued;
+        std::size_t in_flight;
+        std::size_t retrying;
+        std::uint64_t received;
+        std::uint64_t rejected;
+        std::uint64_t forwarded;
+        std::uint64_t retried;
+        std::uint64_t dead_lettered;
+        std::uint64_t dropped;
+    } Metrics;
+
+    static WebhookDispatcher& instance();
+
+    void start();
+    // False when the queue is full. instance_id may be empty, it is then read from the payload.
+    bool push(std::string instance_id, std::string payload);
+    Metrics metrics() const;
+
+    WebhookDispatcher(const WebhookDispatcher&) = delete;
+    WebhookDispatcher& operator=(const WebhookDispatcher&) = delete;
+
+private:
+    typedef struct {
+        std::string instance_id;
+        std::string payload;
+        std::string url;
+        int attempts;
+    } Event;
+
+    typedef std::unique_ptr<Event> EventPtr;
+
+    WebhookDispatcher() = default;
+    ~WebhookDispatcher();
+
+    void run();
+    // Fills in instance_id and url; false when the event has nowhere to go.
+    bool resolve(Event& event);
+    void forward(EventPtr event);
+    void completed(EventPtr event, bool ok, std::string error);
+    void flushDeadLetters(std::vector<Database::DeadLetter>& letters);
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<EventPtr> queue_;
+    // Keyed by when the next attempt is due.
+    std::multimap<std::chrono::steady_clock::time_point, EventPtr> retries_;
+    std::vector<Database::DeadLetter> dead_letters_;
+    std::size_t in_flight_ = 0;
+    std::uint64_t received_ = 0;
+    std::uint64_t rejected_ = 0;
+    std::uint64_t forwarded_ = 0;
+    std::uint64_t retried_ = 0;
+    std::uint64_t dead_lettered_ = 0;
+    std::uint64_t dropped_ = 0;
+    bool stopping_ = false;
+    std::thread thread_;
+};
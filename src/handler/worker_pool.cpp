@@ -0,0 +1,98 @@
+#include "worker_pool.h"
+#include "config/config.h"
+#include "logger/logger.h"
+
+extern Logger apiLogger;
+
+WorkerPool& WorkerPool::instance() {
+    static WorkerPool pool = [] {
+        Config cfg;
+        const auto& env = cfg.getEnv();
+        std::size_t threads = env.worker_threads > 0 ? static_cast<std::size_t>(env.worker_threads) : 1;
+        std::size_t depth = env.worker_queue_depth > 0 ? static_cast<std::size_t>(env.worker_queue_depth) : 1;
+        return WorkerPool(threads, depth);
+    }();
+    return pool;
+}
+
+WorkerPool::WorkerPool(std::size_t threads, std::size_t queue_depth) : queue_depth_(queue_depth) {
+    apiLogger.info("Iniciando {} workers com fila de até {} requisições", threads, queue_depth);
+    threads_.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back([this] { work(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+}
+
+bool WorkerPool::try_submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (stopping_ || jobs_.size() >= queue_depth_) {
+            ++rejected_;
+            return false;
+        }
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void WorkerPool::submit(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        jobs_.push_back(std::move(job));
+    }
+    cv_.notify_one();
+}
+
+void WorkerPool::work() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+            ++active_;
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            apiLogger.error("Erro não tratado no worker: {}", e.what());
+        } catch (...) {
+            apiLogger.error("Erro desconhecido no worker");
+        }
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        --active_;
+        ++completed_;
+    }
+}
+
+WorkerPool::Metrics WorkerPool::metrics() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    Metrics m{};
+    m.threads = threads_.size();
+    m.queue_depth = queue_depth_;
+    m.queued = jobs_.size();
+    m.active = active_;
+    m.completed = completed_;
+    m.rejected = rejected_;
+    return m;
+}
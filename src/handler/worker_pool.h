@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Fixed set of threads that run request handlers, so DB queries and provider
+   calls never block the network threads. The queue in front of it is bounded:
+   once it is full try_submit() refuses the job and the caller sheds the
+   request instead of letting latency grow without limit. Continuations of
+   requests that were already admitted go through submit(), which never
+   refuses: dropping them would leave the client without an answer. */
+class WorkerPool {
+public:
+    using Job = std::function<void()>;
+
+    typedef struct {
+        std::size_t threads;
+        std::size_t queue_depth;
+        std::size_t queued;
+        std::size_t active;
+        std::uint64_t completed;
+        std::uint64_t rejected;
+    } Metrics;
+
+    static WorkerPool& instance();
+
+    // Returns false without queueing the job when the queue is full.
+    bool try_submit(Job job);
+    // Always queues; only for follow-up work of a job that try_submit() accepted.
+    void submit(Job job);
+    Metrics metrics() const;
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+private:
+    WorkerPool(std::size_t threads, std::size_t queue_depth);
+    ~WorkerPool();
+
+    void work();
+
+    const std::size_t queue_depth_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<Job> jobs_;
+    std::vector<std::thread> threads_;
+    std::size_t active_ = 0;
+    std::uint64_t completed_ = 0;
+    std::uint64_t rejected_ = 0;
+    bool stopping_ = false;
+};
@@ -0,0 +1,147 @@
+#include "log_policy.h"
+#include "config/config.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+
+namespace {
+
+constexpr std::array<std::string_view, 9> secret_keys = {
+    "apikey", "authorization", "access_token", "token", "admin_token",
+    "evo_token", "wuz_admin_token", "password", "secret"
+};
+
+constexpr std::array<std::string_view, 6> media_keys = {
+    "media", "base64", "audio", "image", "document", "file"
+};
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+template <std::size_t N>
+bool containsKey(const std::array<std::string_view, N>& keys, std::string_view key) {
+    return std::any_of(keys.begin(), keys.end(), [key](std::string_view k) { return equalsIgnoreCase(k, key); });
+}
+
+std::uint64_t fnv1a(std::string_view data) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// Bodies built by RequestBody already carry summaries in place of borrowed media.
+bool isSummary(std::string_view value) {
+    return value.size() > 2 && value.front() == '<' && value.back() == '>' && value.find(" bytes fnv1a=") != std::string_view::npos;
+}
+
+} // namespace
+
+bool LogPolicy::isSecretKey(std::string_view key) {
+    return containsKey(secret_keys, key);
+}
+
+bool LogPolicy::isMediaKey(std::string_view key) {
+    return containsKey(media_keys, key);
+}
+
+std::string LogPolicy::summarize(std::string_view data) {
+    return fmt::format("<{} bytes fnv1a={:016x}>", data.size(), fnv1a(data));
+}
+
+std::string LogPolicy::mask(std::string_view value) {
+    if (value.size() <= 8) {
+        return "***";
+    }
+    return std::string(value.substr(0, 4)) + "***";
+}
+
+std::string LogPolicy::redactQuery(std::string_view url) {
+    std::size_t start = url.find('?');
+    if (start == std::string_view::npos) {
+        return std::string(url);
+    }
+    std::string out(url.substr(0, start + 1));
+    std::string_view query = url.substr(start + 1);
+    while (true) {
+        std::size_t end = query.find('&');
+        std::string_view pair = query.substr(0, end);
+        std::size_t eq = pair.find('=');
+        if (eq != std::string_view::npos && isSecretKey(pair.substr(0, eq))) {
+            out.append(pair.substr(0, eq + 1)).append(mask(pair.substr(eq + 1)));
+        } else {
+            out.append(pair);
+        }
+        if (end == std::string_view::npos) {
+            return out;
+        }
+        out.push_back('&');
+        query.remove_prefix(end + 1);
+    }
+}
+
+std::string LogPolicy::preview(std::string_view body) {
+    auto env = Config::current();
+    const std::size_t cap = env->log_body_preview_bytes > 0 ? env->log_body_preview_bytes : 1024;
+    const std::size_t threshold = env->log_media_threshold > 0 ? env->log_media_threshold : 256;
+
+    std::string out;
+    out.reserve(std::min(body.size(), cap) + 48);
+
+    // The last object key seen applies to the string values that follow it.
+    std::string_view key;
+    std::size_t i = 0;
+    while (i < body.size() && out.size() < cap) {
+        if (body[i] != '"') {
+            out.push_back(body[i++]);
+            continue;
+        }
+
+        std::size_t end = i + 1;
+        while (end < body.size() && body[end] != '"') {
+            end += body[end] == '\\' ? 2 : 1;
+        }
+        end = std::min(end, body.size());
+        std::string_view value = body.substr(i + 1, end - i - 1);
+        bool closed = end < body.size();
+        i = closed ? end + 1 : end;
+
+        std::size_t next = i;
+        while (next < body.size() && std::isspace(static_cast<unsigned char>(body[next]))) {
+            ++next;
+        }
+        bool is_key = next < body.size() && body[next] == ':';
+
+        out.push_back('"');
+        if (is_key) {
+            key = value;
+            out.append(value);
+        } else if (isSecretKey(key)) {
+            out.append(mask(value));
+        } else if (isSummary(value)) {
+            out.append(value);
+        } else if (isMediaKey(key) || value.size() > threshold) {
+            out.append(summarize(value));
+        } else {
+            out.append(value);
+        }
+        if (closed) {
+            out.push_back('"');
+        }
+    }
+
+    bool truncated = i < body.size() || out.size() > cap;
+    if (out.size() > cap) {
+        out.resize(cap);
+    }
+    if (truncated) {
+        out.append(fmt::format("... ({} bytes)", body.size()));
+    }
+    return out;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "spdlog/fmt/fmt.h"
+#include <string>
+#include <string_view>
+
+/* How payloads are allowed to appear in the log. Bodies are scanned once:
+   values of credential keys (apikey, Authorization, access_token, ...) are
+   masked, media strings and any string longer than LOG_MEDIA_THRESHOLD are
+   replaced by their length and hash, and the output stops after
+   LOG_BODY_PREVIEW_BYTES. Log volume is therefore bounded no matter how large
+   the media being sent is.
+
+   Request targets and URLs go through target(), which masks the values of
+   credential query parameters (?token=, ?secret=, ...) the same way.
+
+   The wrappers format lazily, pass them straight to the logger:
+       apiLogger.debug("Corpo da requisição: {}", LogPolicy::body(req_body)); */
+class LogPolicy {
+public:
+    typedef struct { std::string_view text; } Body;
+    typedef struct { std::string_view data; } Media;
+    typedef struct { std::string_view value; } Secret;
+    typedef struct { std::string_view url; } Target;
+
+    static Body body(std::string_view text) { return Body{text}; }
+    static Media media(std::string_view data) { return Media{data}; }
+    static Secret secret(std::string_view value) { return Secret{value}; }
+    static Target target(std::string_view url) { return Target{url}; }
+
+    static std::string preview(std::string_view body);
+    // "<N bytes fnv1a=...>"
+    static std::string summarize(std::string_view data);
+    // Keeps the first characters only, e.g. "ABCD***".
+    static std::string mask(std::string_view value);
+    // "/webhook?token=abc123456" -> "/webhook?token=abc1***".
+    static std::string redactQuery(std::string_view url);
+
+    static bool isSecretKey(std::string_view key);
+    static bool isMediaKey(std::string_view key);
+};
+
+template <>
+struct fmt::formatter<LogPolicy::Body> : fmt::formatter<std::string_view> {
+    auto format(const LogPolicy::Body& body, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(LogPolicy::preview(body.text), ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<LogPolicy::Media> : fmt::formatter<std::string_view> {
+    auto format(const LogPolicy::Media& media, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(LogPolicy::summarize(media.data), ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<LogPolicy::Secret> : fmt::formatter<std::string_view> {
+    auto format(const LogPolicy::Secret& secret, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(LogPolicy::mask(secret.value), ctx);
+    }
+};
+
+template <>
+struct fmt::formatter<LogPolicy::Target> : fmt::formatter<std::string_view> {
+    auto format(const LogPolicy::Target& target, format_context& ctx) const {
+        return fmt::formatter<std::string_view>::format(LogPolicy::redactQuery(target.url), ctx);
+    }
+};
@@ -1,17 +1,48 @@
 #include "logger.h"
 #include "spdlog/spdlog.h"
+#include "config/config.h"
+#include <iostream>
+
+static spdlog::async_overflow_policy parseOverflowPolicy(const std::string& policy) {
+    if (policy == "overrun_oldest") {
+        return spdlog::async_overflow_policy::overrun_oldest;
+    }
+    if (policy == "discard_new") {
+        return spdlog::async_overflow_policy::discard_new;
+    }
+    if (policy != "block") {
+        std::cerr << "Invalid LOG_OVERFLOW_POLICY value, using default: block" << std::endl;
+    }
+    return spdlog::async_overflow_policy::block;
+}
 
 Logger::Logger(const std::string& file) : filepath_(file) {
     setup_logger();
 }
 
 Logger::~Logger() {
+    logger_->flush();
     spdlog::drop(filepath_);
+    logger_.reset();
+    // The pool drains what is still queued before its threads exit.
+    pool_.reset();
 }
 
 void Logger::setup_logger() {
-    logger_ = spdlog::basic_logger_mt(filepath_, filepath_);
-    logger_->set_level(spdlog::level::debug);
+    auto env = Config::current();
+    std::size_t queue_size = env->log_queue_size > 0 ? env->log_queue_size : 8192;
+    std::size_t threads = env->log_threads > 0 ? env->log_threads : 1;
+
+    pool_ = std::make_shared<spdlog::details::thread_pool>(queue_size, threads);
+    auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(filepath_);
+    logger_ = std::make_shared<spdlog::async_logger>(filepath_, std::move(sink), pool_,
+                                                     parseOverflowPolicy(env->log_overflow_policy));
+    spdlog::register_logger(logger_);
+
+    if (!set_level(env->log_level)) {
+        std::cerr << "Invalid LOG_LEVEL value, using default: info" << std::endl;
+        logger_->set_level(spdlog::level::info);
+    }
     logger_->flush_on(spdlog::level::err);
 }
 
@@ -29,4 +60,23 @@ void Logger::debug(const std::string& message) {
 
 void Logger::warn(const std::string& message) {
     logger_->warn(message);
-}
\ No newline at end of file
+}
+
+bool Logger::should_log(spdlog::level::level_enum level) const {
+    return logger_->should_log(level);
+}
+
+bool Logger::set_level(std::string_view level) {
+    auto parsed = spdlog::level::from_str(std::string(level));
+    // from_str falls back to off for unknown names.
+    if (parsed == spdlog::level::off && level != "off") {
+        return false;
+    }
+    logger_->set_level(parsed);
+    return true;
+}
+
+std::string Logger::level() const {
+    auto name = spdlog::level::to_string_view(logger_->level());
+    return std::string(name.data(), name.size());
+}
@@ -1,8 +1,19 @@
 #pragma once
+#include "../../dependencies/spdlog/async.h"
 #include "../../dependencies/spdlog/sinks/basic_file_sink.h"
+#include <string>
+#include <string_view>
+#include <utility>
 
+/* File logger backed by an spdlog async thread pool. Records are queued in a
+   bounded ring buffer (LOG_QUEUE_SIZE) and written by LOG_THREADS background
+   threads; LOG_OVERFLOW_POLICY decides what happens when the buffer is full.
+
+   Prefer the format overloads, e.g. apiLogger.debug("Instância: {}", id): the
+   message is only built when the level is enabled. */
 class Logger {
 private:
+    std::shared_ptr<spdlog::details::thread_pool> pool_;
     std::shared_ptr<spdlog::logger> logger_;
     std::string filepath_;
 
@@ -15,4 +26,29 @@ public:
     void error(const std::string& message);
     void debug(const std::string& message);
     void warn(const std::string& message);
-};
\ No newline at end of file
+
+    template <typename Arg, typename... Args>
+    void info(spdlog::format_string_t<Arg, Args...> fmt, Arg&& arg, Args&&... args) {
+        logger_->info(fmt, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    template <typename Arg, typename... Args>
+    void error(spdlog::format_string_t<Arg, Args...> fmt, Arg&& arg, Args&&... args) {
+        logger_->error(fmt, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    template <typename Arg, typename... Args>
+    void debug(spdlog::format_string_t<Arg, Args...> fmt, Arg&& arg, Args&&... args) {
+        logger_->debug(fmt, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    template <typename Arg, typename... Args>
+    void warn(spdlog::format_string_t<Arg, Args...> fmt, Arg&& arg, Args&&... args) {
+        logger_->warn(fmt, std::forward<Arg>(arg), std::forward<Args>(args)...);
+    }
+
+    bool should_log(spdlog::level::level_enum level) const;
+    // Accepts the spdlog level names (trace, debug, info, warn, error, critical, off).
+    bool set_level(std::string_view level);
+    std::string level() const;
+};
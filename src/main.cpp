@@ -2,16 +2,33 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/version.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/config.hpp>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include "handler/handler.h"
+#include "handler/routes.h"
 #include "../dependencies/json.h"
 #include "logger/logger.h"
+#include "logger/log_policy.h"
 #include "cloud/cloud_api.h"
+#include "api/http_client.h"
+#include "handler/worker_pool.h"
+#include "handler/outbox.h"
+#include "handler/webhook_dispatcher.h"
+#include "handler/webhook_auth.h"
+#include "database/instance_cache.h"
+#include "database/instance_status.h"
+#include "metrics/metrics.h"
 
 namespace beast = boost::beast;
 namespace http = beast::http;
@@ -20,430 +37,384 @@ using tcp = net::ip::tcp;
 
 Logger apiLogger("../logs/api.log");
 
-http::response<http::string_body> handle_request(http::request<http::string_body> const& req) {
-    apiLogger.info("Requisição recebida: " + std::string(req.method_string()) + " " + std::string(req.target()));
-    Config cfg;
-    auto env = cfg.getEnv();
+static bool is_webhook(const http::request<http::string_body>& req) {
+    auto target = req.target();
+    return req.method() == http::verb::post && std::string_view(target.data(), target.size()).substr(0, target.find('?')) == "/webhook";
+}
 
+Reply handle_request(http::request<http::string_body> const& req) {
+    auto target = req.target();
+    apiLogger.info("Requisição recebida: {} {}", std::string_view(req.method_string().data(), req.method_string().size()),
+                   LogPolicy::target(std::string_view(target.data(), target.size())));
+    Config cfg;
+    const auto& env = cfg.getEnv();
+
+    // Scrapers that cannot send the bearer token can be let through to /metrics only.
+    bool public_route = env.metrics_public && req.method() == http::verb::get && req.target() == "/metrics";
+    // Providers cannot send headers with their webhooks, they authenticate with the instance's secret instead.
+    if (is_webhook(req)) {
+        public_route = WebhookAuth::accepts(query_param(req, "instance_id"), query_param(req, "secret"), env.token) ||
+                       (env.webhook_legacy_token && !env.token.empty() && query_param(req, "token") == env.token);
+    }
     auto auth_iter = req.find(http::field::authorization);
-    if (auth_iter == req.end() || auth_iter->value() != "Bearer " + std::string(env.token)) {
+    if (!public_route && (auth_iter == req.end() || auth_iter->value() != "Bearer " + std::string(env.token))) {
         apiLogger.error("Acesso não autorizado - Token inválido ou ausente");
-        http::response<http::string_body> res{http::status::unauthorized, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        nlohmann::json err_json;
-        err_json["error"] = "Não autorizado";
-        res.body() = err_json.dump();
-        res.prepare_payload();
-        return res;
+        Metrics::instance().observeRequest("unauthorized", std::string_view(req.method_string().data(), req.method_string().size()),
+                                           static_cast<unsigned>(http::status::unauthorized), 0.0);
+        return error_response(req, http::status::unauthorized, "Não autorizado");
     }
 
-    if (req.method() == http::verb::post && req.target() == "/createInstance") {
-        Config cfg;
-        auto env = cfg.getEnv();
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            std::string instance_name = body.at("instance_name").get<std::string>();
-            std::string api_type_str = body.at("api_type").get<std::string>();
-            std::string webhook_url = body.value("webhook_url", env.default_webhook);
-            std::string proxy_url = body.value("proxy_url", "");
-            std::string access_token = body.value("access_token", "");
-            std::string waba_id = body.value("waba_id", "");
-
-            apiLogger.debug("Criando instância: ID=" + instance_id + ", Nome=" + instance_name + ", Tipo=" + api_type_str);
-
-            ApiType api_type;
-            if (api_type_str == "EVOLUTION") {
-                api_type = ApiType::EVOLUTION;
-            } else if (api_type_str == "WUZAPI") {
-                api_type = ApiType::WUZAPI;
-            } else if (api_type_str == "CLOUD") {
-                api_type = ApiType::CLOUD;
-            } else {
-                apiLogger.error("Tipo de API inválido: " + api_type_str);
-                res.result(http::status::bad_request);
-                res.body() = R"({\"error\":\"api_type inválido\"})";
-                res.prepare_payload();
-                return res;
+    return apiRoutes().dispatch(req);
+}
+
+class Session : public std::enable_shared_from_this<Session> {
+    beast::tcp_stream stream_;
+    beast::flat_buffer buffer_;
+    std::optional<http::request_parser<http::string_body>> parser_;
+    // Chunks a streamed slot may hold for the socket before production pauses.
+    static constexpr std::size_t stream_buffered_chunks = 2;
+    typedef struct {
+        http::response<http::string_body> res;
+        bool ready;
+        // Streamed replies: `res` is only the head, the body follows as chunks handed over by the worker.
+        bool streamed = false;
+        bool head_sent = false;
+        bool finished = false;
+        bool failed = false;
+        bool broken = false;
+        std::deque<std::string> chunks;
+        // Streamed replies: pulled one chunk per worker pool job, only while the socket keeps up.
+        ChunkSource source;
+        bool producing = false;
+        std::optional<http::response_serializer<http::string_body>> serializer;
+    } Slot;
+    // Responses are written strictly in the order their requests were read (HTTP/1.1 pipelining),
+    // a slot stays pending while its handler is still running on the worker pool.
+    std::deque<std::shared_ptr<Slot>> queue_;
+    net::steady_timer idle_timer_;
+    const std::chrono::seconds idle_timeout_;
+    const std::size_t max_requests_;
+    const std::size_t pipeline_limit_;
+    const int retry_after_s_;
+    std::size_t requests_read_ = 0;
+    bool writing_ = false;
+    bool closing_ = false;
+
+public:
+    explicit Session(tcp::socket socket, const Env& env)
+        : stream_(std::move(socket)),
+          idle_timer_(stream_.get_executor()),
+          idle_timeout_(env.keepalive_timeout_s),
+          max_requests_(env.max_requests_per_connection > 0 ? env.max_requests_per_connection : 1),
+          pipeline_limit_(env.pipeline_limit > 0 ? env.pipeline_limit : 1),
+          retry_after_s_(env.retry_after_s > 0 ? env.retry_after_s : 1) {}
+
+    void run() {
+        net::dispatch(stream_.get_executor(), [self = shared_from_this()] {
+            self->arm_idle_timer();
+            self->do_read();
+        });
+    }
+
+private:
+    void do_read() {
+        parser_.emplace();
+        parser_->body_limit(50 * 1024 * 1024);
+        // Idle time is tracked by idle_timer_, a pending read must survive slow responses.
+        stream_.expires_never();
+
+        http::async_read(stream_, buffer_, *parser_,
+            [self = shared_from_this()](beast::error_code ec, std::size_t) {
+                self->on_read(ec);
+            });
+    }
+
+    void on_read(beast::error_code ec) {
+        if (ec == http::error::end_of_stream) {
+            return do_close();
+        }
+        if (ec) {
+            if (ec != net::error::operation_aborted) {
+                apiLogger.error("Erro ao ler requisição: {}", ec.message());
             }
-            Status stat = Handler::createInstance(instance_id, instance_name, api_type, webhook_url, proxy_url, access_token, waba_id);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
+            return;
+        }
+        idle_timer_.cancel();
+
+        auto req = std::make_shared<http::request<http::string_body>>(parser_->release());
+        apiLogger.debug("Requisição recebida: {} {}", std::string_view(req->method_string().data(), req->method_string().size()),
+                        LogPolicy::target(std::string_view(req->target().data(), req->target().size())));
+        bool last = ++requests_read_ >= max_requests_ || !req->keep_alive();
+        if (last) {
+            closing_ = true;
+        }
+
+        auto slot = std::make_shared<Slot>();
+        slot->ready = false;
+        queue_.push_back(slot);
+
+        // Webhook ingestion only appends to WebhookDispatcher's queue, answer it here rather than behind
+        // slow handlers in the worker pool.
+        if (is_webhook(*req)) {
+            complete(slot, handle_request(*req).res, last);
+            if (!closing_ && queue_.size() < pipeline_limit_) {
+                do_read();
             }
-        } catch (const std::exception& e) {
-            apiLogger.error("Erro ao processar requisição createInstance: " + std::string(e.what()));
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+            return;
         }
-        res.prepare_payload();
-        return res;
-    }
-    if (req.method() == http::verb::post && req.target() == "/sendMessage") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            std::string number = body.at("number").get<std::string>();
-            std::string msg_body = body.at("body").get<std::string>();
-            std::string type_str = body.value("type", "TEXT");
-
-            apiLogger.debug("Enviando mensagem: Instância=" + instance_id + ", Número=" + number + ", Tipo=" + type_str);
-
-            MediaType type;
-            if (type_str == "TEXT") {
-                type = MediaType::TEXT;
-            } else if (type_str == "IMAGE") {
-                type = MediaType::IMAGE;
-            } else if (type_str == "AUDIO") {
-                type = MediaType::AUDIO;
-            } else if (type_str == "DOCUMENT") {
-                type = MediaType::DOCUMENT;
-            } else {
-                apiLogger.error("Tipo de mídia inválido: " + type_str);
-                res.result(http::status::bad_request);
-                res.body() = R"({\"error\":\"type inválido\"})";
-                res.prepare_payload();
-                return res;
+
+        // Handlers block on the DB, run them on the worker pool and hop back to this connection's strand
+        // with the result. Routes that wait on a provider answer with a pending reply instead, which
+        // frees the worker and completes from the HttpClient thread once the provider has answered.
+        bool accepted = WorkerPool::instance().try_submit([self = shared_from_this(), slot, req, last] {
+            Reply reply;
+            try {
+                reply = handle_request(*req);
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao processar requisição: {}", e.what());
+                reply = error_response(*req, http::status::internal_server_error, "Erro interno do servidor");
             }
-            Status stat = Handler::sendMessage(instance_id, number, msg_body, type);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
+            if (reply.stream) {
+                return self->produce(*req, slot, std::move(reply), last);
             }
-        } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
-        }
-        res.prepare_payload();
-        return res;
-    }
-    if (req.method() == http::verb::delete_ && req.target() == "/deleteInstance") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            Status stat = Handler::deleteInstance(instance_id);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
+            if (reply.pending) {
+                return self->await(*req, slot, std::move(reply.pending), last);
             }
-        } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+            net::post(self->stream_.get_executor(), [self, slot, last, res = std::move(reply.res)]() mutable {
+                self->complete(slot, std::move(res), last);
+            });
+        });
+        if (!accepted) {
+            apiLogger.warn("Fila de workers cheia, rejeitando requisição: {}", LogPolicy::target(std::string_view(req->target().data(), req->target().size())));
+            auto res = error_response(*req, http::status::service_unavailable, "Servidor sobrecarregado, tente novamente");
+            res.set(http::field::retry_after, std::to_string(retry_after_s_));
+            res.prepare_payload();
+            complete(slot, std::move(res), last);
+        }
+
+        if (!closing_ && queue_.size() < pipeline_limit_) {
+            do_read();
         }
-        res.prepare_payload();
-        return res;
     }
-    if (req.method() == http::verb::delete_ && req.target() == "/logoutInstance") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            Status stat = Handler::logoutInstance(instance_id);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
+
+    // Starts a pending reply on the worker that ran the route; its response reaches the strand from whichever
+    // thread completes it. A throw before completion still answers, but only once.
+    void await(const Request& req, const std::shared_ptr<Slot>& slot, Deferred pending, bool last) {
+        auto self = shared_from_this();
+        auto answered = std::make_shared<std::atomic<bool>>(false);
+        auto finish = [self, slot, last, answered](Response res) {
+            if (answered->exchange(true)) {
+                return;
             }
+            net::post(self->stream_.get_executor(), [self, slot, last, res = std::move(res)]() mutable {
+                self->complete(slot, std::move(res), last);
+            });
+        };
+        try {
+            pending(finish);
         } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+            apiLogger.error("Erro ao processar requisição: {}", e.what());
+            finish(error_response(req, http::status::internal_server_error, "Erro interno do servidor"));
         }
-        res.prepare_payload();
-        return res;
     }
-    if (req.method() == http::verb::get && req.target() == "/retrieveInstances") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            apiLogger.info("Processing retrieveInstances request");
-            auto instances = Handler::retrieveInstances();
-
-            nlohmann::json instances_array = nlohmann::json::array();
-            for (const auto& instance : instances) {
-                nlohmann::json instance_json = {
-                    {"instance_id", instance.instance_id},
-                    {"instance_name", instance.instance_name},
-                    {"instance_type", instance.instance_type},
-                    {"is_active", instance.is_active}
-                };
-
-                if (instance.webhook_url.has_value()) {
-                    instance_json["webhook_url"] = instance.webhook_url.value();
-                }
-                if (instance.waba_id.has_value()) {
-                    instance_json["waba_id"] = instance.waba_id.value();
-                }
-                if (instance.access_token.has_value()) {
-                    instance_json["access_token"] = instance.access_token.value();
-                }
-                if (instance.phone_number_id.has_value()) {
-                    instance_json["phone_number_id"] = instance.phone_number_id.value();
-                }
 
-                instances_array.push_back(instance_json);
+    // Runs on the worker thread that ran the route. HTTP/1.0 clients cannot take chunked bodies, theirs
+    // is collected whole here; otherwise the source moves to the strand, which pulls it through demand().
+    void produce(const Request& req, const std::shared_ptr<Slot>& slot, Reply reply, bool last) {
+        auto self = shared_from_this();
+        if (req.version() < 11) {
+            http::response<http::string_body> res = std::move(reply.res);
+            try {
+                std::string chunk;
+                while (reply.stream(chunk)) {
+                    res.body().append(chunk);
+                    chunk.clear();
+                }
+                res.chunked(false);
+                res.prepare_payload();
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao gerar resposta: {}", e.what());
+                res = error_response(req, http::status::internal_server_error, "Erro interno do servidor");
             }
-
-            nlohmann::json resp_json;
-            resp_json["status"] = "success";
-            resp_json["count"] = instances.size();
-            resp_json["instances"] = instances_array;
-
-            res.body() = resp_json.dump(2);
-            apiLogger.info("Retrieved " + std::to_string(instances.size()) + " instances");
-
-        } catch (const std::exception& e) {
-            apiLogger.error("Error processing retrieveInstances request: " + std::string(e.what()));
-            res.result(http::status::internal_server_error);
-            nlohmann::json err_json;
-            err_json["status"] = "error";
-            err_json["message"] = "Failed to retrieve instances";
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+            net::post(stream_.get_executor(), [self, slot, last, res = std::move(res)]() mutable {
+                self->complete(slot, std::move(res), last);
+            });
+            return;
         }
-        res.prepare_payload();
-        return res;
 
+        net::post(stream_.get_executor(), [self, slot, last, res = std::move(reply.res), source = std::move(reply.stream)]() mutable {
+            slot->streamed = true;
+            slot->source = std::move(source);
+            self->complete(slot, std::move(res), last);
+            self->demand(slot);
+        });
     }
-    if (req.method() == http::verb::post && req.target() == "/connectInstance") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            Status stat = Handler::connectInstance(instance_id);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
-            }
-        } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+
+    // Runs on the strand: asks a worker for the next chunk of a streamed slot unless one is already
+    // being produced or enough are waiting for the socket. A client that reads slowly therefore
+    // holds its buffered chunks and its source, never a worker.
+    void demand(const std::shared_ptr<Slot>& slot) {
+        if (slot->producing || slot->finished || slot->broken || slot->chunks.size() >= stream_buffered_chunks) {
+            return;
         }
-        res.prepare_payload();
-        return res;
-    } if (req.method() == http::verb::post && req.target() == "/setWebhook") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            std::string webhook_url = body.at("webhook_url").get<std::string>();
-            Status stat = Handler::setWebhook(instance_id,webhook_url);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
+        slot->producing = true;
+        bool accepted = WorkerPool::instance().try_submit([self = shared_from_this(), slot] {
+            std::string chunk;
+            bool more = false;
+            bool failed = false;
+            try {
+                more = slot->source(chunk);
+            } catch (const std::exception& e) {
+                apiLogger.error("Erro ao gerar resposta: {}", e.what());
+                failed = true;
             }
-        } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
-        }
-        res.prepare_payload();
-        return res;
+            net::post(self->stream_.get_executor(), [self, slot, more, failed, chunk = std::move(chunk)]() mutable {
+                slot->producing = false;
+                if (more && !chunk.empty()) {
+                    slot->chunks.push_back(std::move(chunk));
+                } else if (!more) {
+                    slot->finished = true;
+                    slot->failed = failed;
+                }
+                if (slot->finished || slot->broken) {
+                    slot->source = nullptr;
+                }
+                self->pump(slot);
+                self->demand(slot);
+            });
+        });
+        if (!accepted) {
+            // The body is already under way and cannot be shed any more, try again shortly.
+            slot->producing = false;
+            auto timer = std::make_shared<net::steady_timer>(stream_.get_executor(), std::chrono::milliseconds(50));
+            timer->async_wait([self = shared_from_this(), slot, timer](beast::error_code) {
+                self->demand(slot);
+            });
         }
-    if (req.method() == http::verb::post && req.target() == "/sendTemplate") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            std::string number = body.at("number").get<std::string>();
-            std::string template_name = body.at("template_name").get<std::string>();
-
-            std::string image_url = body.value("image_url", "");
-            MediaType type = MediaType::TEXT;
-            if (!image_url.empty()) {
-                type = MediaType::IMAGE;
-            }
+    }
 
-            std::vector<FB_VARS> variables;
-            if (body.contains("variables") && body["variables"].is_array()) {
-                for (const auto& var : body["variables"]) {
-                    FB_VARS fb_var;
-
-                    std::string var_type = var.value("type", "text");
-                    if (var_type == "text") {
-                        fb_var.var = VARIABLE_T::TEXT;
-                    } else if (var_type == "currency") {
-                        fb_var.var = VARIABLE_T::CURRENCY;
-                    } else if (var_type == "datetime") {
-                        fb_var.var = VARIABLE_T::DATE_TIME;
-                    } else {
-                        fb_var.var = VARIABLE_T::TEXT;
-                    }
+    void complete(const std::shared_ptr<Slot>& slot, http::response<http::string_body> res, bool last) {
+        if (last) {
+            res.keep_alive(false);
+        }
+        slot->res = std::move(res);
+        slot->ready = true;
+        if (!writing_ && queue_.front()->ready) {
+            do_write();
+        }
+    }
 
-                    fb_var.body = var.at("value").get<std::string>();
-                    variables.push_back(fb_var);
+    void do_write() {
+        writing_ = true;
+        auto slot = queue_.front();
+        stream_.expires_after(idle_timeout_);
+        if (slot->streamed) {
+            slot->serializer.emplace(slot->res);
+            http::async_write_header(stream_, *slot->serializer, [self = shared_from_this(), slot](beast::error_code ec, std::size_t) {
+                self->writing_ = false;
+                if (ec) {
+                    return self->abort_stream(slot, ec);
                 }
-            }
-
-            apiLogger.debug("Sending template message: Instance=" + instance_id +
-                           ", Number=" + number +
-                           ", Template=" + template_name +
-                           ", Variables=" + std::to_string(variables.size()));
-
-            Status stat = Handler::sendTemplate(instance_id, number, image_url, type, variables, template_name);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
+                slot->head_sent = true;
+                self->pump(slot);
+            });
+            return;
+        }
+        http::async_write(stream_, slot->res, [self = shared_from_this(), slot](beast::error_code ec, std::size_t) {
+            self->on_write(slot->res.need_eof(), ec);
+        });
+    }
 
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
-            }
-        } catch (const std::exception& e) {
-            apiLogger.error("Error processing sendTemplate request: " + std::string(e.what()));
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+    // Writes whatever the worker has produced for the streamed slot at the head of the queue, then
+    // the final chunk. A body cut short by a failed source is signalled by closing the connection
+    // without it, the client cannot mistake the truncated listing for a complete one.
+    void pump(const std::shared_ptr<Slot>& slot) {
+        if (writing_ || slot->broken || !slot->head_sent || queue_.empty() || queue_.front() != slot) {
+            return;
         }
-        res.prepare_payload();
-        return res;
-    } if (req.method() == http::verb::post && req.target() == "/createGroup") {
-        http::response<http::string_body> res{http::status::ok, req.version()};
-        res.set(http::field::server, "Beast");
-        res.set(http::field::content_type, "application/json");
-        res.keep_alive(req.keep_alive());
-        try {
-            auto body = nlohmann::json::parse(req.body());
-            std::string instance_id = body.at("instance_id").get<std::string>();
-            std::string subject = body.at("subject").get<std::string>();
-            std::string description = body.at("description").get<std::string>();
-            std::vector<std::string> participants;
-            if (body.contains("participants") && body["participants"].is_array()) {
-                for (const auto& p : body["participants"]) {
-                    participants.push_back(p.get<std::string>());
-                }
-            }
-            Status stat = Handler::createGroup(instance_id, subject, description, participants);
-            nlohmann::json resp_json;
-            resp_json["status_code"] = stat.status_code;
-            resp_json["status_string"] = stat.status_string;
-            res.body() = resp_json.dump();
-
-            if (stat.status_code == c_status::ERR) {
-                res.result(http::status::internal_server_error);
-            }
-        } catch (const std::exception& e) {
-            res.result(http::status::bad_request);
-            nlohmann::json err_json;
-            err_json["error"] = e.what();
-            res.body() = err_json.dump();
+        if (!slot->chunks.empty()) {
+            writing_ = true;
+            stream_.expires_after(idle_timeout_);
+            net::async_write(stream_, http::make_chunk(net::buffer(slot->chunks.front())),
+                [self = shared_from_this(), slot](beast::error_code ec, std::size_t) {
+                    self->writing_ = false;
+                    slot->chunks.pop_front();
+                    if (ec) {
+                        return self->abort_stream(slot, ec);
+                    }
+                    self->pump(slot);
+                    self->demand(slot);
+                });
+            return;
+        }
+        if (!slot->finished) {
+            return;
+        }
+        if (slot->failed) {
+            slot->broken = true;
+            return do_close();
         }
-        res.prepare_payload();
-        return res;
+        writing_ = true;
+        stream_.expires_after(idle_timeout_);
+        net::async_write(stream_, http::make_chunk_last(), [self = shared_from_this(), slot](beast::error_code ec, std::size_t) {
+            self->on_write(slot->res.need_eof(), ec);
+        });
     }
-    http::response<http::string_body> res{http::status::not_found, req.version()};
-    res.set(http::field::server, "Beast");
-    res.set(http::field::content_type, "application/json");
-    res.keep_alive(req.keep_alive());
-    nlohmann::json err_json;
-    err_json["error"] = "Endpoint não encontrado";
-    res.body() = err_json.dump();
-    res.prepare_payload();
-    return res;
-}
 
-class Session : public std::enable_shared_from_this<Session> {
-    tcp::socket socket_;
-    beast::flat_buffer buffer_;
-    http::request<http::string_body> req_;
-    http::request_parser<http::string_body> parser_;
-
-public:
-    explicit Session(tcp::socket socket) : socket_(std::move(socket)) {
-        parser_.body_limit(50 * 1024 * 1024);
+    void abort_stream(const std::shared_ptr<Slot>& slot, beast::error_code ec) {
+        apiLogger.error("Erro ao escrever resposta: {}", ec.message());
+        slot->broken = true;
+        if (!slot->producing) {
+            slot->source = nullptr;
+        }
     }
 
-    void run() {
-        do_read();
-    }
+    void on_write(bool close, beast::error_code ec) {
+        writing_ = false;
+        if (ec) {
+            apiLogger.error("Erro ao escrever resposta: {}", ec.message());
+            return;
+        }
+        if (close) {
+            return do_close();
+        }
 
-private:
-    void do_read() {
-        auto self(shared_from_this());
+        bool was_full = queue_.size() >= pipeline_limit_;
+        queue_.pop_front();
+        if (!queue_.empty()) {
+            if (queue_.front()->ready) {
+                do_write();
+            }
+        } else {
+            arm_idle_timer();
+        }
+        if (was_full && !closing_) {
+            do_read();
+        }
+    }
 
-        http::async_read(socket_, buffer_, parser_,
-            [this, self](beast::error_code ec, std::size_t) {
-            if (!ec) {
-                req_ = parser_.release();
-                apiLogger.debug("Requisição recebida: " + std::string(req_.method_string()) + " " + std::string(req_.target()));
-                do_write(handle_request(req_));
-            } else {
-                apiLogger.error("Erro ao ler requisição: " + std::string(ec.message()));
+    void arm_idle_timer() {
+        idle_timer_.expires_after(idle_timeout_);
+        idle_timer_.async_wait([self = shared_from_this()](beast::error_code ec) {
+            if (ec == net::error::operation_aborted) {
+                return;
             }
+            apiLogger.debug("Conexão ociosa encerrada por timeout");
+            self->stream_.close();
         });
     }
 
-    void do_write(http::response<http::string_body> res) {
-        auto self(shared_from_this());
-        auto sp = std::make_shared<http::response<http::string_body>>(std::move(res));
-        http::async_write(socket_, *sp, [this, self, sp](beast::error_code ec, std::size_t) {
-            if (ec) {
-                apiLogger.error("Erro ao escrever resposta: " + std::string(ec.message()));
+    void do_close() {
+        idle_timer_.cancel();
+        // Streamed slots stop asking for chunks; a chunk already being produced is dropped when it arrives.
+        for (const auto& slot : queue_) {
+            slot->broken = true;
+            if (!slot->producing) {
+                slot->source = nullptr;
             }
-            socket_.shutdown(tcp::socket::shutdown_send, ec);
-        });
+        }
+        beast::error_code ec;
+        stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
     }
 };
 
@@ -458,25 +429,25 @@ public:
 
         acceptor_.open(endpoint.protocol(), ec);
         if (ec) {
-            apiLogger.error("Erro ao abrir acceptor: " + std::string(ec.message()));
+            apiLogger.error("Erro ao abrir acceptor: {}", ec.message());
             return;
         }
 
         acceptor_.set_option(net::socket_base::reuse_address(true), ec);
         if (ec) {
-            apiLogger.error("Erro ao configurar opção do socket: " + std::string(ec.message()));
+            apiLogger.error("Erro ao configurar opção do socket: {}", ec.message());
             return;
         }
 
         acceptor_.bind(endpoint, ec);
         if (ec) {
-            apiLogger.error("Erro ao fazer bind: " + std::string(ec.message()));
+            apiLogger.error("Erro ao fazer bind: {}", ec.message());
             return;
         }
 
         acceptor_.listen(net::socket_base::max_listen_connections, ec);
         if (ec) {
-            apiLogger.error("Erro ao iniciar listen: " + std::string(ec.message()));
+            apiLogger.error("Erro ao iniciar listen: {}", ec.message());
             return;
         }
         apiLogger.info("Listener configurado com sucesso");
@@ -490,7 +461,8 @@ private:
     void do_accept() {
         acceptor_.async_accept(net::make_strand(ioc_), [this](beast::error_code ec, tcp::socket socket) {
             if (!ec) {
-                std::make_shared<Session>(std::move(socket))->run();
+                Config cfg;
+                std::make_shared<Session>(std::move(socket), cfg.getEnv())->run();
             }
             do_accept();
         });
@@ -500,19 +472,45 @@ private:
 int main() {
     try {
         Config cfg;
-        auto env = cfg.getEnv();
+        const auto& env = cfg.getEnv();
         apiLogger.info("Iniciando servidor...");
-        auto const address = net::ip::make_address(cfg.getEnv().ip);
-        apiLogger.info("Endereço IP configurado: " + std::string());
+        auto const address = net::ip::make_address(env.ip);
+        apiLogger.info("Endereço IP configurado: {}", std::string());
 
         const int threads = std::thread::hardware_concurrency();
-        apiLogger.info("Número de threads: " + std::to_string(threads));
+        apiLogger.info("Número de threads: {}", threads);
         net::io_context ioc{threads};
 
+        // Start the outbound HTTP engine before the first request needs it.
+        HttpClient::instance();
+        WorkerPool::instance();
+        apiRoutes();
+        InstanceCache::instance().start(env.db_url);
+        InstanceStatus::instance().start();
+        Outbox::instance().start();
+        WebhookDispatcher::instance().start();
+
         auto listener = std::make_shared<Listener>(ioc, tcp::endpoint{address, static_cast<u_short>(env.port)});
-        apiLogger.info("Listener criado na porta: " + std::to_string(env.port));
+        apiLogger.info("Listener criado na porta: {}", env.port);
         listener->run();
 
+#ifdef SIGHUP
+        // IP, PORT, the DB pool sizes and the log queue are only read at startup, everything else follows the reload.
+        net::signal_set reload_signals(ioc, SIGHUP);
+        std::function<void()> wait_reload = [&] {
+            reload_signals.async_wait([&](beast::error_code ec, int) {
+                if (ec) {
+                    return;
+                }
+                apiLogger.info("SIGHUP recebido, recarregando configuração");
+                Config::reload();
+                apiLogger.set_level(Config::current()->log_level);
+                wait_reload();
+            });
+        };
+        wait_reload();
+#endif
+
         std::vector<std::thread> thread_pool;
         for (int i = 0; i < threads; ++i) {
             thread_pool.emplace_back([&ioc] { ioc.run(); });
@@ -525,7 +523,7 @@ int main() {
         apiLogger.info("Thread pool finalizado");
 
     } catch (const std::exception& e) {
-        apiLogger.error("Erro fatal: " + std::string(e.what()));
+        apiLogger.error("Erro fatal: {}", e.what());
         std::cerr << "Error: " << e.what() << std::endl;
     }
 }
\ No newline at end of file
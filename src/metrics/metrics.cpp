@@ -0,0 +1,245 @@
+#include "metrics.h"
+#include "api/circuit_breaker.h"
+#include "database/connection_pool.h"
+#include "handler/rate_limiter.h"
+#include "handler/webhook_dispatcher.h"
+#include "handler/worker_pool.h"
+#include "spdlog/fmt/fmt.h"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+void appendEscaped(std::string& out, std::string_view value) {
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out += '\\';
+            out += c;
+        } else if (c == '\n') {
+            out += "\\n";
+        } else {
+            out += c;
+        }
+    }
+}
+
+void appendLabel(std::string& out, std::string_view name, std::string_view value) {
+    if (!out.empty()) {
+        out += ',';
+    }
+    out.append(name).append("=\"");
+    appendEscaped(out, value);
+    out += '"';
+}
+
+void appendHeader(std::string& out, const char* name, const char* help, const char* type) {
+    fmt::format_to(std::back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+}
+
+} // namespace
+
+void Metrics::Histogram::observe(double seconds) {
+    auto bucket = std::lower_bound(buckets.begin(), buckets.end(), seconds) - buckets.begin();
+    counts_[static_cast<std::size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(static_cast<std::uint64_t>(std::max(seconds, 0.0) * 1e9), std::memory_order_relaxed);
+}
+
+Metrics::InFlight::InFlight() {
+    Metrics::instance().in_flight_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Metrics::InFlight::~InFlight() {
+    Metrics::instance().in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+Metrics::Histogram& Metrics::series(Family& family, std::string labels) {
+    {
+        std::shared_lock<std::shared_mutex> lock(family.mtx);
+        if (auto it = family.series.find(labels); it != family.series.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(family.mtx);
+    auto& slot = family.series[std::move(labels)];
+    if (!slot) {
+        slot = std::make_unique<Histogram>();
+    }
+    return *slot;
+}
+
+void Metrics::observeRequest(std::string_view route, std::string_view method, unsigned status, double seconds) {
+    std::string labels;
+    appendLabel(labels, "route", route);
+    appendLabel(labels, "method", method);
+    appendLabel(labels, "status", std::to_string(status));
+    series(requests_, std::move(labels)).observe(seconds);
+}
+
+void Metrics::observeUpstream(std::string_view provider, std::string_view operation, long http_code, UpstreamOutcome outcome, double seconds) {
+    std::string labels;
+    appendLabel(labels, "provider", provider);
+    appendLabel(labels, "operation", operation);
+    appendLabel(labels, "status", outcome == UpstreamOutcome::ANSWERED ? std::to_string(http_code)
+                                  : outcome == UpstreamOutcome::TIMED_OUT ? "timeout" : "error");
+    series(upstream_, std::move(labels)).observe(seconds);
+}
+
+void Metrics::observeDb(std::string_view statement, bool ok, double seconds) {
+    std::string labels;
+    appendLabel(labels, "statement", statement);
+    appendLabel(labels, "outcome", ok ? "ok" : "error");
+    series(db_, std::move(labels)).observe(seconds);
+}
+
+void Metrics::observeRateLimit(std::string_view scope, std::string_view provider, bool admitted, double seconds) {
+    std::string labels;
+    appendLabel(labels, "scope", scope);
+    appendLabel(labels, "provider", provider);
+    appendLabel(labels, "outcome", admitted ? "admitted" : "rejected");
+    series(rate_limit_, std::move(labels)).observe(seconds);
+}
+
+void Metrics::renderHistogram(std::string& out, const char* name, const char* help, const Family& family) {
+    appendHeader(out, name, help, "histogram");
+    std::shared_lock<std::shared_mutex> lock(family.mtx);
+    for (const auto& [labels, histogram] : family.series) {
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < buckets.size(); ++i) {
+            cumulative += histogram->counts_[i].load(std::memory_order_relaxed);
+            fmt::format_to(std::back_inserter(out), "{}_bucket{{{},le=\"{}\"}} {}\n", name, labels, buckets[i], cumulative);
+        }
+        cumulative += histogram->counts_[buckets.size()].load(std::memory_order_relaxed);
+        fmt::format_to(std::back_inserter(out), "{}_bucket{{{},le=\"+Inf\"}} {}\n", name, labels, cumulative);
+        fmt::format_to(std::back_inserter(out), "{}_sum{{{}}} {}\n", name, labels,
+                       static_cast<double>(histogram->sum_ns_.load(std::memory_order_relaxed)) / 1e9);
+        fmt::format_to(std::back_inserter(out), "{}_count{{{}}} {}\n", name, labels, cumulative);
+    }
+}
+
+namespace {
+
+typedef struct {
+    const char* name;
+    const char* help;
+    const char* type;
+    std::uint64_t value;
+} PlainSeries;
+
+} // namespace
+
+std::string Metrics::render() const {
+    std::string out;
+    out.reserve(16 * 1024);
+    auto emit = std::back_inserter(out);
+
+    appendHeader(out, "wasolution_http_requests_total", "HTTP requests handled, by route pattern, method and status.", "counter");
+    {
+        std::shared_lock<std::shared_mutex> lock(requests_.mtx);
+        for (const auto& [labels, histogram] : requests_.series) {
+            std::uint64_t count = 0;
+            for (const auto& bucket : histogram->counts_) {
+                count += bucket.load(std::memory_order_relaxed);
+            }
+            fmt::format_to(emit, "wasolution_http_requests_total{{{}}} {}\n", labels, count);
+        }
+    }
+    renderHistogram(out, "wasolution_http_request_duration_seconds", "Time spent in the route handler.", requests_);
+    appendHeader(out, "wasolution_http_requests_in_flight", "Requests currently being handled.", "gauge");
+    fmt::format_to(emit, "wasolution_http_requests_in_flight {}\n", in_flight_.load(std::memory_order_relaxed));
+
+    renderHistogram(out, "wasolution_upstream_request_duration_seconds",
+                    "Calls to the WhatsApp providers, by provider, operation and HTTP status.", upstream_);
+    renderHistogram(out, "wasolution_db_query_duration_seconds", "Prepared statement executions.", db_);
+
+    auto breakers = CircuitBreaker::all();
+    appendHeader(out, "wasolution_circuit_state", "Provider circuit breaker state: 0 closed, 1 open, 2 half-open.", "gauge");
+    for (const auto& b : breakers) {
+        std::string labels;
+        appendLabel(labels, "provider", b.provider);
+        fmt::format_to(emit, "wasolution_circuit_state{{{}}} {}\n", labels, static_cast<int>(b.state));
+    }
+    appendHeader(out, "wasolution_circuit_rejected_total", "Calls failed fast because the provider's circuit was open.", "counter");
+    for (const auto& b : breakers) {
+        std::string labels;
+        appendLabel(labels, "provider", b.provider);
+        fmt::format_to(emit, "wasolution_circuit_rejected_total{{{}}} {}\n", labels, b.rejected);
+    }
+    appendHeader(out, "wasolution_circuit_opened_total", "Times the provider's circuit opened.", "counter");
+    for (const auto& b : breakers) {
+        std::string labels;
+        appendLabel(labels, "provider", b.provider);
+        fmt::format_to(emit, "wasolution_circuit_opened_total{{{}}} {}\n", labels, b.opened);
+    }
+
+    renderHistogram(out, "wasolution_rate_limit_wait_seconds",
+                    "Time sends spent queued by the rate limiter, by limiting scope, provider and outcome.", rate_limit_);
+    auto limiter = RateLimiter::instance().metrics();
+    appendHeader(out, "wasolution_rate_limit_waiting", "Sends currently waiting for a rate limit slot.", "gauge");
+    fmt::format_to(emit, "wasolution_rate_limit_waiting {}\n", limiter.waiting);
+    appendHeader(out, "wasolution_rate_limit_instances", "Instances with a rate limit bucket.", "gauge");
+    fmt::format_to(emit, "wasolution_rate_limit_instances {}\n", limiter.instances);
+
+    auto webhooks = WebhookDispatcher::instance().metrics();
+    const PlainSeries webhook_series[] = {
+        {"wasolution_webhook_queued", "Received webhook events waiting to be forwarded.", "gauge", webhooks.queued},
+        {"wasolution_webhook_in_flight", "Webhook forwards in progress.", "gauge", webhooks.in_flight},
+        {"wasolution_webhook_retrying", "Webhook events waiting for another attempt.", "gauge", webhooks.retrying},
+        {"wasolution_webhook_received_total", "Webhook events accepted on /webhook.", "counter", webhooks.received},
+        {"wasolution_webhook_rejected_total", "Webhook events refused with 503 because the queue was full.", "counter", webhooks.rejected},
+        {"wasolution_webhook_forwarded_total", "Webhook events delivered to the instance's webhook_url.", "counter", webhooks.forwarded},
+        {"wasolution_webhook_retried_total", "Failed webhook forwards scheduled for another attempt.", "counter", webhooks.retried},
+        {"wasolution_webhook_dead_lettered_total", "Webhook events given up on and written to the dead-letter table.", "counter", webhooks.dead_lettered},
+        {"wasolution_webhook_dropped_total", "Webhook events with no instance webhook_url nor DEFAULT_WEBHOOK.", "counter", webhooks.dropped},
+    };
+    for (const auto& series : webhook_series) {
+        appendHeader(out, series.name, series.help, series.type);
+        fmt::format_to(emit, "{} {}\n", series.name, series.value);
+    }
+
+    auto workers = WorkerPool::instance().metrics();
+    appendHeader(out, "wasolution_worker_threads", "Request handler threads.", "gauge");
+    fmt::format_to(emit, "wasolution_worker_threads {}\n", workers.threads);
+    appendHeader(out, "wasolution_worker_queue_depth", "Capacity of the handler queue.", "gauge");
+    fmt::format_to(emit, "wasolution_worker_queue_depth {}\n", workers.queue_depth);
+    appendHeader(out, "wasolution_worker_queued", "Requests waiting for a handler thread.", "gauge");
+    fmt::format_to(emit, "wasolution_worker_queued {}\n", workers.queued);
+    appendHeader(out, "wasolution_worker_active", "Handler threads currently busy.", "gauge");
+    fmt::format_to(emit, "wasolution_worker_active {}\n", workers.active);
+    appendHeader(out, "wasolution_worker_completed_total", "Requests run by the handler threads.", "counter");
+    fmt::format_to(emit, "wasolution_worker_completed_total {}\n", workers.completed);
+    appendHeader(out, "wasolution_worker_rejected_total", "Requests shed with 503 because the queue was full.", "counter");
+    fmt::format_to(emit, "wasolution_worker_rejected_total {}\n", workers.rejected);
+
+    auto pools = ConnectionPool::allMetrics();
+    typedef struct {
+        const char* name;
+        const char* help;
+        const char* type;
+    } PoolSeries;
+    const PoolSeries pool_series[] = {
+        {"wasolution_db_pool_max_connections", "Configured pool size.", "gauge"},
+        {"wasolution_db_pool_connections", "Open connections.", "gauge"},
+        {"wasolution_db_pool_idle_connections", "Open connections waiting to be borrowed.", "gauge"},
+        {"wasolution_db_pool_in_use_connections", "Connections currently borrowed.", "gauge"},
+        {"wasolution_db_pool_waiting", "Threads waiting for a connection.", "gauge"},
+        {"wasolution_db_pool_acquired_total", "Connections handed out.", "counter"},
+        {"wasolution_db_pool_timeouts_total", "Checkouts that timed out.", "counter"},
+        {"wasolution_db_pool_discarded_total", "Connections closed because they were broken.", "counter"},
+    };
+    for (std::size_t i = 0; i < std::size(pool_series); ++i) {
+        appendHeader(out, pool_series[i].name, pool_series[i].help, pool_series[i].type);
+        for (const auto& [pool, m] : pools) {
+            const std::uint64_t values[] = {m.max_size, m.size, m.idle, m.in_use, m.waiting, m.acquired, m.timeouts, m.discarded};
+            std::string labels;
+            appendLabel(labels, "pool", pool);
+            fmt::format_to(emit, "{}{{{}}} {}\n", pool_series[i].name, labels, values[i]);
+        }
+    }
+    return out;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/* Process-wide counters and latency histograms, exported at /metrics in the
+   Prometheus text exposition format (version 0.0.4).
+
+   Series are created on first use and never removed; every label value comes
+   from a fixed set (route patterns, provider and statement names, status
+   codes), so the number of series stays bounded. Observing an existing series
+   takes a shared lock and a few relaxed atomic increments. */
+class Metrics {
+public:
+    // Upper bounds in seconds, shared by every histogram.
+    static constexpr std::array<double, 12> buckets = {
+        0.001, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+    };
+
+    class Histogram {
+    public:
+        void observe(double seconds);
+
+    private:
+        friend class Metrics;
+        std::array<std::atomic<std::uint64_t>, buckets.size() + 1> counts_{};
+        std::atomic<std::uint64_t> sum_ns_{0};
+    };
+
+    // Keeps the in-flight gauge raised for its lifetime.
+    class InFlight {
+    public:
+        InFlight();
+        ~InFlight();
+        InFlight(const InFlight&) = delete;
+        InFlight& operator=(const InFlight&) = delete;
+    };
+
+    static Metrics& instance();
+
+    void observeRequest(std::string_view route, std::string_view method, unsigned status, double seconds);
+    enum class UpstreamOutcome { ANSWERED, TIMED_OUT, FAILED };
+    // status is the HTTP code when the provider answered, "timeout" or "error" otherwise.
+    void observeUpstream(std::string_view provider, std::string_view operation, long http_code, UpstreamOutcome outcome, double seconds);
+    void observeDb(std::string_view statement, bool ok, double seconds);
+    // scope is the bucket that decided ("instance" or "provider"); seconds is the time the send waits in the
+    // limiter's queue, or for rejected sends the Retry-After they were given.
+    void observeRateLimit(std::string_view scope, std::string_view provider, bool admitted, double seconds);
+
+    // Every series plus the worker and connection pool gauges.
+    std::string render() const;
+
+    template <typename Clock = std::chrono::steady_clock>
+    static double secondsSince(typename Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+private:
+    typedef struct {
+        std::unordered_map<std::string, std::unique_ptr<Histogram>> series;
+        mutable std::shared_mutex mtx;
+    } Family;
+
+    Metrics() = default;
+
+    static Histogram& series(Family& family, std::string labels);
+    static void renderHistogram(std::string& out, const char* name, const char* help, const Family& family);
+
+    Family requests_;
+    Family upstream_;
+    Family db_;
+    Family rate_limit_;
+    std::atomic<std::int64_t> in_flight_{0};
+};
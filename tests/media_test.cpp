@@ -0,0 +1,131 @@
+#include "api/base64.h"
+#include "api/media.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+/* Checks the vector base64 kernels against the scalar one on every length
+   around their block sizes, and the magic-byte detection for each known
+   signature, raw and base64-encoded. */
+
+namespace {
+
+using namespace std::string_view_literals;
+
+int failures = 0;
+
+void check(bool ok, const std::string& what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// Deterministic bytes covering the whole 0..255 range, so every alphabet entry shows up.
+std::string noise(std::size_t n, std::uint32_t seed) {
+    std::string out(n, '\0');
+    for (auto& c : out) {
+        seed = seed * 1664525u + 1013904223u;
+        c = static_cast<char>(seed >> 24);
+    }
+    return out;
+}
+
+void base64() {
+    check(Base64::encode("") == "", "empty input");
+    check(Base64::encode("f") == "Zg==", "RFC 4648: f");
+    check(Base64::encode("fo") == "Zm8=", "RFC 4648: fo");
+    check(Base64::encode("foo") == "Zm9v", "RFC 4648: foo");
+    check(Base64::encode("foobar") == "Zm9vYmFy", "RFC 4648: foobar");
+    check(Base64::encode("\xfb\xff\xbf"sv) == "+/+/", "the last two alphabet entries");
+
+    std::string appended = "prefix:";
+    Base64::encode("foo", appended);
+    check(appended == "prefix:Zm9v", "encode appends to what is already there");
+
+    std::string unused = "untouched";
+    check(!Base64::encodeWith("neon", "foo", unused) && unused == "untouched", "unknown kernel is refused");
+
+    // 0..200 crosses the 12-byte SSSE3 and 24-byte AVX2 steps (and their 16/28-byte read windows)
+    // many times over, with every tail length; the offsets make the loads unaligned.
+    const std::string source = noise(256, 7);
+    for (const char* kernel : {"ssse3", "avx2"}) {
+        std::string probe;
+        if (!Base64::encodeWith(kernel, "", probe)) {
+            std::cout << "media_test: " << kernel << " not supported on this CPU, skipped" << std::endl;
+            continue;
+        }
+        for (std::size_t offset = 0; offset < 4; ++offset) {
+            for (std::size_t n = 0; n <= 200; ++n) {
+                std::string_view in(source.data() + offset, n);
+                std::string expected;
+                std::string actual;
+                Base64::encodeWith("scalar", in, expected);
+                Base64::encodeWith(kernel, in, actual);
+                check(actual == expected, std::string(kernel) + " matches scalar at length " + std::to_string(n) + ", offset " +
+                                              std::to_string(offset));
+            }
+        }
+    }
+    std::string selected;
+    Base64::encodeWith("scalar", source, selected);
+    check(Base64::encode(source) == selected, std::string("selected kernel ") + Base64::kernel() + " matches scalar");
+
+    for (std::size_t n = 0; n <= 48; ++n) {
+        const std::string in = noise(n, 11);
+        check(Base64::decodePrefix(Base64::encode(in), n) == in, "decodePrefix round-trips length " + std::to_string(n));
+    }
+    check(Base64::decodePrefix("Zm9vYmFy", 4) == "foob", "decodePrefix stops at max_bytes");
+    check(Base64::decodePrefix("-_-_", 3) == "\xfb\xff\xbf"sv, "decodePrefix takes the URL-safe alphabet");
+}
+
+void sniffs(std::string_view data, std::string_view mime, MediaType type, const char* what) {
+    auto info = Media::sniff(data);
+    check(info.has_value() && info->mime == mime && info->type == type, std::string("sniff: ") + what);
+    auto encoded = Media::sniffBase64(Base64::encode(data));
+    check(encoded.has_value() && encoded->mime == mime, std::string("sniffBase64: ") + what);
+    auto url = Media::sniffBase64("data:application/octet-stream;base64," + Base64::encode(data));
+    check(url.has_value() && url->mime == mime, std::string("sniffBase64 with a data URL: ") + what);
+}
+
+void media() {
+    const std::string pad(16, '\0');
+    sniffs(std::string("\x89PNG\r\n\x1a\n"sv) + pad, "image/png", MediaType::IMAGE, "png");
+    sniffs(std::string("\xff\xd8\xff\xe0"sv) + pad, "image/jpeg", MediaType::IMAGE, "jpeg");
+    sniffs("GIF89a" + pad, "image/gif", MediaType::IMAGE, "gif");
+    sniffs("RIFF\x10\x00\x00\x00WEBPVP8 "sv, "image/webp", MediaType::IMAGE, "webp");
+    sniffs("RIFF\x10\x00\x00\x00WAVEfmt "sv, "audio/wav", MediaType::AUDIO, "wav");
+    sniffs("OggS" + pad, "audio/ogg", MediaType::AUDIO, "ogg");
+    sniffs("ID3\x04" + pad, "audio/mpeg", MediaType::AUDIO, "mp3 with ID3");
+    sniffs(std::string("\xff\xfb\x90\x00"sv) + pad, "audio/mpeg", MediaType::AUDIO, "mp3 frame (MPEG-1)");
+    sniffs(std::string("\xff\xf3\x90\x00"sv) + pad, "audio/mpeg", MediaType::AUDIO, "mp3 frame (MPEG-2)");
+    sniffs(std::string("\x1a\x45\xdf\xa3"sv) + pad, "audio/webm", MediaType::AUDIO, "webm");
+    sniffs(std::string("\x00\x00\x00\x20" "ftypM4A "sv) + pad, "audio/mp4", MediaType::AUDIO, "m4a");
+    sniffs(std::string("\x00\x00\x00\x20" "ftypisom"sv) + pad, "video/mp4", MediaType::DOCUMENT, "mp4");
+    sniffs("%PDF-1.7" + pad, "application/pdf", MediaType::DOCUMENT, "pdf");
+    sniffs(std::string("PK\x03\x04"sv) + pad, "application/zip", MediaType::DOCUMENT, "zip");
+    sniffs(std::string("\xd0\xcf\x11\xe0\xa1\xb1\x1a\xe1"sv) + pad, "application/msword", MediaType::DOCUMENT, "doc");
+    sniffs("{\\rtf1" + pad, "application/rtf", MediaType::DOCUMENT, "rtf");
+
+    check(!Media::sniff("RIFX\x10\x00\x00\x00WEBP"sv).has_value(), "sniff: WEBP tag outside a RIFF container");
+    check(!Media::sniff("\x89PN"sv).has_value(), "sniff: signature cut short");
+    check(!Media::sniff("").has_value(), "sniff: empty data");
+    check(!Media::sniff("hello world, plain text").has_value(), "sniff: unknown content");
+    check(!Media::sniffBase64("data:image/png;base64").has_value(), "sniffBase64: data URL without a comma");
+
+    check(Media::extension("application/pdf") == ".pdf", "extension of a sniffed type");
+    check(Media::extension("text/csv") == ".csv", "extension of a declared type");
+    check(Media::extension("application/x-unknown").empty(), "extension of an unknown type");
+}
+
+} // namespace
+
+int main() {
+    base64();
+    media();
+
+    if (failures == 0) {
+        std::cout << "media_test: ok" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#include "handler/request_decoder.h"
+#include <iostream>
+#include <string>
+
+/* Runs each RequestDecoder over well-formed bodies and over the malformed
+   ones clients actually send, checking the field path and message of the
+   DecodeError that comes back. */
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+// The error is reported on `field` with exactly `message`.
+void checkError(const std::optional<DecodeError>& err, const std::string& field, const std::string& message, const char* what) {
+    if (!err.has_value()) {
+        std::cerr << "FAIL: " << what << " (no error)" << std::endl;
+        ++failures;
+        return;
+    }
+    if (err->field != field || err->message != message) {
+        std::cerr << "FAIL: " << what << " (got field '" << err->field << "', message '" << err->message << "')" << std::endl;
+        ++failures;
+    }
+}
+
+template <typename T>
+std::optional<DecodeError> decode(std::string_view body) {
+    T out{};
+    return RequestDecoder::decode(body, out);
+}
+
+void sendMessage() {
+    SendMessageRequest req{};
+    auto err = RequestDecoder::decode(
+        R"({"instance_id":"i1","number":"5511","body":"oi","type":"IMAGE","async":true,"callback_url":"http://cb","raw":true,)"
+        R"("extra":{"instance_id":5,"list":[1,{"number":2}]}})",
+        req);
+    check(!err.has_value(), "sendMessage: complete body decodes");
+    check(req.instance_id == "i1" && req.number == "5511" && req.body == "oi", "sendMessage: strings are taken");
+    check(req.type == MediaType::IMAGE, "sendMessage: type is parsed");
+    check(req.async, "sendMessage: async is taken");
+    check(req.callback_url == std::optional<std::string>("http://cb"), "sendMessage: callback_url is taken");
+    check(req.mode == ResponseMode::RAW, "sendMessage: raw selects ResponseMode::RAW");
+
+    SendMessageRequest defaults{};
+    check(!RequestDecoder::decode(R"({"instance_id":"i1","number":"5511","body":"oi"})", defaults).has_value(),
+          "sendMessage: optional members may be left out");
+    check(defaults.type == MediaType::TEXT && !defaults.async && !defaults.callback_url.has_value() &&
+              defaults.mode == ResponseMode::PARSED,
+          "sendMessage: defaults are kept");
+
+    checkError(decode<SendMessageRequest>(R"({"instance_id":"i1","body":"oi"})"), "number", "number é obrigatório",
+               "sendMessage: missing number");
+    checkError(decode<SendMessageRequest>(R"({"instance_id":"i1","number":5511,"body":"oi"})"), "number", "number deve ser texto",
+               "sendMessage: number of the wrong type");
+    checkError(decode<SendMessageRequest>(R"({"instance_id":"i1","number":"5511","body":"oi","type":"video"})"), "type",
+               "type inválido", "sendMessage: unknown type");
+    checkError(decode<SendMessageRequest>(R"({"instance_id":"i1","number":"5511","body":"oi","async":"yes"})"), "async",
+               "async deve ser true ou false", "sendMessage: async of the wrong type");
+    checkError(decode<SendMessageRequest>(R"([{"instance_id":"i1"}])"), "", "o corpo deve ser um objeto JSON",
+               "sendMessage: root array");
+    checkError(decode<SendMessageRequest>(R"("text")"), "", "o corpo deve ser um objeto JSON", "sendMessage: root scalar");
+
+    auto garbage = decode<SendMessageRequest>(R"({"instance_id":"i1","number":"5511","body":"oi"} x)");
+    check(garbage.has_value() && garbage->field.empty() && garbage->message.rfind("JSON inválido", 0) == 0,
+          "sendMessage: trailing garbage is invalid JSON");
+    auto truncated = decode<SendMessageRequest>(R"({"instance_id":"i1")");
+    check(truncated.has_value() && truncated->field.empty() && truncated->message.rfind("JSON inválido", 0) == 0,
+          "sendMessage: truncated body is invalid JSON");
+}
+
+void sendMessages() {
+    SendMessagesRequest wrapped{};
+    auto err = RequestDecoder::decode(
+        R"({"raw":true,"messages":[{"instance_id":"i1","number":"1","body":"a","meta":{"number":9,"body":[]}},)"
+        R"({"instance_id":"i2","number":"2","body":"b","type":"AUDIO"}]})",
+        wrapped);
+    check(!err.has_value(), "sendMessages: object body decodes");
+    check(wrapped.messages.size() == 2, "sendMessages: both messages are kept");
+    check(wrapped.messages.size() == 2 && wrapped.messages[0].number == "1" && wrapped.messages[0].type == MediaType::TEXT,
+          "sendMessages: members nested in a message are ignored");
+    check(wrapped.messages.size() == 2 && wrapped.messages[1].instance_id == "i2" && wrapped.messages[1].type == MediaType::AUDIO,
+          "sendMessages: second message is decoded");
+    check(wrapped.mode == ResponseMode::RAW, "sendMessages: raw is taken");
+
+    SendMessagesRequest bare{};
+    check(!RequestDecoder::decode(R"([{"instance_id":"i1","number":"1","body":"a"}])", bare).has_value() && bare.messages.size() == 1 &&
+              bare.mode == ResponseMode::PARSED,
+          "sendMessages: root array decodes");
+
+    checkError(decode<SendMessagesRequest>(R"({"messages":[]})"), "messages", "messages deve ser uma lista não vazia",
+               "sendMessages: empty list");
+    checkError(decode<SendMessagesRequest>(R"([])"), "messages", "messages deve ser uma lista não vazia",
+               "sendMessages: empty root array");
+    checkError(decode<SendMessagesRequest>(R"({"raw":false})"), "messages", "messages deve ser uma lista não vazia",
+               "sendMessages: missing messages");
+    checkError(decode<SendMessagesRequest>(R"({"messages":{"instance_id":"i1"}})"), "messages",
+               "messages deve ser uma lista não vazia", "sendMessages: messages is not a list");
+    checkError(decode<SendMessagesRequest>(R"({"messages":["oi"]})"), "messages[0]", "messages[0] deve ser um objeto",
+               "sendMessages: message is not an object");
+    checkError(decode<SendMessagesRequest>(R"({"messages":[{"instance_id":"i1","number":"1","body":"a"},{"instance_id":"i1","number":"2"}]})"),
+               "messages[1].body", "messages[1].body é obrigatório", "sendMessages: missing body in the second message");
+    checkError(decode<SendMessagesRequest>(R"([{"instance_id":"i1","body":"a"}])"), "[0].number", "[0].number é obrigatório",
+               "sendMessages: missing number under a root array");
+    checkError(decode<SendMessagesRequest>(R"({"messages":[{"instance_id":"i1","number":"1","body":"a","type":"gif"}]})"),
+               "messages[0].type", "messages[0].type inválido", "sendMessages: unknown type");
+    checkError(decode<SendMessagesRequest>(R"({"messages":[{"instance_id":["i1"],"number":"1","body":"a"}]})"),
+               "messages[0].instance_id", "messages[0].instance_id deve ser texto", "sendMessages: instance_id of the wrong type");
+    checkError(decode<SendMessagesRequest>(R"({"raw":1,"messages":[{"instance_id":"i1","number":"1","body":"a"}]})"), "raw",
+               "raw deve ser true ou false", "sendMessages: raw of the wrong type");
+
+    auto garbage = decode<SendMessagesRequest>(R"([{"instance_id":"i1","number":"1","body":"a"}]])");
+    check(garbage.has_value() && garbage->field.empty(), "sendMessages: trailing garbage is invalid JSON");
+}
+
+void sendTemplate() {
+    SendTemplateRequest req{};
+    auto err = RequestDecoder::decode(
+        R"({"instance_id":"i1","number":"1","template_name":"promo","image_url":"http://img",)"
+        R"("variables":[{"type":"currency","value":"10"},{"type":"datetime","value":"hoje"},{"value":"x","type":"other"},{"value":"y"}]})",
+        req);
+    check(!err.has_value(), "sendTemplate: complete body decodes");
+    check(req.template_name == "promo" && req.image_url == "http://img", "sendTemplate: strings are taken");
+    check(req.variables.size() == 4, "sendTemplate: every variable is kept");
+    if (req.variables.size() == 4) {
+        check(req.variables[0].var == VARIABLE_T::CURRENCY && req.variables[0].body == "10", "sendTemplate: currency variable");
+        check(req.variables[1].var == VARIABLE_T::DATE_TIME && req.variables[1].body == "hoje", "sendTemplate: datetime variable");
+        check(req.variables[2].var == VARIABLE_T::TEXT && req.variables[2].body == "x", "sendTemplate: unknown type is text");
+        check(req.variables[3].var == VARIABLE_T::TEXT && req.variables[3].body == "y", "sendTemplate: type defaults to text");
+    }
+
+    SendTemplateRequest none{};
+    check(!RequestDecoder::decode(R"({"instance_id":"i1","number":"1","template_name":"promo","variables":null})", none).has_value() &&
+              none.variables.empty(),
+          "sendTemplate: null variables are no variables");
+
+    checkError(decode<SendTemplateRequest>(R"({"instance_id":"i1","number":"1","template_name":"t","variables":[{"type":"currency"}]})"),
+               "variables[0].value", "variables[0].value é obrigatório", "sendTemplate: variable without value");
+    checkError(decode<SendTemplateRequest>(R"({"instance_id":"i1","number":"1","template_name":"t","variables":[{"value":10}]})"),
+               "variables[0].value", "variables[0].value deve ser texto", "sendTemplate: value of the wrong type");
+    checkError(decode<SendTemplateRequest>(R"({"instance_id":"i1","number":"1","template_name":"t","variables":["x"]})"),
+               "variables[0]", "variables[0] deve ser um objeto", "sendTemplate: variable is not an object");
+    checkError(decode<SendTemplateRequest>(R"({"instance_id":"i1","number":"1","template_name":"t","variables":{"value":"x"}})"),
+               "variables", "variables deve ser uma lista", "sendTemplate: variables is not a list");
+    checkError(decode<SendTemplateRequest>(R"({"instance_id":"i1","number":"1"})"), "template_name", "template_name é obrigatório",
+               "sendTemplate: missing template_name");
+}
+
+void createInstance() {
+    CreateInstanceRequest req{};
+    auto err = RequestDecoder::decode(
+        R"({"instance_id":"i1","instance_name":"Loja","api_type":"CLOUD","webhook_url":"http://hook","proxy_url":"http://p",)"
+        R"("access_token":"EA","waba_id":"123","extra":{"api_type":1}})",
+        req);
+    check(!err.has_value(), "createInstance: complete body decodes");
+    check(req.api_type == ApiType::CLOUD, "createInstance: api_type is parsed");
+    check(req.webhook_url == std::optional<std::string>("http://hook"), "createInstance: webhook_url is taken");
+    check(req.proxy_url == "http://p" && req.access_token == "EA" && req.waba_id == "123", "createInstance: optional strings are taken");
+
+    CreateInstanceRequest minimal{};
+    check(!RequestDecoder::decode(R"({"instance_id":"i1","instance_name":"Loja","api_type":"WUZAPI"})", minimal).has_value() &&
+              !minimal.webhook_url.has_value(),
+          "createInstance: webhook_url stays empty when absent");
+
+    checkError(decode<CreateInstanceRequest>(R"({"instance_id":"i1","instance_name":"Loja","api_type":"TELEGRAM"})"), "api_type",
+               "api_type inválido", "createInstance: unknown api_type");
+    checkError(decode<CreateInstanceRequest>(R"({"instance_id":"i1","instance_name":"Loja","api_type":2})"), "api_type",
+               "api_type deve ser texto", "createInstance: api_type of the wrong type");
+    checkError(decode<CreateInstanceRequest>(R"({"instance_id":"i1","instance_name":"Loja"})"), "api_type", "api_type é obrigatório",
+               "createInstance: missing api_type");
+    checkError(decode<CreateInstanceRequest>(R"({"instance_id":"i1","instance_name":null,"api_type":"CLOUD"})"), "instance_name",
+               "instance_name deve ser texto", "createInstance: null instance_name");
+}
+
+} // namespace
+
+int main() {
+    sendMessage();
+    sendMessages();
+    sendTemplate();
+    createInstance();
+
+    if (failures == 0) {
+        std::cout << "request_decoder_test: ok" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#include "handler/webhook_auth.h"
+#include "handler/query.h"
+#include "logger/log_policy.h"
+#include <iostream>
+#include <string>
+
+/* Checks the per-instance webhook secrets, the receiver URL registered with
+   the providers and that neither shows up in the logs. */
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::cerr << "FAIL: " << what << std::endl;
+        ++failures;
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string token = "master-token";
+    const std::string secret = WebhookAuth::secretFor("inst-1", token);
+
+    check(secret.size() == 64, "secret is a hex SHA-256");
+    check(secret == WebhookAuth::secretFor("inst-1", token), "secret is deterministic");
+    check(secret != WebhookAuth::secretFor("inst-2", token), "secret differs per instance");
+    check(secret != WebhookAuth::secretFor("inst-1", "rotated"), "rotating TOKEN rotates the secret");
+
+    check(WebhookAuth::accepts("inst-1", secret, token), "own secret is accepted");
+    check(!WebhookAuth::accepts("inst-2", secret, token), "secret of another instance is refused");
+    check(!WebhookAuth::accepts("inst-1", secret.substr(1), token), "truncated secret is refused");
+    check(!WebhookAuth::accepts("inst-1", "", token), "missing secret is refused");
+
+    const std::string path = WebhookAuth::receiverPath("inst 1", token);
+    check(query_value(path, "instance_id") == "inst 1", "receiver path round-trips the instance id");
+    check(WebhookAuth::accepts("inst 1", query_value(path, "secret"), token), "receiver path carries the secret");
+
+    check(WebhookAuth::receiverUrl("inst 1", "https://api.example.com", token) == "https://api.example.com" + path,
+          "receiver URL is the path under PUBLIC_URL");
+    check(WebhookAuth::receiverUrl("inst 1", "", token) == path, "receiver URL is the bare path without PUBLIC_URL");
+
+    const std::string logged = LogPolicy::redactQuery("/webhook?instance_id=inst-1&secret=" + secret + "&token=" + token);
+    check(logged.find(secret) == std::string::npos, "secret is masked in logs");
+    check(logged.find(token) == std::string::npos, "token is masked in logs");
+    check(logged.find("inst-1") != std::string::npos, "instance id is kept in logs");
+
+    if (failures == 0) {
+        std::cout << "webhook_auth_test: ok" << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}